@@ -19,6 +19,8 @@ PluginEditor::BandControlPanel::BandControlPanel(int bandIndex) : band(bandIndex
     qSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 60, 16);
 
     typeCombo.addItemList(getFilterTypeNames(), 1);
+    slopeCombo.addItemList(getSlopeNames(), 1);
+    slopeCombo.setTooltip("Slope (High Pass / Low Pass)");
 
     enableButton.setButtonText(juce::String(bandIndex + 1));
 
@@ -26,6 +28,7 @@ PluginEditor::BandControlPanel::BandControlPanel(int bandIndex) : band(bandIndex
     addAndMakeVisible(gainSlider);
     addAndMakeVisible(qSlider);
     addAndMakeVisible(typeCombo);
+    addAndMakeVisible(slopeCombo);
     addAndMakeVisible(enableButton);
     addAndMakeVisible(freqLabel);
     addAndMakeVisible(gainLabel);
@@ -114,6 +117,8 @@ void PluginEditor::BandControlPanel::resized() {
     auto topRow = bounds.removeFromTop(28);
     enableButton.setBounds(topRow.removeFromLeft(28));
     topRow.removeFromLeft(6);
+    slopeCombo.setBounds(topRow.removeFromRight(topRow.getWidth() / 3));
+    topRow.removeFromRight(4);
     typeCombo.setBounds(topRow);
 
     bounds.removeFromTop(6);
@@ -198,6 +203,8 @@ PluginEditor::PluginEditor(PluginProcessor& p)
             apvts, ParamIDs::getBandParamID(i, ParamIDs::bandQ), panel.qSlider);
         attach.type = std::make_unique<ComboAttachment>(
             apvts, ParamIDs::getBandParamID(i, ParamIDs::bandType), panel.typeCombo);
+        attach.slope = std::make_unique<ComboAttachment>(
+            apvts, ParamIDs::getBandParamID(i, ParamIDs::bandSlope), panel.slopeCombo);
         attach.enable = std::make_unique<ButtonAttachment>(
             apvts, ParamIDs::getBandParamID(i, ParamIDs::bandEnable), panel.enableButton);
 
@@ -67,6 +67,7 @@ private:
         juce::Slider gainSlider;
         juce::Slider qSlider;
         juce::ComboBox typeCombo;
+        juce::ComboBox slopeCombo;
         juce::ToggleButton enableButton;
         juce::Label freqLabel { {}, "Freq" };
         juce::Label gainLabel { {}, "Gain" };
@@ -156,6 +157,7 @@ private:
     struct BandAttachments {
         std::unique_ptr<SliderAttachment> freq, gain, q;
         std::unique_ptr<ComboAttachment> type;
+        std::unique_ptr<ComboAttachment> slope;
         std::unique_ptr<ButtonAttachment> enable;
         // Per-band dynamics
         std::unique_ptr<SliderAttachment> dynThresh, dynRatio;
@@ -26,10 +26,21 @@ PluginProcessor::PluginProcessor()
     apvts.addParameterListener(ParamIDs::midSideMode, this);
     apvts.addParameterListener(ParamIDs::linearPhaseMode, this);
     apvts.addParameterListener(ParamIDs::dynamicEQMode, this);
+    apvts.addParameterListener(ParamIDs::filterStructure, this);
+    apvts.addParameterListener(ParamIDs::filterEngine, this);
+    apvts.addParameterListener(ParamIDs::crossoverPhase, this);
+    apvts.addParameterListener(ParamIDs::linearPhaseLength, this);
+    apvts.addParameterListener(ParamIDs::firPhase, this);
+    apvts.addParameterListener(ParamIDs::firPhaseMix, this);
     apvts.addParameterListener(ParamIDs::oversamplingFactor, this);
+    apvts.addParameterListener(ParamIDs::limiterEnable, this);
+    apvts.addParameterListener(ParamIDs::limiterLookahead, this);
+
+    startTimerHz(10);
 }
 
 PluginProcessor::~PluginProcessor() {
+    stopTimer();
 }
 
 //==============================================================================
@@ -50,9 +61,9 @@ bool PluginProcessor::isMidiEffect() const {
 }
 
 double PluginProcessor::getTailLengthSeconds() const {
-    // Return latency for linear phase mode
+    // Return latency for linear phase mode (counted at the oversampled rate)
     const int eqLatency = eqProcessor.getLatency();
-    return eqLatency > 0 ? eqLatency / currentSampleRate : 0.0;
+    return eqLatency > 0 ? eqLatency / (currentSampleRate * currentOversamplingFactor) : 0.0;
 }
 
 int PluginProcessor::getNumPrograms() {
@@ -90,18 +101,23 @@ void PluginProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
     eqProcessor.prepare(oversampledRate, oversampledBlockSize);
     compressor.prepare(oversampledRate, oversampledBlockSize);
     gate.prepare(oversampledRate, oversampledBlockSize);
+    limiter.updateFromParameters();  // Lookahead and enable set the latency reported below
     limiter.prepare(oversampledRate, oversampledBlockSize);
 
     // Prepare FFT analyzer (at original rate for display)
     fftProcessor.prepare(sampleRate);
+    outputTruePeak.reset();
 
     // Prepare gain smoothers (at original rate - applied before/after oversampling)
     inputGainSmoother.prepare(sampleRate, 20.0);
     outputGainSmoother.prepare(sampleRate, 20.0);
     dryWetSmoother.prepare(sampleRate, 20.0);
 
-    // Prepare dry buffer for wet/dry mix
+    // Prepare dry buffer for wet/dry mix, and the delay that lines it up with the wet signal
     dryBuffer.setSize(2, samplesPerBlock);
+    dryDelay.setSize(2, getMaxLatencySamples() + samplesPerBlock);
+    dryDelay.clear();
+    dryDelayPosition = 0;
 
     // Initialize gain smoothers with current values
     if (inputGainParam)
@@ -112,7 +128,7 @@ void PluginProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
         dryWetSmoother.setTargetValue(dryWetParam->load() / 100.0f);
 
     // Report latency to host
-    setLatencySamples(getOversamplingLatency() + eqProcessor.getLatency());
+    setLatencySamples(getLatencySamples());
 }
 
 void PluginProcessor::releaseResources() {
@@ -175,9 +191,38 @@ void PluginProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     const float currentWet = dryWetSmoother.getCurrentValue();
     const bool needsMix = currentWet < 0.99f || dryWetSmoother.isSmoothing();
 
+    // The dry signal always runs through the delay, so it is lined up as soon as the mix engages
+    const int dryDelayLength = dryDelay.getNumSamples();
+    const int dryLatency = std::clamp(getLatencySamples(), 0, std::max(dryDelayLength - numSamples, 0));
+    const int numDryChannels = std::min(buffer.getNumChannels(), dryDelay.getNumChannels());
+
     if (needsMix) {
-        dryBuffer.makeCopyOf(buffer, true);
+        dryBuffer.setSize(numDryChannels, numSamples, false, false, true);
+    }
+
+    for (int ch = 0; ch < numDryChannels; ++ch) {
+        const float* input = buffer.getReadPointer(ch);
+        float* line = dryDelay.getWritePointer(ch);
+        int writePosition = dryDelayPosition;
+
+        for (int i = 0; i < numSamples; ++i) {
+            line[writePosition] = input[i];
+            if (++writePosition == dryDelayLength) writePosition = 0;
+        }
+
+        if (needsMix) {
+            // Read the block that went in dryLatency samples ago
+            float* dry = dryBuffer.getWritePointer(ch);
+            int readPosition = dryDelayPosition - dryLatency;
+            if (readPosition < 0) readPosition += dryDelayLength;
+
+            for (int i = 0; i < numSamples; ++i) {
+                dry[i] = line[readPosition];
+                if (++readPosition == dryDelayLength) readPosition = 0;
+            }
+        }
     }
+    dryDelayPosition = (dryDelayPosition + numSamples) % dryDelayLength;
 
     // Apply input gain (before oversampling)
     for (int i = 0; i < numSamples; ++i) {
@@ -196,18 +241,17 @@ void PluginProcessor::processBlock(juce::AudioBuffer<float>& buffer,
         juce::dsp::AudioBlock<float> block(buffer);
         auto oversampledBlock = oversampling->processSamplesUp(block);
 
-        // Create temporary buffer for oversampled processing
-        juce::AudioBuffer<float> oversampledBuffer(
-            static_cast<int>(oversampledBlock.getNumChannels()),
-            static_cast<int>(oversampledBlock.getNumSamples()));
-
-        // Copy oversampled data to buffer
-        for (size_t ch = 0; ch < oversampledBlock.getNumChannels(); ++ch) {
-            std::copy(oversampledBlock.getChannelPointer(ch),
-                      oversampledBlock.getChannelPointer(ch) + oversampledBlock.getNumSamples(),
-                      oversampledBuffer.getWritePointer(static_cast<int>(ch)));
+        // Process the oversampled block in place (the buffer only refers to its channels)
+        std::array<float*, 2> oversampledChannels {};
+        const int numOversampledChannels = std::min(static_cast<int>(oversampledBlock.getNumChannels()),
+                                                    static_cast<int>(oversampledChannels.size()));
+        for (int ch = 0; ch < numOversampledChannels; ++ch) {
+            oversampledChannels[static_cast<size_t>(ch)] = oversampledBlock.getChannelPointer(static_cast<size_t>(ch));
         }
 
+        juce::AudioBuffer<float> oversampledBuffer(oversampledChannels.data(), numOversampledChannels,
+                                                   static_cast<int>(oversampledBlock.getNumSamples()));
+
         // Process EQ at oversampled rate
         eqProcessor.process(oversampledBuffer);
 
@@ -218,13 +262,6 @@ void PluginProcessor::processBlock(juce::AudioBuffer<float>& buffer,
         // True Peak Limiter at oversampled rate
         limiter.process(oversampledBuffer);
 
-        // Copy back to oversampled block
-        for (size_t ch = 0; ch < oversampledBlock.getNumChannels(); ++ch) {
-            std::copy(oversampledBuffer.getReadPointer(static_cast<int>(ch)),
-                      oversampledBuffer.getReadPointer(static_cast<int>(ch)) + oversampledBlock.getNumSamples(),
-                      oversampledBlock.getChannelPointer(ch));
-        }
-
         // Downsample
         oversampling->processSamplesDown(block);
     } else {
@@ -266,6 +303,11 @@ void PluginProcessor::processBlock(juce::AudioBuffer<float>& buffer,
         maxOutputLevel = std::max(maxOutputLevel, buffer.getMagnitude(ch, 0, numSamples));
     }
     outputLevelDb.store(dBUtils::linearToDb(maxOutputLevel));
+
+    // True peak of the output (ITU-R BS.1770), whether or not the limiter runs
+    const float truePeak = outputTruePeak.process(buffer.getArrayOfReadPointers(), buffer.getNumChannels(),
+                                                  nullptr, numSamples);
+    truePeakDb.store(dBUtils::linearToDb(truePeak));
 }
 
 //==============================================================================
@@ -304,9 +346,29 @@ void PluginProcessor::parameterChanged(const juce::String& parameterID, float ne
     } else if (parameterID == linearPhaseMode) {
         eqProcessor.setLinearPhaseMode(newValue > 0.5f);
         // Update latency when linear phase mode changes
-        setLatencySamples(getOversamplingLatency() + eqProcessor.getLatency());
+        setLatencySamples(getLatencySamples());
     } else if (parameterID == dynamicEQMode) {
         eqProcessor.setDynamicEQMode(newValue > 0.5f);
+        // Dynamic bands give up their crossover split; a linear-phase one keeps its latency
+        setLatencySamples(getLatencySamples());
+    } else if (parameterID == filterStructure) {
+        eqProcessor.setFilterStructure(newValue > 0.5f ? EQProcessor::FilterStructure::Parallel
+                                                       : EQProcessor::FilterStructure::Serial);
+    } else if (parameterID == filterEngine) {
+        eqProcessor.setFilterEngine(newValue > 0.5f ? FilterEngine::StateVariable : FilterEngine::Biquad);
+    } else if (parameterID == crossoverPhase) {
+        eqProcessor.setCrossoverPhase(newValue > 0.5f ? CrossoverFilterbank::Phase::LinearPhase
+                                                      : CrossoverFilterbank::Phase::MinimumPhase);
+        setLatencySamples(getLatencySamples());
+    } else if (parameterID == linearPhaseLength) {
+        eqProcessor.setLinearPhaseLength(static_cast<LinearPhaseEQ::LengthTier>(static_cast<int>(newValue)));
+        setLatencySamples(getLatencySamples());
+    } else if (parameterID == firPhase || parameterID == firPhaseMix) {
+        // The mix only matters for Mixed, but both set the latency
+        const auto phase = static_cast<int>(apvts.getRawParameterValue(firPhase)->load());
+        const float mix = apvts.getRawParameterValue(firPhaseMix)->load() / 100.0f;
+        eqProcessor.setFirPhase(static_cast<LinearPhaseEQ::FirPhase>(phase), mix);
+        setLatencySamples(getLatencySamples());
     } else if (parameterID == oversamplingFactor) {
         // Oversampling factor changed - need to reinitialize
         updateOversamplingFactor();
@@ -318,7 +380,18 @@ void PluginProcessor::parameterChanged(const juce::String& parameterID, float ne
         gate.prepare(oversampledRate, oversampledBlockSize);
         limiter.prepare(oversampledRate, oversampledBlockSize);
         // Update latency
-        setLatencySamples(getOversamplingLatency() + eqProcessor.getLatency());
+        setLatencySamples(getLatencySamples());
+    } else if (parameterID == limiterEnable || parameterID == limiterLookahead) {
+        // The limiter picks these up itself; set them now so its latency follows at once
+        limiter.setEnabled(apvts.getRawParameterValue(limiterEnable)->load() > 0.5f);
+        limiter.setLookahead(apvts.getRawParameterValue(limiterLookahead)->load());
+        setLatencySamples(getLatencySamples());
+    }
+}
+
+void PluginProcessor::timerCallback() {
+    if (eqProcessor.pollLatencyChange()) {
+        setLatencySamples(getLatencySamples());
     }
 }
 
@@ -366,7 +439,23 @@ int PluginProcessor::getOversamplingLatency() const {
 }
 
 int PluginProcessor::getLatencySamples() const {
-    return getOversamplingLatency() + eqProcessor.getLatency();
+    // The EQ and limiter run at the oversampled rate: report their delay rounded
+    // to whole samples. The FIR tiers scale with that rate to keep their
+    // resolution in Hz, so their delay in seconds does not change; the
+    // crossover delay is a multiple of 8 and divides exactly.
+    const int dspLatency = eqProcessor.getLatency() + limiter.getLatency();
+    return getOversamplingLatency() + (dspLatency + currentOversamplingFactor / 2) / currentOversamplingFactor;
+}
+
+int PluginProcessor::getMaxLatencySamples() const {
+    // Longest FIR or crossover delay (both hold their delay in seconds across
+    // oversampling factors), the longest limiter lookahead, and room for the
+    // half-band oversampling filters, which add a few samples at most
+    const int eqLatency = std::max(LinearPhaseEQ::maxImpulseLength,
+                                   CrossoverFilterbank::getLinearPhaseLatency(currentSampleRate));
+    const int limiterLatency = static_cast<int>(std::ceil(Limiter::maxLookaheadMs * currentSampleRate / 1000.0))
+                             + TruePeakDetector::latency + 1;
+    return eqLatency + limiterLatency + maxOversamplingLatency;
 }
 
 } // namespace SeshEQ
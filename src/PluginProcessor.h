@@ -6,6 +6,7 @@
 #include "dsp/Compressor.h"
 #include "dsp/Gate.h"
 #include "dsp/Limiter.h"
+#include "dsp/TruePeakDetector.h"
 #include "utils/Parameters.h"
 #include "utils/SmoothValue.h"
 #include "utils/FFTProcessor.h"
@@ -20,7 +21,8 @@ namespace SeshEQ {
  * Input -> Input Gain -> Multiband Dynamic EQ (8 bands with per-band dynamics) -> True Peak Limiter -> Output Gain -> Dry/Wet -> Output
  */
 class PluginProcessor : public juce::AudioProcessor,
-                        public juce::AudioProcessorValueTreeState::Listener {
+                        public juce::AudioProcessorValueTreeState::Listener,
+                        private juce::Timer {
 public:
     PluginProcessor();
     ~PluginProcessor() override;
@@ -62,6 +64,9 @@ public:
     // ParameterListener for advanced features
     void parameterChanged(const juce::String& parameterID, float newValue) override;
 
+    // Reports latency changes made on the audio thread (the FIR length follows the bands)
+    void timerCallback() override;
+
     //==============================================================================
     // Public accessors for editor
     
@@ -75,7 +80,7 @@ public:
     float getGateGainReduction() const { return gate.getGainReduction(); }
     float getLimiterGainReduction() const { return limiter.getGainReduction(); }
     float getBandGainReduction(int bandIndex) const { return eqProcessor.getBandGainReduction(bandIndex); }
-    float getTruePeak() const { return limiter.getTruePeak(); }
+    float getTruePeak() const { return truePeakDb.load(); }
     
     // Get input/output levels for metering
     float getInputLevel() const { return inputLevelDb.load(); }
@@ -121,10 +126,16 @@ private:
     // Level metering
     std::atomic<float> inputLevelDb { -100.0f };
     std::atomic<float> outputLevelDb { -100.0f };
+    std::atomic<float> truePeakDb { -100.0f };
+    TruePeakDetector outputTruePeak;
     
     // Dry buffer for wet/dry mix
     juce::AudioBuffer<float> dryBuffer;
     
+    // Dry delay line: room for the longest latency plus a block, read getLatencySamples() behind
+    juce::AudioBuffer<float> dryDelay;
+    int dryDelayPosition = 0;
+    
     // Sample rate
     double currentSampleRate = 44100.0;
     int currentBlockSize = 512;
@@ -138,6 +149,11 @@ private:
     void updateOversamplingFactor();
     int getOversamplingLatency() const;
 
+    // Upper bound of getLatencySamples() at the current sample rate, with a
+    // generous allowance for the oversampling filters at any factor
+    static constexpr int maxOversamplingLatency = 64;
+    int getMaxLatencySamples() const;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PluginProcessor)
 };
 
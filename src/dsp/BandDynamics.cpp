@@ -3,61 +3,28 @@
 
 namespace SeshEQ {
 
-void BandDynamics::prepare(double newSampleRate, int samplesPerBlock) {
-    sampleRate = newSampleRate;
-    compressor.prepare(newSampleRate, samplesPerBlock);
-    reset();
-}
-
-void BandDynamics::reset() {
-    compressor.reset();
-    gainReductionDb.store(0.0f);
-}
-
 void BandDynamics::setThreshold(float dB) {
     thresholdDb = dB;
-    compressor.setThreshold(dB);
 }
 
 void BandDynamics::setRatio(float newRatio) {
     ratio = newRatio;
-    compressor.setRatio(newRatio);
 }
 
 void BandDynamics::setAttack(float ms) {
     attackMs = ms;
-    compressor.setAttack(ms);
 }
 
 void BandDynamics::setRelease(float ms) {
     releaseMs = ms;
-    compressor.setRelease(ms);
 }
 
 void BandDynamics::setKnee(float dB) {
     kneeDb = dB;
-    compressor.setKnee(dB);
 }
 
 void BandDynamics::setEnabled(bool newEnabled) {
     enabled = newEnabled;
-    compressor.setEnabled(newEnabled);
-    if (!enabled) {
-        reset();
-    }
-}
-
-void BandDynamics::process(juce::AudioBuffer<float>& buffer) {
-    if (!enabled) {
-        gainReductionDb.store(0.0f);
-        return;
-    }
-    
-    // Process through compressor
-    compressor.process(buffer);
-    
-    // Update gain reduction for metering
-    gainReductionDb.store(compressor.getGainReduction());
 }
 
 void BandDynamics::connectToParameters(juce::AudioProcessorValueTreeState& apvts, int bandIndex) {
@@ -1,6 +1,5 @@
 #pragma once
 
-#include "Compressor.h"
 #include "utils/Parameters.h"
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <atomic>
@@ -8,19 +7,18 @@
 namespace SeshEQ {
 
 /**
- * @brief Per-band dynamics processor (Compressor/Expander)
+ * @brief Per-band dynamics settings (Compressor/Expander)
  * 
  * Each EQ band can have its own dynamics processing with:
  * - Threshold, Ratio, Attack, Release, Knee
- * - Independent gain reduction metering
+ * 
+ * The audio of all bands runs in one MultibandDynamics pass (or drives the
+ * dynamic EQ bands); see EQProcessor.
  */
 class BandDynamics {
 public:
     BandDynamics() = default;
     
-    void prepare(double sampleRate, int samplesPerBlock);
-    void reset();
-    
     // Parameter setters
     void setThreshold(float dB);
     void setRatio(float ratio);
@@ -29,21 +27,20 @@ public:
     void setKnee(float dB);
     void setEnabled(bool enabled);
     
-    // Process audio for a single band
-    void process(juce::AudioBuffer<float>& buffer);
-    
-    // Get current gain reduction for metering
-    float getGainReduction() const { return gainReductionDb.load(); }
-    
     // Connect to APVTS
     void connectToParameters(juce::AudioProcessorValueTreeState& apvts, int bandIndex);
     void updateFromParameters();
     
     bool isEnabled() const { return enabled; }
     
+    // Settings
+    float getThreshold() const { return thresholdDb; }
+    float getRatio() const { return ratio; }
+    float getAttack() const { return attackMs; }
+    float getRelease() const { return releaseMs; }
+    float getKnee() const { return kneeDb; }
+
 private:
-    Compressor compressor;
-    
     // Parameters
     float thresholdDb = -12.0f;
     float ratio = 2.0f;
@@ -52,10 +49,6 @@ private:
     float kneeDb = 3.0f;
     bool enabled = false;
     
-    // State
-    std::atomic<float> gainReductionDb { 0.0f };
-    double sampleRate = 44100.0;
-    
     // APVTS parameter pointers
     std::atomic<float>* thresholdParam = nullptr;
     std::atomic<float>* ratioParam = nullptr;
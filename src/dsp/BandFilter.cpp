@@ -0,0 +1,112 @@
+#include "BandFilter.h"
+
+namespace SeshEQ {
+
+void BandFilter::prepare(double newSampleRate) {
+    sampleRate = newSampleRate;
+    
+    for (auto& stage : stages) {
+        stage.prepare(sampleRate);
+    }
+    
+    updateStages();
+    reset();
+}
+
+void BandFilter::reset() {
+    for (auto& stage : stages) {
+        stage.reset();
+    }
+}
+
+void BandFilter::setParameters(FilterType type, float frequency, float q, float gainDb) {
+    currentType = type;
+    currentFreq = frequency;
+    currentQ = q;
+    currentGain = gainDb;
+    updateStages();
+}
+
+void BandFilter::setDesignedParameters(FilterType type, float frequency, float q, float gainDb,
+                                       const BiquadFilter::Coefficients* coefs) {
+    currentType = type;
+    currentFreq = frequency;
+    currentQ = q;
+    currentGain = gainDb;
+    applyStages(coefs);
+}
+
+void BandFilter::setType(FilterType type) {
+    if (type == currentType) return;
+    
+    currentType = type;
+    updateStages();
+}
+
+void BandFilter::setOrder(int order) {
+    if (order == currentOrder) return;
+    
+    currentOrder = order;
+    updateStages();
+}
+
+void BandFilter::updateStages() {
+    const BandDesign design { currentType, currentFreq, currentQ, currentGain };
+    std::array<BiquadFilter::Coefficients, maxStages> coefs;
+    
+    CoefficientDesigner::designStages(&design, &currentOrder, coefs.data(), 1, sampleRate);
+    applyStages(coefs.data());
+}
+
+void BandFilter::applyStages(const BiquadFilter::Coefficients* coefs) {
+    const int newNumStages = CoefficientDesigner::getNumStages(currentType, currentOrder);
+    
+    for (int s = 0; s < newNumStages; ++s) {
+        auto& stage = stages[static_cast<size_t>(s)];
+        stage.setDesignedParameters(currentType, currentFreq, currentQ, currentGain, coefs[s]);
+        
+        // Added sections start from rest on their design (no ramp from stale coefficients)
+        if (s >= numStages) {
+            stage.setState(BiquadLaneState());
+        }
+    }
+    
+    numStages = newNumStages;
+    ++revision;
+}
+
+void BandFilter::processStereo(float& left, float& right) {
+    for (int s = 0; s < numStages; ++s) {
+        stages[static_cast<size_t>(s)].processStereo(left, right);
+    }
+}
+
+void BandFilter::processBlock(float* leftData, float* rightData, int numSamples) {
+    for (int s = 0; s < numStages; ++s) {
+        stages[static_cast<size_t>(s)].processBlock(leftData, rightData, numSamples);
+    }
+}
+
+void BandFilter::processMono(float* data, int numSamples) {
+    for (int s = 0; s < numStages; ++s) {
+        stages[static_cast<size_t>(s)].processMono(data, numSamples);
+    }
+}
+
+void BandFilter::processBlockRamped(float* leftData, float* rightData, int numSamples) {
+    for (int s = 0; s < numStages; ++s) {
+        stages[static_cast<size_t>(s)].processBlockRamped(leftData, rightData, numSamples);
+    }
+}
+
+float BandFilter::getMagnitudeAtFrequency(float frequency) const {
+    float magnitude = 1.0f;
+    
+    for (int s = 0; s < numStages; ++s) {
+        magnitude *= stages[static_cast<size_t>(s)].getMagnitudeAtFrequency(frequency);
+    }
+    
+    return magnitude;
+}
+
+} // namespace SeshEQ
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "BiquadFilter.h"
+#include "CoefficientDesigner.h"
+#include <array>
+#include <cstdint>
+
+namespace SeshEQ {
+
+/**
+ * @brief One EQ band: a cascade of up to four stereo biquad sections
+ *
+ * HighPass and LowPass bands take an order (6 dB/oct per order, up to
+ * 48 dB/oct) and run as Butterworth cascades; every other type is one
+ * section (see CoefficientDesigner::designStages). Sections are designed once
+ * per parameter change and run one after another over the block, each with
+ * both channels in one SIMD loop.
+ */
+class BandFilter {
+public:
+    static constexpr int maxStages = CoefficientDesigner::maxStages;
+    
+    BandFilter() = default;
+    
+    void prepare(double sampleRate);
+    
+    /**
+     * @brief Clear the state of all sections
+     */
+    void reset();
+    
+    /**
+     * @brief Set filter parameters and redesign all sections
+     */
+    void setParameters(FilterType type, float frequency, float q, float gainDb = 0.0f);
+    
+    /**
+     * @brief Set parameters together with sections designed elsewhere
+     * @param stages getNumStages() coefficients from CoefficientDesigner::designStages
+     *        for the given type and the current order
+     */
+    void setDesignedParameters(FilterType type, float frequency, float q, float gainDb,
+                               const BiquadFilter::Coefficients* stages);
+    
+    /**
+     * @brief Update the filter type (redesigns only if it changed)
+     */
+    void setType(FilterType type);
+    
+    /**
+     * @brief Set the order of HighPass/LowPass (1 to 8; redesigns only if it changed)
+     *
+     * Sections that become active start from rest.
+     */
+    void setOrder(int order);
+    
+    void processStereo(float& left, float& right);
+    
+    void processBlock(float* leftData, float* rightData, int numSamples);
+    
+    /**
+     * @brief Process a single channel in place (uses the left channel state)
+     */
+    void processMono(float* data, int numSamples);
+    
+    /**
+     * @brief Process a block while every section ramps to its current design
+     * @param rightData May be nullptr for mono
+     */
+    void processBlockRamped(float* leftData, float* rightData, int numSamples);
+    
+    /**
+     * @brief Combined magnitude of all sections
+     */
+    float getMagnitudeAtFrequency(float frequency) const;
+    
+    int getNumStages() const { return numStages; }
+    
+    BiquadFilter::Coefficients getStageCoefficients(int stage) const {
+        return stages[static_cast<size_t>(stage)].getCoefficients();
+    }
+    
+    /**
+     * @brief Section state, for handing it to or from another engine
+     */
+    const BiquadLaneState& getStageState(int stage) const {
+        return stages[static_cast<size_t>(stage)].getState();
+    }
+    
+    /**
+     * @brief Take over section state; its next ramp starts from the current design
+     */
+    void setStageState(int stage, const BiquadLaneState& state) {
+        stages[static_cast<size_t>(stage)].setState(state);
+    }
+    
+    FilterType getType() const { return currentType; }
+    float getFrequency() const { return currentFreq; }
+    float getQ() const { return currentQ; }
+    float getGain() const { return currentGain; }
+    int getOrder() const { return currentOrder; }
+    
+    /**
+     * @brief Counts section redesigns, so a design made from the sections can tell it is stale
+     */
+    uint32_t getRevision() const { return revision; }
+
+private:
+    /**
+     * @brief Redesign all sections from the current parameters
+     */
+    void updateStages();
+    
+    /**
+     * @brief Install designed sections, clearing the ones that become active
+     */
+    void applyStages(const BiquadFilter::Coefficients* coefs);
+    
+    double sampleRate = 44100.0;
+    
+    FilterType currentType = FilterType::Peak;
+    float currentFreq = 1000.0f;
+    float currentQ = 0.707f;
+    float currentGain = 0.0f;
+    int currentOrder = 2;
+    
+    std::array<StereoBiquadFilter, maxStages> stages;
+    int numStages = 1;
+    uint32_t revision = 0;
+};
+
+} // namespace SeshEQ
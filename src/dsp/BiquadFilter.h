@@ -19,6 +19,46 @@ enum class FilterType {
     AllPass
 };
 
+/**
+ * @brief Block state-space form of one biquad (see BiquadKernels::processMono)
+ *
+ * With the TDF-II state s = (z1, z2), a block of N inputs maps to N outputs
+ * and the next state through one matrix:
+ *   [y0 .. yN-1, z1', z2'] = M [z1, z2, x0 .. xN-1]
+ * so every output of the block is an independent multiply-add chain and only
+ * the state carries over from block to block. M depends only on the
+ * coefficients and is rebuilt when they change.
+ */
+struct BiquadBlockForm {
+    static constexpr int maxBlockSize = 8;
+    
+    // N outputs and 2 states, padded to a multiple of 4 rows
+    static constexpr int rowStride = maxBlockSize + 4;
+    
+    // Coefficients M was built from (b0, b1, b2, a1, a2)
+    std::array<double, 5> source {};
+    
+    // Block size M was built for (0 = not built)
+    int blockSize = 0;
+    
+    // Column c holds the contribution of input c (z1, z2, x0, x1, ...) to every row
+    alignas(64) double matrix[maxBlockSize + 2][rowStride] = {};
+};
+
+/**
+ * @brief The parts of a cookbook design that do not depend on the gain
+ *
+ * Every FilterType depends on frequency and Q only through cos(w0) and
+ * alpha = sin(w0) / (2Q), and Peak and the shelves on the gain only through
+ * A = 10^(gain/40). With these cached, a gain change needs no trigonometry
+ * (see CoefficientDesigner::design(terms, gain)).
+ */
+struct BiquadDesignTerms {
+    FilterType type = FilterType::Peak;
+    double cosw0 = 1.0;
+    double alpha = 0.0;
+};
+
 /**
  * @brief Biquad filter implementation using Direct Form II Transposed
  * 
@@ -31,6 +71,12 @@ class BiquadFilter {
 public:
     BiquadFilter() = default;
     
+    // Filter coefficients (normalized, a0 = 1)
+    struct Coefficients {
+        double b0, b1, b2;  // Numerator (feedforward)
+        double a1, a2;       // Denominator (feedback), a0 normalized to 1
+    };
+    
     /**
      * @brief Prepare the filter for processing
      * @param sampleRate The audio sample rate
@@ -51,6 +97,15 @@ public:
      */
     void setParameters(FilterType type, float frequency, float q, float gainDb = 0.0f);
     
+    /**
+     * @brief Set parameters together with coefficients designed elsewhere
+     * 
+     * For callers that design many bands at once with CoefficientDesigner;
+     * the coefficients must match the given parameters.
+     */
+    void setDesignedParameters(FilterType type, float frequency, float q, float gainDb,
+                               const Coefficients& coefs);
+    
     /**
      * @brief Update only the frequency
      */
@@ -63,6 +118,10 @@ public:
     
     /**
      * @brief Update only the gain (for shelf/peak)
+     *
+     * Redesigns from cached frequency/Q terms (no trigonometry), so it is
+     * cheap enough for per-sample gain modulation. The terms are computed on
+     * the first call after a type, frequency, Q or sample rate change.
      */
     void setGain(float gainDb);
     
@@ -78,6 +137,8 @@ public:
     
     /**
      * @brief Process a block of samples in place
+     * 
+     * Uses the block state-space form, several outputs per step (see BiquadBlockForm).
      */
     void processBlock(float* data, int numSamples);
     
@@ -115,11 +176,6 @@ public:
     float getGain() const { return currentGain; }
     
     // Get coefficients (for debugging/visualization)
-    struct Coefficients {
-        double b0, b1, b2;  // Numerator (feedforward)
-        double a1, a2;       // Denominator (feedback), a0 normalized to 1
-    };
-    
     Coefficients getCoefficients() const { return { b0, b1, b2, a1, a2 }; }
     
 private:
@@ -141,80 +197,135 @@ private:
     double b0 = 1.0, b1 = 0.0, b2 = 0.0;
     double a1 = 0.0, a2 = 0.0;
     
+    // Gain-independent design terms for setGain (valid until the next redesign)
+    BiquadDesignTerms designTerms;
+    bool designTermsValid = false;
+    
     // State variables (Direct Form II Transposed)
     double z1 = 0.0;  // z^-1 state
     double z2 = 0.0;  // z^-2 state
     
+    // Block state-space matrix for processBlock
+    BiquadBlockForm blockForm;
+    
     // Pi constant
     static constexpr double pi = 3.14159265358979323846;
 };
 
+/**
+ * @brief Per-channel TDF-II state laid out for SIMD kernels
+ *
+ * Lane i holds the z1/z2 state of channel i, so one register covers the same
+ * band across all channels (see BiquadKernels).
+ */
+struct BiquadLaneState {
+    static constexpr int maxChannels = 4;
+    
+    alignas(32) double z1[maxChannels] = {};
+    alignas(32) double z2[maxChannels] = {};
+};
+
 /**
  * @brief Stereo biquad filter (processes two channels)
+ * 
+ * Both channels share one set of coefficients; their states sit in adjacent
+ * lanes so a block is filtered in a single SIMD TDF-II loop.
  */
 class StereoBiquadFilter {
 public:
     void prepare(double sampleRate) {
-        leftFilter.prepare(sampleRate);
-        rightFilter.prepare(sampleRate);
+        design.prepare(sampleRate);
+        applied = design.getCoefficients();
+        reset();
     }
     
     void reset() {
-        leftFilter.reset();
-        rightFilter.reset();
+        state = BiquadLaneState();
     }
     
     void setParameters(FilterType type, float frequency, float q, float gainDb = 0.0f) {
-        leftFilter.setParameters(type, frequency, q, gainDb);
-        rightFilter.setParameters(type, frequency, q, gainDb);
+        design.setParameters(type, frequency, q, gainDb);
+    }
+    
+    void setDesignedParameters(FilterType type, float frequency, float q, float gainDb,
+                               const BiquadFilter::Coefficients& coefs) {
+        design.setDesignedParameters(type, frequency, q, gainDb, coefs);
     }
     
     void setFrequency(float frequency) {
-        leftFilter.setFrequency(frequency);
-        rightFilter.setFrequency(frequency);
+        design.setFrequency(frequency);
     }
     
     void setQ(float q) {
-        leftFilter.setQ(q);
-        rightFilter.setQ(q);
+        design.setQ(q);
     }
     
     void setGain(float gainDb) {
-        leftFilter.setGain(gainDb);
-        rightFilter.setGain(gainDb);
+        design.setGain(gainDb);
     }
     
     void setType(FilterType type) {
-        leftFilter.setType(type);
-        rightFilter.setType(type);
+        design.setType(type);
     }
     
-    void processStereo(float& left, float& right) {
-        left = leftFilter.processSample(left);
-        right = rightFilter.processSample(right);
-    }
+    void processStereo(float& left, float& right);
     
-    void processBlock(float* leftData, float* rightData, int numSamples) {
-        leftFilter.processBlock(leftData, numSamples);
-        rightFilter.processBlock(rightData, numSamples);
-    }
+    void processBlock(float* leftData, float* rightData, int numSamples);
+    
+    /**
+     * @brief Process a single channel in place (uses the left channel state)
+     * 
+     * One channel leaves no lanes to fill, so this runs the block state-space
+     * form instead (several outputs per step, see BiquadBlockForm).
+     */
+    void processMono(float* data, int numSamples);
+    
+    /**
+     * @brief Process a block while ramping to the current coefficients
+     * 
+     * Starts from the coefficients the previous block ended on and reaches the
+     * current design on the last sample, so parameter changes are faded in
+     * instead of jumping. Jumps if either end is unstable.
+     * @param rightData May be nullptr for mono
+     */
+    void processBlockRamped(float* leftData, float* rightData, int numSamples);
     
     float getMagnitudeAtFrequency(float frequency) const {
-        return leftFilter.getMagnitudeAtFrequency(frequency);
+        return design.getMagnitudeAtFrequency(frequency);
     }
     
     BiquadFilter::Coefficients getCoefficients() const {
-        return leftFilter.getCoefficients();
+        return design.getCoefficients();
     }
     
-    FilterType getType() const { return leftFilter.getType(); }
-    float getFrequency() const { return leftFilter.getFrequency(); }
-    float getQ() const { return leftFilter.getQ(); }
-    float getGain() const { return leftFilter.getGain(); }
+    /**
+     * @brief Filter state, for handing it to or from another engine
+     */
+    const BiquadLaneState& getState() const { return state; }
+    
+    /**
+     * @brief Take over filter state; the next ramp starts from the current design
+     */
+    void setState(const BiquadLaneState& newState) {
+        state = newState;
+        applied = design.getCoefficients();
+    }
+    
+    FilterType getType() const { return design.getType(); }
+    float getFrequency() const { return design.getFrequency(); }
+    float getQ() const { return design.getQ(); }
+    float getGain() const { return design.getGain(); }
     
 private:
-    BiquadFilter leftFilter;
-    BiquadFilter rightFilter;
+    // Holds the parameters and coefficients; its own z1/z2 are not used
+    BiquadFilter design;
+    BiquadLaneState state;
+    
+    // Block state-space matrix for processMono
+    BiquadBlockForm blockForm;
+    
+    // Coefficients the last processed sample ran on (start of the next ramp)
+    BiquadFilter::Coefficients applied { 1.0, 0.0, 0.0, 0.0, 0.0 };
 };
 
 } // namespace SeshEQ
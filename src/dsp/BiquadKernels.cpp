@@ -0,0 +1,441 @@
+#include "BiquadKernels.h"
+#include <algorithm>
+#include <cmath>
+
+namespace SeshEQ {
+namespace BiquadKernels {
+
+namespace {
+
+// Scalar TDF-II on a single lane
+void processLaneScalar(const BiquadFilter::Coefficients& c, double& z1, double& z2,
+                       float* data, int numSamples) {
+    double s1 = z1;
+    double s2 = z2;
+    
+    for (int i = 0; i < numSamples; ++i) {
+        const double x = static_cast<double>(data[i]);
+        const double y = c.b0 * x + s1;
+        s1 = c.b1 * x - c.a1 * y + s2;
+        s2 = c.b2 * x - c.a2 * y;
+        data[i] = static_cast<float>(y);
+    }
+    
+    z1 = s1;
+    z2 = s2;
+}
+
+// Coefficient set with per-sample increments for linear ramps
+struct RampedCoefficients {
+    double b0, b1, b2, a1, a2;
+    double db0, db1, db2, da1, da2;
+    
+    RampedCoefficients(const BiquadFilter::Coefficients& start,
+                       const BiquadFilter::Coefficients& end, int numSamples) {
+        const double inv = 1.0 / static_cast<double>(numSamples);
+        b0 = start.b0; db0 = (end.b0 - start.b0) * inv;
+        b1 = start.b1; db1 = (end.b1 - start.b1) * inv;
+        b2 = start.b2; db2 = (end.b2 - start.b2) * inv;
+        a1 = start.a1; da1 = (end.a1 - start.a1) * inv;
+        a2 = start.a2; da2 = (end.a2 - start.a2) * inv;
+    }
+};
+
+void processLaneRampedScalar(RampedCoefficients c, double& z1, double& z2,
+                             float* data, int numSamples) {
+    double s1 = z1;
+    double s2 = z2;
+    
+    for (int i = 0; i < numSamples; ++i) {
+        c.b0 += c.db0; c.b1 += c.db1; c.b2 += c.db2;
+        c.a1 += c.da1; c.a2 += c.da2;
+        
+        const double x = static_cast<double>(data[i]);
+        const double y = c.b0 * x + s1;
+        s1 = c.b1 * x - c.a1 * y + s2;
+        s2 = c.b2 * x - c.a2 * y;
+        data[i] = static_cast<float>(y);
+    }
+    
+    z1 = s1;
+    z2 = s2;
+}
+
+#if SESHEQ_SIMD_X86
+void processPairRampedSSE2(const RampedCoefficients& c, double* z1, double* z2,
+                           float* ch0, float* ch1, int numSamples) {
+    __m128d b0 = _mm_set1_pd(c.b0), db0 = _mm_set1_pd(c.db0);
+    __m128d b1 = _mm_set1_pd(c.b1), db1 = _mm_set1_pd(c.db1);
+    __m128d b2 = _mm_set1_pd(c.b2), db2 = _mm_set1_pd(c.db2);
+    __m128d a1 = _mm_set1_pd(c.a1), da1 = _mm_set1_pd(c.da1);
+    __m128d a2 = _mm_set1_pd(c.a2), da2 = _mm_set1_pd(c.da2);
+    
+    __m128d s1 = _mm_loadu_pd(z1);
+    __m128d s2 = _mm_loadu_pd(z2);
+    
+    for (int i = 0; i < numSamples; ++i) {
+        b0 = _mm_add_pd(b0, db0); b1 = _mm_add_pd(b1, db1); b2 = _mm_add_pd(b2, db2);
+        a1 = _mm_add_pd(a1, da1); a2 = _mm_add_pd(a2, da2);
+        
+        const __m128d x = _mm_set_pd(static_cast<double>(ch1[i]), static_cast<double>(ch0[i]));
+        const __m128d y = _mm_add_pd(_mm_mul_pd(b0, x), s1);
+        s1 = _mm_add_pd(_mm_sub_pd(_mm_mul_pd(b1, x), _mm_mul_pd(a1, y)), s2);
+        s2 = _mm_sub_pd(_mm_mul_pd(b2, x), _mm_mul_pd(a2, y));
+        
+        const __m128 yf = _mm_cvtpd_ps(y);
+        ch0[i] = _mm_cvtss_f32(yf);
+        ch1[i] = _mm_cvtss_f32(_mm_shuffle_ps(yf, yf, _MM_SHUFFLE(1, 1, 1, 1)));
+    }
+    
+    _mm_storeu_pd(z1, s1);
+    _mm_storeu_pd(z2, s2);
+}
+
+// Two channels in one __m128d (lane 0 = first channel, lane 1 = second)
+void processPairSSE2(const BiquadFilter::Coefficients& c, double* z1, double* z2,
+                     float* ch0, float* ch1, int numSamples) {
+    const __m128d b0 = _mm_set1_pd(c.b0);
+    const __m128d b1 = _mm_set1_pd(c.b1);
+    const __m128d b2 = _mm_set1_pd(c.b2);
+    const __m128d a1 = _mm_set1_pd(c.a1);
+    const __m128d a2 = _mm_set1_pd(c.a2);
+    
+    __m128d s1 = _mm_loadu_pd(z1);
+    __m128d s2 = _mm_loadu_pd(z2);
+    
+    for (int i = 0; i < numSamples; ++i) {
+        const __m128d x = _mm_set_pd(static_cast<double>(ch1[i]), static_cast<double>(ch0[i]));
+        const __m128d y = _mm_add_pd(_mm_mul_pd(b0, x), s1);
+        s1 = _mm_add_pd(_mm_sub_pd(_mm_mul_pd(b1, x), _mm_mul_pd(a1, y)), s2);
+        s2 = _mm_sub_pd(_mm_mul_pd(b2, x), _mm_mul_pd(a2, y));
+        
+        const __m128 yf = _mm_cvtpd_ps(y);
+        ch0[i] = _mm_cvtss_f32(yf);
+        ch1[i] = _mm_cvtss_f32(_mm_shuffle_ps(yf, yf, _MM_SHUFFLE(1, 1, 1, 1)));
+    }
+    
+    _mm_storeu_pd(z1, s1);
+    _mm_storeu_pd(z2, s2);
+}
+#endif
+
+#if SESHEQ_SIMD_NEON
+void processPairRampedNEON(const RampedCoefficients& c, double* z1, double* z2,
+                           float* ch0, float* ch1, int numSamples) {
+    float64x2_t b0 = vdupq_n_f64(c.b0), db0 = vdupq_n_f64(c.db0);
+    float64x2_t b1 = vdupq_n_f64(c.b1), db1 = vdupq_n_f64(c.db1);
+    float64x2_t b2 = vdupq_n_f64(c.b2), db2 = vdupq_n_f64(c.db2);
+    float64x2_t a1 = vdupq_n_f64(c.a1), da1 = vdupq_n_f64(c.da1);
+    float64x2_t a2 = vdupq_n_f64(c.a2), da2 = vdupq_n_f64(c.da2);
+    
+    float64x2_t s1 = vld1q_f64(z1);
+    float64x2_t s2 = vld1q_f64(z2);
+    
+    for (int i = 0; i < numSamples; ++i) {
+        b0 = vaddq_f64(b0, db0); b1 = vaddq_f64(b1, db1); b2 = vaddq_f64(b2, db2);
+        a1 = vaddq_f64(a1, da1); a2 = vaddq_f64(a2, da2);
+        
+        float32x2_t xf = vdup_n_f32(ch0[i]);
+        xf = vset_lane_f32(ch1[i], xf, 1);
+        const float64x2_t x = vcvt_f64_f32(xf);
+        
+        const float64x2_t y = vaddq_f64(vmulq_f64(b0, x), s1);
+        s1 = vaddq_f64(vsubq_f64(vmulq_f64(b1, x), vmulq_f64(a1, y)), s2);
+        s2 = vsubq_f64(vmulq_f64(b2, x), vmulq_f64(a2, y));
+        
+        const float32x2_t yf = vcvt_f32_f64(y);
+        ch0[i] = vget_lane_f32(yf, 0);
+        ch1[i] = vget_lane_f32(yf, 1);
+    }
+    
+    vst1q_f64(z1, s1);
+    vst1q_f64(z2, s2);
+}
+
+void processPairNEON(const BiquadFilter::Coefficients& c, double* z1, double* z2,
+                     float* ch0, float* ch1, int numSamples) {
+    const float64x2_t b0 = vdupq_n_f64(c.b0);
+    const float64x2_t b1 = vdupq_n_f64(c.b1);
+    const float64x2_t b2 = vdupq_n_f64(c.b2);
+    const float64x2_t a1 = vdupq_n_f64(c.a1);
+    const float64x2_t a2 = vdupq_n_f64(c.a2);
+    
+    float64x2_t s1 = vld1q_f64(z1);
+    float64x2_t s2 = vld1q_f64(z2);
+    
+    for (int i = 0; i < numSamples; ++i) {
+        float32x2_t xf = vdup_n_f32(ch0[i]);
+        xf = vset_lane_f32(ch1[i], xf, 1);
+        const float64x2_t x = vcvt_f64_f32(xf);
+        
+        const float64x2_t y = vaddq_f64(vmulq_f64(b0, x), s1);
+        s1 = vaddq_f64(vsubq_f64(vmulq_f64(b1, x), vmulq_f64(a1, y)), s2);
+        s2 = vsubq_f64(vmulq_f64(b2, x), vmulq_f64(a2, y));
+        
+        const float32x2_t yf = vcvt_f32_f64(y);
+        ch0[i] = vget_lane_f32(yf, 0);
+        ch1[i] = vget_lane_f32(yf, 1);
+    }
+    
+    vst1q_f64(z1, s1);
+    vst1q_f64(z2, s2);
+}
+#endif
+
+// Build M column by column by running the recursion on unit inputs
+void buildBlockForm(const BiquadFilter::Coefficients& c, int blockSize, BiquadBlockForm& form) {
+    for (int column = 0; column < blockSize + 2; ++column) {
+        double* m = form.matrix[column];
+        std::fill(m, m + BiquadBlockForm::rowStride, 0.0);
+        
+        double s1 = column == 0 ? 1.0 : 0.0;
+        double s2 = column == 1 ? 1.0 : 0.0;
+        
+        for (int k = 0; k < blockSize; ++k) {
+            const double x = column - 2 == k ? 1.0 : 0.0;
+            const double y = c.b0 * x + s1;
+            s1 = c.b1 * x - c.a1 * y + s2;
+            s2 = c.b2 * x - c.a2 * y;
+            m[k] = y;
+        }
+        
+        m[blockSize] = s1;
+        m[blockSize + 1] = s2;
+    }
+    
+    form.source = { c.b0, c.b1, c.b2, c.a1, c.a2 };
+    form.blockSize = blockSize;
+}
+
+template <int N>
+SESHEQ_FORCE_INLINE void runBlockForm(const BiquadBlockForm& form, double& z1, double& z2,
+                                      float* data, int numBlocks) {
+    constexpr auto rows = static_cast<size_t>(N + 4);
+    
+    double s1 = z1;
+    double s2 = z2;
+    alignas(64) double out[rows];
+    
+    for (int block = 0; block < numBlocks; ++block, data += N) {
+        // Input terms first: they do not depend on the previous block
+        const double x0 = static_cast<double>(data[0]);
+        for (size_t r = 0; r < rows; ++r) {
+            out[r] = form.matrix[2][r] * x0;
+        }
+        for (int j = 1; j < N; ++j) {
+            const double x = static_cast<double>(data[j]);
+            for (size_t r = 0; r < rows; ++r) {
+                out[r] += form.matrix[2 + j][r] * x;
+            }
+        }
+        
+        // State terms close the only dependency between blocks
+        for (size_t r = 0; r < rows; ++r) {
+            out[r] += form.matrix[0][r] * s1 + form.matrix[1][r] * s2;
+        }
+        
+        for (int k = 0; k < N; ++k) {
+            data[k] = static_cast<float>(out[k]);
+        }
+        s1 = out[N];
+        s2 = out[N + 1];
+    }
+    
+    z1 = s1;
+    z2 = s2;
+}
+
+void runBlockForm4(const BiquadBlockForm& form, double& z1, double& z2, float* data, int numBlocks) {
+    runBlockForm<4>(form, z1, z2, data, numBlocks);
+}
+
+#if SESHEQ_SIMD_X86
+SESHEQ_TARGET_AVX2_FMA
+void runBlockForm8AVX2(const BiquadBlockForm& form, double& z1, double& z2, float* data, int numBlocks) {
+    runBlockForm<8>(form, z1, z2, data, numBlocks);
+}
+#endif
+
+struct BlockKernel {
+    void (*fn)(const BiquadBlockForm&, double&, double&, float*, int);
+    int blockSize;
+};
+
+// Eight outputs per step need 3 registers per column; only worth it with 256-bit FMA
+BlockKernel selectBlockKernel() {
+#if SESHEQ_SIMD_X86
+    const auto& caps = SIMD::getCapabilities();
+    if (caps.avx2 && caps.fma) {
+        return { &runBlockForm8AVX2, 8 };
+    }
+#endif
+    return { &runBlockForm4, 4 };
+}
+
+using KernelFn = void (*)(const BiquadFilter::Coefficients&, BiquadLaneState&,
+                          float* const*, int, int);
+
+KernelFn selectKernel() {
+#if SESHEQ_SIMD_X86
+    return SIMD::getCapabilities().avx ? &processAVX : &processSSE2;
+#elif SESHEQ_SIMD_NEON
+    return &processNEON;
+#else
+    return &processScalar;
+#endif
+}
+
+} // namespace
+
+void process(const BiquadFilter::Coefficients& coefs, BiquadLaneState& state,
+             float* const* channels, int numChannels, int numSamples) {
+    if (numChannels < 1 || numSamples < 1) return;
+    
+    numChannels = std::min(numChannels, BiquadLaneState::maxChannels);
+    
+    // A single channel has nothing to share a register with
+    if (numChannels == 1) {
+        processLaneScalar(coefs, state.z1[0], state.z2[0], channels[0], numSamples);
+        return;
+    }
+    
+    static const KernelFn kernel = selectKernel();
+    kernel(coefs, state, channels, numChannels, numSamples);
+}
+
+void processRamped(const BiquadFilter::Coefficients& start, const BiquadFilter::Coefficients& end,
+                   BiquadLaneState& state, float* const* channels, int numChannels, int numSamples) {
+    if (numChannels < 1 || numSamples < 1) return;
+    
+    numChannels = std::min(numChannels, BiquadLaneState::maxChannels);
+    const RampedCoefficients ramp(start, end, numSamples);
+    
+    int ch = 0;
+#if SESHEQ_SIMD_X86
+    for (; ch + 1 < numChannels; ch += 2) {
+        processPairRampedSSE2(ramp, state.z1 + ch, state.z2 + ch,
+                              channels[ch], channels[ch + 1], numSamples);
+    }
+#elif SESHEQ_SIMD_NEON
+    for (; ch + 1 < numChannels; ch += 2) {
+        processPairRampedNEON(ramp, state.z1 + ch, state.z2 + ch,
+                              channels[ch], channels[ch + 1], numSamples);
+    }
+#endif
+    for (; ch < numChannels; ++ch) {
+        processLaneRampedScalar(ramp, state.z1[ch], state.z2[ch], channels[ch], numSamples);
+    }
+}
+
+void processMono(const BiquadFilter::Coefficients& coefs, BiquadBlockForm& form,
+                 double& z1, double& z2, float* data, int numSamples) {
+    if (numSamples < 1) return;
+    
+    static const BlockKernel kernel = selectBlockKernel();
+    const int numBlocks = numSamples / kernel.blockSize;
+    
+    if (numBlocks > 0) {
+        const std::array<double, 5> source { coefs.b0, coefs.b1, coefs.b2, coefs.a1, coefs.a2 };
+        if (form.blockSize != kernel.blockSize || form.source != source) {
+            buildBlockForm(coefs, kernel.blockSize, form);
+        }
+        
+        kernel.fn(form, z1, z2, data, numBlocks);
+    }
+    
+    const int done = numBlocks * kernel.blockSize;
+    processLaneScalar(coefs, z1, z2, data + done, numSamples - done);
+}
+
+bool isStable(const BiquadFilter::Coefficients& coefs) {
+    // Stability triangle for 1 + a1 z^-1 + a2 z^-2, kept slightly inside the edge
+    constexpr double margin = 1e-9;
+    return std::abs(coefs.a2) < 1.0 - margin
+        && std::abs(coefs.a1) < 1.0 + coefs.a2 - margin;
+}
+
+void processScalar(const BiquadFilter::Coefficients& coefs, BiquadLaneState& state,
+                   float* const* channels, int numChannels, int numSamples) {
+    for (int ch = 0; ch < numChannels; ++ch) {
+        processLaneScalar(coefs, state.z1[ch], state.z2[ch], channels[ch], numSamples);
+    }
+}
+
+#if SESHEQ_SIMD_X86
+void processSSE2(const BiquadFilter::Coefficients& coefs, BiquadLaneState& state,
+                 float* const* channels, int numChannels, int numSamples) {
+    int ch = 0;
+    for (; ch + 1 < numChannels; ch += 2) {
+        processPairSSE2(coefs, state.z1 + ch, state.z2 + ch,
+                        channels[ch], channels[ch + 1], numSamples);
+    }
+    if (ch < numChannels) {
+        processLaneScalar(coefs, state.z1[ch], state.z2[ch], channels[ch], numSamples);
+    }
+}
+
+SESHEQ_TARGET_AVX
+void processAVX(const BiquadFilter::Coefficients& coefs, BiquadLaneState& state,
+                float* const* channels, int numChannels, int numSamples) {
+    // Two channels fit in SSE2 already; AVX only pays off for 3-4 channels
+    if (numChannels <= 2) {
+        processSSE2(coefs, state, channels, numChannels, numSamples);
+        return;
+    }
+    
+    const __m256d b0 = _mm256_set1_pd(coefs.b0);
+    const __m256d b1 = _mm256_set1_pd(coefs.b1);
+    const __m256d b2 = _mm256_set1_pd(coefs.b2);
+    const __m256d a1 = _mm256_set1_pd(coefs.a1);
+    const __m256d a2 = _mm256_set1_pd(coefs.a2);
+    
+    __m256d s1 = _mm256_loadu_pd(state.z1);
+    __m256d s2 = _mm256_loadu_pd(state.z2);
+    
+    // Unused lanes read from and write to a scratch sample
+    float scratch = 0.0f;
+    float* ch[4] = { channels[0], channels[1], channels[2],
+                     numChannels > 3 ? channels[3] : &scratch };
+    const int step3 = numChannels > 3 ? 1 : 0;
+    
+    alignas(16) float out[4];
+    
+    for (int i = 0; i < numSamples; ++i) {
+        const __m256d x = _mm256_cvtps_pd(_mm_set_ps(ch[3][i * step3], ch[2][i], ch[1][i], ch[0][i]));
+        const __m256d y = _mm256_add_pd(_mm256_mul_pd(b0, x), s1);
+        s1 = _mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(b1, x), _mm256_mul_pd(a1, y)), s2);
+        s2 = _mm256_sub_pd(_mm256_mul_pd(b2, x), _mm256_mul_pd(a2, y));
+        
+        _mm_store_ps(out, _mm256_cvtpd_ps(y));
+        ch[0][i] = out[0];
+        ch[1][i] = out[1];
+        ch[2][i] = out[2];
+        ch[3][i * step3] = out[3];
+    }
+    
+    // Keep the state of an unused fourth lane untouched
+    alignas(32) double z1[4];
+    alignas(32) double z2[4];
+    _mm256_store_pd(z1, s1);
+    _mm256_store_pd(z2, s2);
+    std::copy(z1, z1 + numChannels, state.z1);
+    std::copy(z2, z2 + numChannels, state.z2);
+}
+#endif
+
+#if SESHEQ_SIMD_NEON
+void processNEON(const BiquadFilter::Coefficients& coefs, BiquadLaneState& state,
+                 float* const* channels, int numChannels, int numSamples) {
+    int ch = 0;
+    for (; ch + 1 < numChannels; ch += 2) {
+        processPairNEON(coefs, state.z1 + ch, state.z2 + ch,
+                        channels[ch], channels[ch + 1], numSamples);
+    }
+    if (ch < numChannels) {
+        processLaneScalar(coefs, state.z1[ch], state.z2[ch], channels[ch], numSamples);
+    }
+}
+#endif
+
+} // namespace BiquadKernels
+} // namespace SeshEQ
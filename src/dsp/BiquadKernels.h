@@ -0,0 +1,78 @@
+#pragma once
+
+#include "BiquadFilter.h"
+#include "utils/SIMDSupport.h"
+
+namespace SeshEQ {
+
+/**
+ * @brief Multi-channel biquad kernels (Direct Form II Transposed)
+ *
+ * All channels of a band share one set of coefficients, and the z1/z2 state of
+ * every channel lives side by side in one register so a single TDF-II loop
+ * filters all of them:
+ * - SSE2: two doubles per register (L/R)
+ * - AVX:  four doubles per register (up to 4 channels)
+ * - NEON: two doubles per register on AArch64
+ *
+ * The variant is selected once at runtime from the detected CPU features.
+ */
+namespace BiquadKernels {
+    
+    /**
+     * @brief Filter up to BiquadLaneState::maxChannels channels in place
+     * @param coefs Shared coefficients (a0 normalized to 1)
+     * @param state Per-channel state, lane i belongs to channels[i]
+     * @param channels Channel pointers
+     * @param numChannels Number of channels (1 to BiquadLaneState::maxChannels)
+     * @param numSamples Number of samples per channel
+     */
+    void process(const BiquadFilter::Coefficients& coefs, BiquadLaneState& state,
+                 float* const* channels, int numChannels, int numSamples);
+    
+    /**
+     * @brief Filter while ramping the coefficients linearly from start to end
+     *
+     * Sample i uses start + (end - start) * (i + 1) / numSamples, so the last
+     * sample runs exactly on the end coefficients. Both sets must be stable;
+     * the stability triangle is convex, so every intermediate set is too.
+     */
+    void processRamped(const BiquadFilter::Coefficients& start, const BiquadFilter::Coefficients& end,
+                       BiquadLaneState& state, float* const* channels, int numChannels, int numSamples);
+    
+    /**
+     * @brief Filter one channel in place with the block state-space form
+     *
+     * Runs blocks of 8 samples (AVX2+FMA) or 4 samples (otherwise) as one
+     * matrix-vector product each, so the outputs inside a block do not wait on
+     * each other; the remaining samples use the TDF-II recursion. The result
+     * equals the recursion up to rounding.
+     * @param form Matrix cache, rebuilt here when the coefficients change
+     * @param z1 TDF-II state, updated
+     * @param z2 TDF-II state, updated
+     */
+    void processMono(const BiquadFilter::Coefficients& coefs, BiquadBlockForm& form,
+                     double& z1, double& z2, float* data, int numSamples);
+    
+    /**
+     * @brief Check that the poles lie inside the unit circle (with a small margin)
+     */
+    bool isStable(const BiquadFilter::Coefficients& coefs);
+    
+    // Individual variants (exposed for testing and benchmarking)
+    void processScalar(const BiquadFilter::Coefficients& coefs, BiquadLaneState& state,
+                       float* const* channels, int numChannels, int numSamples);
+#if SESHEQ_SIMD_X86
+    void processSSE2(const BiquadFilter::Coefficients& coefs, BiquadLaneState& state,
+                     float* const* channels, int numChannels, int numSamples);
+    void processAVX(const BiquadFilter::Coefficients& coefs, BiquadLaneState& state,
+                    float* const* channels, int numChannels, int numSamples);
+#endif
+#if SESHEQ_SIMD_NEON
+    void processNEON(const BiquadFilter::Coefficients& coefs, BiquadLaneState& state,
+                     float* const* channels, int numChannels, int numSamples);
+#endif
+
+} // namespace BiquadKernels
+
+} // namespace SeshEQ
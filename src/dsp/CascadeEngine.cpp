@@ -0,0 +1,353 @@
+#include "CascadeEngine.h"
+#include "BiquadKernels.h"
+#include "utils/SIMDSupport.h"
+#include <algorithm>
+
+namespace SeshEQ {
+
+namespace {
+
+constexpr int maxLanes = CascadeEngine::maxSections;
+
+// Section coefficients in structure-of-arrays form, one lane per section
+struct LaneCoefficients {
+    alignas(64) double b0[maxLanes];
+    alignas(64) double b1[maxLanes];
+    alignas(64) double b2[maxLanes];
+    alignas(64) double a1[maxLanes];
+    alignas(64) double a2[maxLanes];
+};
+
+// Lane k runs on base[k] + delta[k] * t at pipeline step t (delta only used for ramps)
+struct LaneSetup {
+    LaneCoefficients base;
+    LaneCoefficients delta;
+};
+
+// Ramp through successive targets: row s of targets ([segment][lane]) is
+// reached at the end of segment s, starting from initial ([lane])
+struct RampPlan {
+    const BiquadFilter::Coefficients* initial;
+    const BiquadFilter::Coefficients* targets;
+    int numSections;
+    int segmentLength;
+};
+
+void setLane(LaneCoefficients& lanes, int k, const BiquadFilter::Coefficients& c) {
+    lanes.b0[k] = c.b0;
+    lanes.b1[k] = c.b1;
+    lanes.b2[k] = c.b2;
+    lanes.a1[k] = c.a1;
+    lanes.a2[k] = c.a2;
+}
+
+/**
+ * @brief Point lane k at its ramp through a segment
+ *
+ * Lane k reaches sample j at step j + k; within the segment starting at
+ * sample j0 it runs on start + delta * (j - j0 + 1) there. Ramps with an
+ * unstable end jump to the target instead.
+ */
+void enterSegment(LaneSetup& c, const RampPlan& plan, int k, int segment, int numSamples) {
+    const int j0 = segment * plan.segmentLength;
+    const auto& start = segment == 0 ? plan.initial[k] : plan.targets[(segment - 1) * plan.numSections + k];
+    const auto& end = plan.targets[segment * plan.numSections + k];
+    
+    if (!BiquadKernels::isStable(start) || !BiquadKernels::isStable(end)) {
+        setLane(c.base, k, end);
+        setLane(c.delta, k, { 0.0, 0.0, 0.0, 0.0, 0.0 });
+        return;
+    }
+    
+    const double invCount = 1.0 / static_cast<double>(std::min(plan.segmentLength, numSamples - j0));
+    const BiquadFilter::Coefficients delta {
+        (end.b0 - start.b0) * invCount, (end.b1 - start.b1) * invCount,
+        (end.b2 - start.b2) * invCount, (end.a1 - start.a1) * invCount,
+        (end.a2 - start.a2) * invCount
+    };
+    const double offset = static_cast<double>(1 - k - j0);
+    
+    setLane(c.delta, k, delta);
+    setLane(c.base, k, { start.b0 + delta.b0 * offset, start.b1 + delta.b1 * offset,
+                         start.b2 + delta.b2 * offset, start.a1 + delta.a1 * offset,
+                         start.a2 + delta.a2 * offset });
+}
+
+/**
+ * @brief Move the lanes whose sample starts a segment at step t onto that segment
+ * @param phase t modulo the segment length
+ */
+SESHEQ_FORCE_INLINE void enterSegments(LaneSetup& c, const RampPlan& plan, int t, int phase, int numSamples) {
+    for (int k = phase; k < plan.numSections; k += plan.segmentLength) {
+        const int j = t - k;
+        if (j >= 0 && j < numSamples) {
+            enterSegment(c, plan, k, j / plan.segmentLength, numSamples);
+        }
+    }
+}
+
+// One TDF-II update of lane k
+template <bool Ramped>
+SESHEQ_FORCE_INLINE double tick(const LaneSetup& c, int k, double t, double x, double& s1, double& s2) {
+    double b0 = c.base.b0[k], b1 = c.base.b1[k], b2 = c.base.b2[k];
+    double a1 = c.base.a1[k], a2 = c.base.a2[k];
+    
+    if (Ramped) {
+        b0 += c.delta.b0[k] * t; b1 += c.delta.b1[k] * t; b2 += c.delta.b2[k] * t;
+        a1 += c.delta.a1[k] * t; a2 += c.delta.a2[k] * t;
+    }
+    
+    const double y = b0 * x + s1;
+    s1 = b1 * x - a1 * y + s2;
+    s2 = b2 * x - a2 * y;
+    return y;
+}
+
+// Pipeline step t while some lanes have no sample (filling or draining)
+template <int L, bool Ramped>
+SESHEQ_FORCE_INLINE void partialStep(const LaneSetup& c, double* in, double* y, double* s1, double* s2,
+                                     float* data, int numSamples, int t) {
+    const int first = std::max(0, t - numSamples + 1);
+    const int last = std::min(L - 1, t);
+    const double tt = static_cast<double>(t);
+    
+    in[0] = t < numSamples ? static_cast<double>(data[t]) : 0.0;
+    
+    for (int k = first; k <= last; ++k) {
+        y[k] = tick<Ramped>(c, k, tt, in[k], s1[k], s2[k]);
+    }
+    
+    if (last == L - 1) {
+        data[t - L + 1] = static_cast<float>(y[L - 1]);
+    }
+    
+    for (int k = L - 1; k > 0; --k) {
+        in[k] = y[k - 1];
+    }
+}
+
+/**
+ * @brief Run L staggered lanes over one channel
+ *
+ * At step t lane k filters sample t - k; in[k] holds the output lane k - 1
+ * produced on the previous step. Steps where some lanes have no sample (filling
+ * and draining the pipeline) only update the busy lanes. Ramped lanes move on
+ * to the next segment as their sample crosses into it, so the pipeline stays
+ * full across all the segments of the call.
+ */
+template <int L, bool Ramped>
+SESHEQ_FORCE_INLINE void runLanes(LaneSetup& c, const RampPlan& plan, double* z1, double* z2,
+                                  float* data, int numSamples) {
+    constexpr auto lanes = static_cast<size_t>(L);
+    alignas(64) double in[lanes] = {};
+    alignas(64) double y[lanes] = {};
+    alignas(64) double s1[lanes];
+    alignas(64) double s2[lanes];
+    
+    std::copy(z1, z1 + L, s1);
+    std::copy(z2, z2 + L, s2);
+    
+    const int numSteps = numSamples + L - 1;
+    int phase = 0;
+    auto nextPhase = [&plan, &phase]() {
+        if (++phase == plan.segmentLength) phase = 0;
+    };
+    
+    // Fill
+    for (int t = 0; t < std::min(L - 1, numSteps); ++t) {
+        if (Ramped) {
+            enterSegments(c, plan, t, phase, numSamples);
+            nextPhase();
+        }
+        partialStep<L, Ramped>(c, in, y, s1, s2, data, numSamples, t);
+    }
+    
+    // Every lane busy
+    for (int t = L - 1; t < numSamples; ++t) {
+        if (Ramped) {
+            enterSegments(c, plan, t, phase, numSamples);
+            nextPhase();
+        }
+        
+        const double tt = static_cast<double>(t);
+        in[0] = static_cast<double>(data[t]);
+        
+        for (int k = 0; k < L; ++k) {
+            y[k] = tick<Ramped>(c, k, tt, in[k], s1[k], s2[k]);
+        }
+        
+        data[t - L + 1] = static_cast<float>(y[L - 1]);
+        
+        for (int k = L - 1; k > 0; --k) {
+            in[k] = y[k - 1];
+        }
+    }
+    
+    // Drain
+    for (int t = std::max(L - 1, numSamples); t < numSteps; ++t) {
+        if (Ramped) {
+            enterSegments(c, plan, t, t % plan.segmentLength, numSamples);
+        }
+        partialStep<L, Ramped>(c, in, y, s1, s2, data, numSamples, t);
+    }
+    
+    std::copy(s1, s1 + L, z1);
+    std::copy(s2, s2 + L, z2);
+}
+
+using KernelFn = void (*)(LaneSetup&, const RampPlan&, double*, double*, float*, int);
+
+template <int L, bool Ramped>
+struct DefaultKernel {
+    static void run(LaneSetup& c, const RampPlan& plan, double* z1, double* z2, float* data, int numSamples) {
+        runLanes<L, Ramped>(c, plan, z1, z2, data, numSamples);
+    }
+};
+
+#if SESHEQ_SIMD_X86
+template <int L, bool Ramped>
+struct AVX2Kernel {
+    SESHEQ_TARGET_AVX2_FMA
+    static void run(LaneSetup& c, const RampPlan& plan, double* z1, double* z2, float* data, int numSamples) {
+        runLanes<L, Ramped>(c, plan, z1, z2, data, numSamples);
+    }
+};
+#endif
+
+// Lane counts are padded to a multiple of 4; [lanes / 4 - 1][ramped]
+constexpr int numWidths = maxLanes / 4;
+
+struct KernelTable {
+    KernelFn fn[numWidths][2];
+};
+
+template <template <int, bool> class Kernel, int... Widths>
+KernelTable makeKernelTable() {
+    return {{ { &Kernel<Widths, false>::run, &Kernel<Widths, true>::run }... }};
+}
+
+KernelTable selectKernels() {
+#if SESHEQ_SIMD_X86
+    const auto& caps = SIMD::getCapabilities();
+    if (caps.avx2 && caps.fma) {
+        return makeKernelTable<AVX2Kernel, 4, 8, 12, 16, 20, 24, 28, 32>();
+    }
+#endif
+    return makeKernelTable<DefaultKernel, 4, 8, 12, 16, 20, 24, 28, 32>();
+}
+
+} // namespace
+
+void CascadeEngine::reset() {
+    for (auto& section : sections) {
+        section.state = BiquadLaneState();
+        section.applied = section.target;
+    }
+}
+
+void CascadeEngine::setSections(const int* ids, const BiquadFilter::Coefficients* coefs, int numSections) {
+    numActive = std::clamp(numSections, 0, maxSections);
+    
+    for (int i = 0; i < numActive; ++i) {
+        order[static_cast<size_t>(i)] = ids[i];
+        sections[static_cast<size_t>(ids[i])].target = coefs[i];
+    }
+}
+
+void CascadeEngine::process(float* const* channels, int numChannels, int numSamples) {
+    run(channels, numChannels, numSamples, nullptr, numSamples);
+}
+
+void CascadeEngine::processRamped(float* const* channels, int numChannels, int numSamples) {
+    std::array<BiquadFilter::Coefficients, maxSections> targets;
+    for (int k = 0; k < numActive; ++k) {
+        targets[static_cast<size_t>(k)] = sections[static_cast<size_t>(order[static_cast<size_t>(k)])].target;
+    }
+    
+    run(channels, numChannels, numSamples, targets.data(), std::max(numSamples, 1));
+}
+
+void CascadeEngine::processRampedSegments(float* const* channels, int numChannels, int numSamples,
+                                          const BiquadFilter::Coefficients* segmentTargets, int segmentLength) {
+    if (numActive == 0 || numSamples < 1 || segmentLength < 1) return;
+    
+    // The last row is where every section ends up
+    const int lastSegment = (numSamples - 1) / segmentLength;
+    for (int k = 0; k < numActive; ++k) {
+        sections[static_cast<size_t>(order[static_cast<size_t>(k)])].target = segmentTargets[lastSegment * numActive + k];
+    }
+    
+    run(channels, numChannels, numSamples, segmentTargets, segmentLength);
+}
+
+const BiquadLaneState& CascadeEngine::getSectionState(int id) const {
+    return sections[static_cast<size_t>(id)].state;
+}
+
+void CascadeEngine::setSectionState(int id, const BiquadLaneState& state,
+                                    const BiquadFilter::Coefficients& applied) {
+    auto& section = sections[static_cast<size_t>(id)];
+    section.state = state;
+    section.applied = applied;
+}
+
+void CascadeEngine::run(float* const* channels, int numChannels, int numSamples,
+                        const BiquadFilter::Coefficients* segmentTargets, int segmentLength) {
+    if (numActive == 0 || numChannels < 1 || numSamples < 1) return;
+    
+    numChannels = std::min(numChannels, maxChannels);
+    
+    const bool ramped = segmentTargets != nullptr;
+    const int widthIndex = (numActive + 3) / 4 - 1;
+    const int numLanes = 4 * (widthIndex + 1);
+    
+    LaneSetup setup;
+    const BiquadFilter::Coefficients identity { 1.0, 0.0, 0.0, 0.0, 0.0 };
+    const BiquadFilter::Coefficients zero { 0.0, 0.0, 0.0, 0.0, 0.0 };
+    std::array<BiquadFilter::Coefficients, maxSections> initial;
+    
+    // Padding lanes pass their input through; ramped lanes are set up as
+    // their first sample enters them
+    for (int k = 0; k < numLanes; ++k) {
+        const bool active = k < numActive;
+        const auto& section = sections[static_cast<size_t>(active ? order[static_cast<size_t>(k)] : 0)];
+        
+        if (active) {
+            initial[static_cast<size_t>(k)] = section.applied;
+        }
+        setLane(setup.base, k, active ? section.target : identity);
+        setLane(setup.delta, k, zero);
+    }
+    
+    const RampPlan plan { initial.data(), segmentTargets, numActive, segmentLength };
+    
+    static const KernelTable kernels = selectKernels();
+    const KernelFn kernel = kernels.fn[widthIndex][ramped ? 1 : 0];
+    
+    for (int ch = 0; ch < numChannels; ++ch) {
+        alignas(64) double z1[maxLanes] = {};
+        alignas(64) double z2[maxLanes] = {};
+        
+        for (int k = 0; k < numActive; ++k) {
+            const auto& state = sections[static_cast<size_t>(order[static_cast<size_t>(k)])].state;
+            z1[k] = state.z1[ch];
+            z2[k] = state.z2[ch];
+        }
+        
+        LaneSetup lanes = setup;
+        kernel(lanes, plan, z1, z2, channels[ch], numSamples);
+        
+        for (int k = 0; k < numActive; ++k) {
+            auto& state = sections[static_cast<size_t>(order[static_cast<size_t>(k)])].state;
+            state.z1[ch] = z1[k];
+            state.z2[ch] = z2[k];
+        }
+    }
+    
+    for (int k = 0; k < numActive; ++k) {
+        auto& section = sections[static_cast<size_t>(order[static_cast<size_t>(k)])];
+        section.applied = section.target;
+    }
+}
+
+} // namespace SeshEQ
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "BiquadFilter.h"
+#include <array>
+
+namespace SeshEQ {
+
+/**
+ * @brief Serial biquad cascade processed in one pass over the samples
+ *
+ * All active second-order sections sit side by side in structure-of-arrays
+ * lanes and are staggered in time: in one step section k filters sample n - k
+ * while section k + 1 filters sample n - k - 1, with the output of each lane
+ * feeding the next lane on the following step. One step therefore updates every
+ * section with full-width SIMD arithmetic, and each sample is read and written
+ * once for the whole EQ instead of once per band.
+ *
+ * The pipeline is filled and drained inside every call (only the sections that
+ * have a sample to work on are updated), so there is no added latency and the
+ * result equals running the sections one after another in double precision.
+ * Control-rate ramps over a whole block go through one call
+ * (processRampedSegments), so the pipeline fills and drains once per block
+ * rather than once per segment. Lanes are padded to a multiple of four.
+ *
+ * Sections are addressed by a caller id (e.g. the band index); the filter state
+ * and the last applied coefficients belong to the id, so enabling, disabling or
+ * reordering sections never moves state between bands.
+ */
+class CascadeEngine {
+public:
+    static constexpr int maxSections = 32;
+    static constexpr int maxChannels = 2;
+    
+    CascadeEngine() = default;
+    
+    /**
+     * @brief Clear the state of all sections
+     */
+    void reset();
+    
+    /**
+     * @brief Set the active sections in processing order
+     * @param ids Section ids (0 to maxSections - 1), each used at most once
+     * @param coefs Target coefficients per section
+     * @param numSections Number of active sections (0 = pass-through)
+     */
+    void setSections(const int* ids, const BiquadFilter::Coefficients* coefs, int numSections);
+    
+    /**
+     * @brief Filter in place with the target coefficients
+     */
+    void process(float* const* channels, int numChannels, int numSamples);
+    
+    /**
+     * @brief Filter in place, ramping every section from the coefficients its
+     *        previous block ended on to its target (see BiquadKernels::processRamped)
+     *
+     * Sections whose start or end coefficients are unstable jump instead.
+     */
+    void processRamped(float* const* channels, int numChannels, int numSamples);
+    
+    /**
+     * @brief Filter in place, ramping every section through one target per
+     *        segment in a single pass (the pipeline stays full across segments)
+     * @param segmentTargets One row of getNumSections() coefficients per
+     *        segment, in processing order; row s is reached at the end of
+     *        segment s, and the last row becomes the sections' target
+     * @param segmentLength Samples per segment (the last may be shorter)
+     */
+    void processRampedSegments(float* const* channels, int numChannels, int numSamples,
+                               const BiquadFilter::Coefficients* segmentTargets, int segmentLength);
+    
+    int getNumSections() const { return numActive; }
+    
+    /**
+     * @brief Filter state of a section, for handing it to or from a BiquadFilter
+     */
+    const BiquadLaneState& getSectionState(int id) const;
+    
+    /**
+     * @brief Take over the state of a section
+     * @param applied Coefficients the state was last run on (start of the next ramp)
+     */
+    void setSectionState(int id, const BiquadLaneState& state, const BiquadFilter::Coefficients& applied);
+
+private:
+    // segmentTargets nullptr = no ramp
+    void run(float* const* channels, int numChannels, int numSamples,
+             const BiquadFilter::Coefficients* segmentTargets, int segmentLength);
+    
+    struct Section {
+        BiquadLaneState state;
+        BiquadFilter::Coefficients target { 1.0, 0.0, 0.0, 0.0, 0.0 };
+        BiquadFilter::Coefficients applied { 1.0, 0.0, 0.0, 0.0, 0.0 };
+    };
+    
+    std::array<Section, maxSections> sections;
+    std::array<int, maxSections> order {};
+    int numActive = 0;
+};
+
+} // namespace SeshEQ
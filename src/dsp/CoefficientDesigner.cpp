@@ -0,0 +1,295 @@
+#include "CoefficientDesigner.h"
+#include "utils/FastMath.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace SeshEQ {
+namespace CoefficientDesigner {
+
+namespace {
+
+// Keeps A = 10^(gain/40) well inside the double range
+constexpr double maxGainDb = 1000.0;
+
+/**
+ * @brief Cookbook section from the precomputed terms (a0 normalized to 1)
+ */
+inline BiquadFilter::Coefficients designSection(FilterType type, double c, double al,
+                                                double a, double sqrtA) {
+    double b0, b1, b2, a0, a1, a2;
+    
+    switch (type) {
+        case FilterType::LowPass:
+            // H(s) = 1 / (s^2 + s/Q + 1)
+            b0 = (1.0 - c) / 2.0;
+            b1 = 1.0 - c;
+            b2 = (1.0 - c) / 2.0;
+            a0 = 1.0 + al;
+            a1 = -2.0 * c;
+            a2 = 1.0 - al;
+            break;
+        
+        case FilterType::HighPass:
+            // H(s) = s^2 / (s^2 + s/Q + 1)
+            b0 = (1.0 + c) / 2.0;
+            b1 = -(1.0 + c);
+            b2 = (1.0 + c) / 2.0;
+            a0 = 1.0 + al;
+            a1 = -2.0 * c;
+            a2 = 1.0 - al;
+            break;
+        
+        case FilterType::BandPass:
+            // H(s) = (s/Q) / (s^2 + s/Q + 1) (constant skirt gain, peak gain = Q)
+            b0 = al;
+            b1 = 0.0;
+            b2 = -al;
+            a0 = 1.0 + al;
+            a1 = -2.0 * c;
+            a2 = 1.0 - al;
+            break;
+        
+        case FilterType::Notch:
+            // H(s) = (s^2 + 1) / (s^2 + s/Q + 1)
+            b0 = 1.0;
+            b1 = -2.0 * c;
+            b2 = 1.0;
+            a0 = 1.0 + al;
+            a1 = -2.0 * c;
+            a2 = 1.0 - al;
+            break;
+        
+        case FilterType::Peak:
+            // H(s) = (s^2 + s*(A/Q) + 1) / (s^2 + s/(A*Q) + 1)
+            b0 = 1.0 + al * a;
+            b1 = -2.0 * c;
+            b2 = 1.0 - al * a;
+            a0 = 1.0 + al / a;
+            a1 = -2.0 * c;
+            a2 = 1.0 - al / a;
+            break;
+        
+        case FilterType::LowShelf: {
+            // H(s) = A * [ (s^2 + (sqrt(A)/Q)*s + A) / (A*s^2 + (sqrt(A)/Q)*s + 1) ]
+            const double sqrtA_alpha = 2.0 * sqrtA * al;
+            b0 = a * ((a + 1.0) - (a - 1.0) * c + sqrtA_alpha);
+            b1 = 2.0 * a * ((a - 1.0) - (a + 1.0) * c);
+            b2 = a * ((a + 1.0) - (a - 1.0) * c - sqrtA_alpha);
+            a0 = (a + 1.0) + (a - 1.0) * c + sqrtA_alpha;
+            a1 = -2.0 * ((a - 1.0) + (a + 1.0) * c);
+            a2 = (a + 1.0) + (a - 1.0) * c - sqrtA_alpha;
+            break;
+        }
+        
+        case FilterType::HighShelf: {
+            // H(s) = A * [ (A*s^2 + (sqrt(A)/Q)*s + 1) / (s^2 + (sqrt(A)/Q)*s + A) ]
+            const double sqrtA_alpha = 2.0 * sqrtA * al;
+            b0 = a * ((a + 1.0) + (a - 1.0) * c + sqrtA_alpha);
+            b1 = -2.0 * a * ((a - 1.0) + (a + 1.0) * c);
+            b2 = a * ((a + 1.0) + (a - 1.0) * c - sqrtA_alpha);
+            a0 = (a + 1.0) - (a - 1.0) * c + sqrtA_alpha;
+            a1 = 2.0 * ((a - 1.0) - (a + 1.0) * c);
+            a2 = (a + 1.0) - (a - 1.0) * c - sqrtA_alpha;
+            break;
+        }
+        
+        case FilterType::AllPass:
+        default:
+            // H(s) = (s^2 - s/Q + 1) / (s^2 + s/Q + 1)
+            b0 = 1.0 - al;
+            b1 = -2.0 * c;
+            b2 = 1.0 + al;
+            a0 = 1.0 + al;
+            a1 = -2.0 * c;
+            a2 = 1.0 - al;
+            break;
+    }
+    
+    // Normalize coefficients (divide by a0)
+    const double invA0 = 1.0 / a0;
+    return { b0 * invA0, b1 * invA0, b2 * invA0, a1 * invA0, a2 * invA0 };
+}
+
+/**
+ * @brief Design one pass of up to laneCount bands
+ */
+void designLanes(const BandDesign* bands, BiquadFilter::Coefficients* coefs,
+                 int count, double sampleRate) {
+    constexpr int N = laneCount;
+    
+    alignas(64) double w0[N];
+    alignas(64) double gainDb[N];
+    alignas(64) double invTwoQ[N];
+    
+    // Gather parameters (unused lanes repeat the last band)
+    for (int i = 0; i < N; ++i) {
+        const BandDesign& band = bands[std::min(i, count - 1)];
+        const double freq = std::clamp(static_cast<double>(band.frequency), 10.0, sampleRate * 0.499);
+        w0[i] = 2.0 * FastMath::pi * freq / sampleRate;
+        gainDb[i] = std::clamp(static_cast<double>(band.gainDb), -maxGainDb, maxGainDb);
+        invTwoQ[i] = 0.5 / std::max(0.01, static_cast<double>(band.q));
+    }
+    
+    alignas(64) double cosw0[N];
+    alignas(64) double alpha[N];
+    alignas(64) double A[N];
+    alignas(64) double sqrtA[N];
+    
+    // Transcendental terms for all lanes at once (branch-free, vectorizes)
+    for (int i = 0; i < N; ++i) {
+        double sinw0;
+        FastMath::sinCos(w0[i], sinw0, cosw0[i]);
+        alpha[i] = sinw0 * invTwoQ[i];
+        
+        // A = 10^(gain/40), sqrt(A) = 10^(gain/80)
+        A[i] = FastMath::exp2(gainDb[i] * (FastMath::log2Of10 / 40.0));
+        sqrtA[i] = FastMath::exp2(gainDb[i] * (FastMath::log2Of10 / 80.0));
+    }
+    
+    // Per-type cookbook formulas (cheap arithmetic only)
+    for (int i = 0; i < count; ++i) {
+        coefs[i] = designSection(bands[i].type, cosw0[i], alpha[i], A[i], sqrtA[i]);
+    }
+}
+
+/**
+ * @brief Q of pole pair k (0-based, rising Q) of an order-n Butterworth filter
+ */
+double getButterworthQ(int order, int pair) {
+    // Angle of the pole pair from the negative real axis
+    const double angle = FastMath::pi * static_cast<double>(2 * pair + 1 + order % 2)
+                       / static_cast<double>(2 * order);
+    return 0.5 / std::cos(angle);
+}
+
+/**
+ * @brief First-order low/high-pass (bilinear, prewarped at the cutoff)
+ */
+BiquadFilter::Coefficients designOnePole(FilterType type, float frequency, double sampleRate) {
+    const double freq = std::clamp(static_cast<double>(frequency), 10.0, sampleRate * 0.499);
+    const double K = std::tan(FastMath::pi * freq / sampleRate);
+    const double invNorm = 1.0 / (1.0 + K);
+    const double a1 = (K - 1.0) * invNorm;
+    
+    if (type == FilterType::LowPass) {
+        return { K * invNorm, K * invNorm, 0.0, a1, 0.0 };
+    }
+    return { invNorm, -invNorm, 0.0, a1, 0.0 };
+}
+
+bool hasSlope(FilterType type) {
+    return type == FilterType::LowPass || type == FilterType::HighPass;
+}
+
+} // namespace
+
+int getNumStages(FilterType type, int order) {
+    if (!hasSlope(type)) return 1;
+    return (std::clamp(order, 1, 2 * maxStages) + 1) / 2;
+}
+
+void designStages(const BandDesign* bands, const int* orders, BiquadFilter::Coefficients* stages,
+                  int numBands, double sampleRate) {
+    constexpr int maxPairs = laneCount * maxStages;
+    
+    std::array<BandDesign, maxPairs> pairs;
+    std::array<BiquadFilter::Coefficients, maxPairs> pairCoefs;
+    std::array<int, maxPairs> targets;
+    
+    for (int start = 0; start < numBands; start += laneCount) {
+        const int end = std::min(numBands, start + laneCount);
+        int numPairs = 0;
+        
+        // Expand every band into its second-order sections
+        for (int band = start; band < end; ++band) {
+            const BandDesign& design = bands[band];
+            const int order = hasSlope(design.type) ? std::clamp(orders[band], 1, 2 * maxStages) : 2;
+            
+            if (order == 2) {
+                pairs[static_cast<size_t>(numPairs)] = design;
+                targets[static_cast<size_t>(numPairs++)] = band * maxStages;
+                continue;
+            }
+            
+            const int numPairsInBand = order / 2;
+            for (int k = 0; k < numPairsInBand; ++k) {
+                double q = getButterworthQ(order, k);
+                if (k == numPairsInBand - 1) {
+                    q *= static_cast<double>(design.q) / getButterworthQ(2, 0);
+                }
+                
+                auto& pair = pairs[static_cast<size_t>(numPairs)];
+                pair = design;
+                pair.q = static_cast<float>(q);
+                targets[static_cast<size_t>(numPairs++)] = band * maxStages + k;
+            }
+            
+            if (order % 2 != 0) {
+                stages[band * maxStages + numPairsInBand] = designOnePole(design.type, design.frequency, sampleRate);
+            }
+        }
+        
+        CoefficientDesigner::design(pairs.data(), pairCoefs.data(), numPairs, sampleRate);
+        
+        for (int i = 0; i < numPairs; ++i) {
+            stages[targets[static_cast<size_t>(i)]] = pairCoefs[static_cast<size_t>(i)];
+        }
+    }
+}
+
+void design(const BandDesign* bands, BiquadFilter::Coefficients* coefs,
+            int numBands, double sampleRate) {
+    for (int start = 0; start < numBands; start += laneCount) {
+        designLanes(bands + start, coefs + start, std::min(laneCount, numBands - start), sampleRate);
+    }
+}
+
+BiquadFilter::Coefficients design(const BandDesign& band, double sampleRate) {
+    BiquadFilter::Coefficients coefs;
+    designLanes(&band, &coefs, 1, sampleRate);
+    return coefs;
+}
+
+BiquadDesignTerms getDesignTerms(const BandDesign& band, double sampleRate) {
+    const double freq = std::clamp(static_cast<double>(band.frequency), 10.0, sampleRate * 0.499);
+    const double w0 = 2.0 * FastMath::pi * freq / sampleRate;
+    
+    BiquadDesignTerms terms;
+    terms.type = band.type;
+    
+    double sinw0;
+    FastMath::sinCos(w0, sinw0, terms.cosw0);
+    terms.alpha = sinw0 * (0.5 / std::max(0.01, static_cast<double>(band.q)));
+    return terms;
+}
+
+BiquadFilter::Coefficients design(const BiquadDesignTerms& terms, float gainDb) {
+    const double gain = std::clamp(static_cast<double>(gainDb), -maxGainDb, maxGainDb);
+    const double A = FastMath::exp2(gain * (FastMath::log2Of10 / 40.0));
+    const double sqrtA = FastMath::exp2(gain * (FastMath::log2Of10 / 80.0));
+    return designSection(terms.type, terms.cosw0, terms.alpha, A, sqrtA);
+}
+
+double getMagnitude(const BiquadFilter::Coefficients& c, double phi) {
+    // |b0 + b1 z^-1 + b2 z^-2|^2 on the unit circle, written in phi = sin^2(w/2)
+    // so low frequencies do not cancel (poles near z = 1)
+    const double bSum = c.b0 + c.b1 + c.b2;
+    const double num = bSum * bSum
+                     - 4.0 * (c.b0 * c.b1 + 4.0 * c.b0 * c.b2 + c.b1 * c.b2) * phi
+                     + 16.0 * c.b0 * c.b2 * phi * phi;
+    const double aSum = 1.0 + c.a1 + c.a2;
+    const double den = aSum * aSum
+                     - 4.0 * (c.a1 + 4.0 * c.a2 + c.a1 * c.a2) * phi
+                     + 16.0 * c.a2 * phi * phi;
+    
+    return std::sqrt(std::max(num, 0.0) / std::max(den, 1e-300));
+}
+
+double getPhi(double w) {
+    const double s = std::sin(0.5 * w);
+    return s * s;
+}
+
+} // namespace CoefficientDesigner
+} // namespace SeshEQ
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "BiquadFilter.h"
+
+namespace SeshEQ {
+
+/**
+ * @brief Parameters of one band for coefficient design
+ */
+struct BandDesign {
+    FilterType type = FilterType::Peak;
+    float frequency = 1000.0f;
+    float q = 0.707f;
+    float gainDb = 0.0f;
+};
+
+/**
+ * @brief Shared RBJ cookbook coefficient design for all FilterTypes
+ *
+ * Designs up to laneCount bands per pass. The expensive terms (cos/sin w0 and
+ * the shelf/peak amplitude A) are computed for all bands together in
+ * structure-of-arrays form with the branch-free FastMath approximations, so the
+ * compiler vectorizes them; only the cheap per-type arithmetic is per band.
+ *
+ * Used by BiquadFilter, the EQ's control-rate smoothing and the UI curves.
+ */
+namespace CoefficientDesigner {
+    
+    // Bands designed per SIMD pass (one full EQ)
+    constexpr int laneCount = 8;
+    
+    /**
+     * @brief Design coefficients for several bands
+     * @param bands Band parameters
+     * @param coefs Output coefficients (a0 normalized to 1), one per band
+     * @param numBands Number of bands (any count, processed laneCount at a time)
+     * @param sampleRate Sample rate in Hz
+     */
+    void design(const BandDesign* bands, BiquadFilter::Coefficients* coefs,
+                int numBands, double sampleRate);
+    
+    /**
+     * @brief Design coefficients for a single band
+     */
+    BiquadFilter::Coefficients design(const BandDesign& band, double sampleRate);
+    
+    /**
+     * @brief Frequency- and Q-dependent terms of a band, for design(terms, gain)
+     */
+    BiquadDesignTerms getDesignTerms(const BandDesign& band, double sampleRate);
+    
+    /**
+     * @brief Design a band from cached terms at a new gain
+     *
+     * Only A = 10^(gain/40) is recomputed (two exp2, no trigonometry), so a
+     * moving gain costs little more than the per-type arithmetic. Gives the
+     * same coefficients as design() for the band the terms came from.
+     */
+    BiquadFilter::Coefficients design(const BiquadDesignTerms& terms, float gainDb);
+    
+    // Sections per band at the steepest slope (order 8, 48 dB/oct)
+    constexpr int maxStages = 4;
+    
+    /**
+     * @brief Number of sections a band of this type and order runs on
+     *
+     * Only HighPass and LowPass take an order (1 to 2 * maxStages, 6 dB/oct
+     * each); every other type is a single section.
+     */
+    int getNumStages(FilterType type, int order);
+    
+    /**
+     * @brief Design bands as cascades of up to maxStages sections
+     *
+     * HighPass/LowPass bands of order other than 2 become Butterworth cascades:
+     * one cookbook section per pole pair, ordered by rising Q, plus a
+     * first-order section for odd orders. Q scales the highest-Q pair, so the
+     * default Q (0.707) gives the maximally flat response. Order 2 and all
+     * other types design exactly as design().
+     * All second-order sections of all bands share the batched passes.
+     * @param orders Filter order per band
+     * @param stages Output, maxStages entries per band (entries past
+     *        getNumStages are left untouched)
+     */
+    void designStages(const BandDesign* bands, const int* orders, BiquadFilter::Coefficients* stages,
+                      int numBands, double sampleRate);
+    
+    /**
+     * @brief Magnitude of a biquad at phi = sin^2(w / 2), w in radians/sample
+     *
+     * Evaluates |H(e^jw)| from the real-valued squared-magnitude polynomial in phi,
+     * which needs no complex exponentials and stays accurate at low frequencies.
+     */
+    double getMagnitude(const BiquadFilter::Coefficients& coefs, double phi);
+    
+    /**
+     * @brief phi = sin^2(w / 2) for getMagnitude
+     */
+    double getPhi(double w);
+
+} // namespace CoefficientDesigner
+
+} // namespace SeshEQ
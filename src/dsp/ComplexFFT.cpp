@@ -0,0 +1,86 @@
+#include "ComplexFFT.h"
+#include "utils/FastMath.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace SeshEQ {
+
+void ComplexFFT::prepare(int newSize) {
+    size = std::max(newSize, 1);
+    
+    int bits = 0;
+    while ((1 << bits) < size) ++bits;
+    
+    bitReversed.resize(static_cast<size_t>(size));
+    for (int i = 0; i < size; ++i) {
+        int reversed = 0;
+        for (int b = 0; b < bits; ++b) {
+            reversed |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        bitReversed[static_cast<size_t>(i)] = reversed;
+    }
+    
+    twiddleReal.resize(static_cast<size_t>(size - 1));
+    twiddleImag.resize(static_cast<size_t>(size - 1));
+    for (int half = 1; half < size; half *= 2) {
+        for (int k = 0; k < half; ++k) {
+            const double angle = -FastMath::pi * k / half;
+            twiddleReal[static_cast<size_t>(half - 1 + k)] = static_cast<float>(std::cos(angle));
+            twiddleImag[static_cast<size_t>(half - 1 + k)] = static_cast<float>(std::sin(angle));
+        }
+    }
+}
+
+void ComplexFFT::perform(const Complex* input, Complex* output, bool inverse) const {
+    if (size == 0) return;
+    
+    // Bit-reversed order, so the butterflies run in place
+    if (input == output) {
+        for (int i = 0; i < size; ++i) {
+            const int j = bitReversed[static_cast<size_t>(i)];
+            if (i < j) std::swap(output[i], output[j]);
+        }
+    } else {
+        for (int i = 0; i < size; ++i) {
+            output[bitReversed[static_cast<size_t>(i)]] = input[i];
+        }
+    }
+    
+    // Interleaved real and imaginary parts (std::complex guarantees the layout)
+    float* data = reinterpret_cast<float*>(output);
+    
+    // The inverse runs on the conjugate twiddles
+    const float sign = inverse ? -1.0f : 1.0f;
+    
+    for (int half = 1; half < size; half *= 2) {
+        const float* wReal = twiddleReal.data() + (half - 1);
+        const float* wImag = twiddleImag.data() + (half - 1);
+        
+        for (int start = 0; start < size; start += 2 * half) {
+            float* a = data + 2 * start;
+            float* b = a + 2 * half;
+            
+            for (int k = 0; k < half; ++k) {
+                const float wr = wReal[k];
+                const float wi = sign * wImag[k];
+                const float tr = b[2 * k] * wr - b[2 * k + 1] * wi;
+                const float ti = b[2 * k] * wi + b[2 * k + 1] * wr;
+                
+                b[2 * k] = a[2 * k] - tr;
+                b[2 * k + 1] = a[2 * k + 1] - ti;
+                a[2 * k] += tr;
+                a[2 * k + 1] += ti;
+            }
+        }
+    }
+    
+    if (inverse) {
+        const float scale = 1.0f / static_cast<float>(size);
+        for (int i = 0; i < 2 * size; ++i) {
+            data[i] *= scale;
+        }
+    }
+}
+
+} // namespace SeshEQ
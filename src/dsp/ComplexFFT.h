@@ -0,0 +1,50 @@
+#pragma once
+
+#include <complex>
+#include <vector>
+
+namespace SeshEQ {
+
+/**
+ * @brief Complex FFT of a power-of-two size (iterative radix-2)
+ *
+ * Works like juce::dsp::FFT::perform: complex in, complex out, and the
+ * inverse is scaled by 1 / size, so a forward and inverse pass return the
+ * input. The twiddles are computed in double precision and stored stage by
+ * stage, so every butterfly loop reads them in order. The butterflies are
+ * written out on the real and imaginary parts (std::complex multiplication
+ * checks for infinities and does not vectorize).
+ *
+ * All storage is allocated in prepare(); perform() is real-time safe.
+ */
+class ComplexFFT {
+public:
+    using Complex = std::complex<float>;
+    
+    ComplexFFT() = default;
+    
+    /**
+     * @brief Set the size and build the tables
+     * @param size Power of two, at least 1
+     */
+    void prepare(int size);
+    
+    int getSize() const { return size; }
+    
+    /**
+     * @brief Transform size points
+     * @param input May be the same array as output
+     * @param inverse Inverse transform, scaled by 1 / size
+     */
+    void perform(const Complex* input, Complex* output, bool inverse) const;
+
+private:
+    int size = 0;
+    std::vector<int> bitReversed;
+    
+    // exp(-j pi k / half) for k < half, for half = 1, 2, 4, ... (entries half - 1 on)
+    std::vector<float> twiddleReal;
+    std::vector<float> twiddleImag;
+};
+
+} // namespace SeshEQ
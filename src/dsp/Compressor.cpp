@@ -1,5 +1,6 @@
 #include "Compressor.h"
 #include "utils/Parameters.h"
+#include "utils/FastMath.h"
 
 namespace SeshEQ {
 
@@ -56,57 +57,7 @@ void Compressor::setEnabled(bool newEnabled) {
 }
 
 float Compressor::computeGain(float inputDb) const {
-    // Soft knee dynamics curve
-    // Supports both compression (ratio > 1) and expansion (ratio < 1)
-    // Based on: https://www.musicdsp.org/en/latest/Effects/169-compressor.html
-
-    const float halfKnee = kneeDb / 2.0f;
-    const float kneeStart = thresholdDb - halfKnee;
-    const float kneeEnd = thresholdDb + halfKnee;
-
-    float outputDb;
-
-    if (ratio >= 1.0f) {
-        // COMPRESSION MODE (ratio >= 1.0)
-        // Reduce gain for signals above threshold
-        if (inputDb < kneeStart) {
-            // Below knee - no compression
-            outputDb = inputDb;
-        } else if (inputDb > kneeEnd) {
-            // Above knee - full compression
-            outputDb = thresholdDb + (inputDb - thresholdDb) / ratio;
-        } else {
-            // In knee region - smooth transition
-            const float kneeInput = inputDb - kneeStart;
-            const float kneeRange = kneeDb;
-            const float compressionRatio = 1.0f + (ratio - 1.0f) * (kneeInput / kneeRange);
-            outputDb = kneeStart + kneeInput / compressionRatio;
-        }
-    } else {
-        // EXPANSION MODE (ratio < 1.0)
-        // Reduce gain for signals BELOW threshold (downward expansion)
-        // This creates a gate-like effect with smooth transition
-        if (inputDb > kneeEnd) {
-            // Above knee - no expansion (pass through)
-            outputDb = inputDb;
-        } else if (inputDb < kneeStart) {
-            // Below knee - full expansion
-            // For expansion, we attenuate signals below threshold
-            // The expansion ratio inverts: ratio 0.5 means 2:1 expansion
-            const float expansionRatio = 1.0f / ratio;
-            outputDb = thresholdDb - (thresholdDb - inputDb) * expansionRatio;
-        } else {
-            // In knee region - smooth transition
-            const float kneeInput = kneeEnd - inputDb;
-            const float kneeRange = kneeDb;
-            const float t = kneeInput / kneeRange; // 0 at kneeEnd, 1 at kneeStart
-            const float expansionRatio = 1.0f + (1.0f / ratio - 1.0f) * t;
-            outputDb = inputDb - (thresholdDb - inputDb) * (expansionRatio - 1.0f) * t;
-        }
-    }
-
-    // Return gain change (negative for reduction, positive for boost)
-    return outputDb - inputDb;
+    return DynamicsCurve::computeGain(inputDb, thresholdDb, ratio, kneeDb);
 }
 
 void Compressor::process(juce::AudioBuffer<float>& buffer) {
@@ -120,38 +71,40 @@ void Compressor::process(juce::AudioBuffer<float>& buffer) {
     
     if (numChannels < 1 || numSamples < 1) return;
     
-    float* leftChannel = buffer.getWritePointer(0);
-    float* rightChannel = numChannels > 1 ? buffer.getWritePointer(1) : nullptr;
+    const int numDetected = std::min(numChannels, 2);
+    float* channels[2] = {
+        buffer.getWritePointer(0),
+        numChannels > 1 ? buffer.getWritePointer(1) : nullptr
+    };
     
     float maxGainReduction = 0.0f;
+    const float dryGain = 1.0f - mix;
     
-    for (int i = 0; i < numSamples; ++i) {
-        // Get input level
-        float inputLevel;
-        if (rightChannel) {
-            inputLevel = levelDetector.processStereo(leftChannel[i], rightChannel[i]);
-        } else {
-            inputLevel = levelDetector.processSample(leftChannel[i]);
-        }
+    for (int start = 0; start < numSamples; start += chunkSize) {
+        const int count = std::min(chunkSize, numSamples - start);
+        float* leftChannel = channels[0] + start;
+        float* rightChannel = channels[1] != nullptr ? channels[1] + start : nullptr;
         
-        // Convert to dB
-        const float inputDb = dBUtils::linearToDb(inputLevel);
+        // Input level of the whole chunk first
+        const float* detected[2] = { leftChannel, rightChannel };
+        levelDetector.processBlock(detected, numDetected, envelopeBuffer, count);
         
-        // Compute gain reduction
-        const float gr = computeGain(inputDb);
-        maxGainReduction = std::min(maxGainReduction, gr);
+        for (int i = 0; i < count; ++i) {
+            // Compute gain reduction
+            const float gr = computeGain(FastMath::gainToDb(envelopeBuffer[i]));
+            maxGainReduction = std::min(maxGainReduction, gr);
         
-        // Convert gain reduction to linear and apply makeup
-        const float gainLinear = dBUtils::dbToLinear(gr) * makeupGain.getNextGain();
+            // Convert gain reduction to linear and apply makeup
+            const float gainLinear = FastMath::dbToGain(gr) * makeupGain.getNextGain();
         
-        // Apply gain with mix (parallel compression)
-        const float dryGain = 1.0f - mix;
-        const float wetGain = mix * gainLinear;
+            // Apply gain with mix (parallel compression)
+            const float wetGain = mix * gainLinear;
         
-        leftChannel[i] = leftChannel[i] * dryGain + leftChannel[i] * wetGain;
+            leftChannel[i] = leftChannel[i] * dryGain + leftChannel[i] * wetGain;
         
-        if (rightChannel) {
-            rightChannel[i] = rightChannel[i] * dryGain + rightChannel[i] * wetGain;
+            if (rightChannel) {
+                rightChannel[i] = rightChannel[i] * dryGain + rightChannel[i] * wetGain;
+            }
         }
     }
     
@@ -53,6 +53,10 @@ private:
     
     LevelDetector levelDetector;
     
+    // Envelope of the current chunk of samples
+    static constexpr int chunkSize = 64;
+    float envelopeBuffer[chunkSize] = {};
+    
     // Parameters
     float thresholdDb = -18.0f;
     float ratio = 4.0f;
@@ -0,0 +1,501 @@
+#include "CrossoverFilterbank.h"
+#include "CoefficientDesigner.h"
+#include "utils/FastMath.h"
+#include <algorithm>
+#include <cmath>
+
+namespace SeshEQ {
+
+namespace {
+    
+    // Butterworth sections: two in series make one LR4 low or high pass
+    constexpr float butterworthQ = 0.70710678f;
+    
+    // Compensated bands plus the low and high split, per channel
+    constexpr int maxLanes = (CrossoverFilterbank::maxCrossovers + 2) * CrossoverFilterbank::maxChannels;
+    constexpr int laneWidth = 4;
+    static_assert(maxLanes % laneWidth == 0, "Lanes must fill whole SIMD registers");
+    
+    /**
+     * @brief One crossover stage as structure-of-arrays lanes of two sections each
+     *
+     * Every lane filters its own signal; the state is loaded from and stored
+     * back to the crossover it belongs to (nullptr = stateless identity section).
+     */
+    struct LaneBank {
+        alignas(64) double b0[2][maxLanes] = {};
+        alignas(64) double b1[2][maxLanes] = {};
+        alignas(64) double b2[2][maxLanes] = {};
+        alignas(64) double a1[2][maxLanes] = {};
+        alignas(64) double a2[2][maxLanes] = {};
+        alignas(64) double z1[2][maxLanes] = {};
+        alignas(64) double z2[2][maxLanes] = {};
+        
+        double* homeZ1[2][maxLanes] = {};
+        double* homeZ2[2][maxLanes] = {};
+        const float* inputs[maxLanes] = {};
+        float* outputs[maxLanes] = {};
+        int numLanes = 0;
+        
+        void add(const float* input, float* output,
+                 const BiquadFilter::Coefficients& first, double* firstZ1, double* firstZ2,
+                 const BiquadFilter::Coefficients& second, double* secondZ1, double* secondZ2) {
+            const int l = numLanes++;
+            inputs[l] = input;
+            outputs[l] = output;
+            setSection(0, l, first, firstZ1, firstZ2);
+            setSection(1, l, second, secondZ1, secondZ2);
+        }
+        
+        void setSection(int s, int l, const BiquadFilter::Coefficients& c, double* stateZ1, double* stateZ2) {
+            b0[s][l] = c.b0;
+            b1[s][l] = c.b1;
+            b2[s][l] = c.b2;
+            a1[s][l] = c.a1;
+            a2[s][l] = c.a2;
+            homeZ1[s][l] = stateZ1;
+            homeZ2[s][l] = stateZ2;
+            z1[s][l] = stateZ1 ? *stateZ1 : 0.0;
+            z2[s][l] = stateZ2 ? *stateZ2 : 0.0;
+        }
+        
+        void storeState() {
+            for (int s = 0; s < 2; ++s) {
+                for (int l = 0; l < numLanes; ++l) {
+                    if (homeZ1[s][l]) *homeZ1[s][l] = z1[s][l];
+                    if (homeZ2[s][l]) *homeZ2[s][l] = z2[s][l];
+                }
+            }
+        }
+    };
+    
+    const BiquadFilter::Coefficients identity { 1.0, 0.0, 0.0, 0.0, 0.0 };
+    
+    /**
+     * @brief Dot product over a multiple of eight taps, eight partial sums so it vectorizes
+     */
+    float dotProduct(const float* kernel, const float* samples, int length) {
+        float acc[8] = {};
+        
+        for (int j = 0; j < length; j += 8) {
+            for (int m = 0; m < 8; ++m) {
+                acc[m] += kernel[j + m] * samples[j + m];
+            }
+        }
+        
+        return ((acc[0] + acc[4]) + (acc[1] + acc[5])) + ((acc[2] + acc[6]) + (acc[3] + acc[7]));
+    }
+
+} // namespace
+
+int CrossoverFilterbank::getLinearPhaseLatency(double sampleRate) {
+    const double blocks = std::ceil(sampleRate * referenceLatency / referenceSampleRate / 8.0 - 1.0e-9);
+    return 8 * std::max(static_cast<int>(blocks), 1);
+}
+
+void CrossoverFilterbank::prepare(double newSampleRate, int newMaxBlockSize) {
+    sampleRate = newSampleRate;
+    maxBlockSize = std::max(newMaxBlockSize, 1);
+    
+    linearPhaseLatency = getLinearPhaseLatency(sampleRate);
+    firLength = 2 * linearPhaseLatency + 1;
+    
+    // Direct taps cost partitionSize per sample, the FFT partitions about
+    // 8 * firLength / partitionSize: balanced near partitionSize^2 = 4 * latency
+    partitionSize = 8;
+    while (partitionSize * partitionSize < 4 * linearPhaseLatency) {
+        partitionSize *= 2;
+    }
+    numPartitions = (firLength - 1) / partitionSize;
+    fftSize = 2 * partitionSize;
+    
+    const auto numKernels = static_cast<size_t>(maxCrossovers);
+    const auto bins = static_cast<size_t>(fftSize);
+    headKernels.assign(numKernels * static_cast<size_t>(partitionSize), 0.0f);
+    partitionReal.assign(numKernels * static_cast<size_t>(numPartitions) * bins, 0.0f);
+    partitionImag.assign(numKernels * static_cast<size_t>(numPartitions) * bins, 0.0f);
+    designTaps.assign(static_cast<size_t>(firLength), 0.0);
+    
+    twiddleReal.resize(bins / 2);
+    twiddleImag.resize(bins / 2);
+    for (size_t m = 0; m < bins / 2; ++m) {
+        const double angle = -2.0 * FastMath::pi * static_cast<double>(m) / static_cast<double>(fftSize);
+        twiddleReal[m] = static_cast<float>(std::cos(angle));
+        twiddleImag[m] = static_cast<float>(std::sin(angle));
+    }
+    
+    bitReverse.resize(bins);
+    for (int m = 0; m < fftSize; ++m) {
+        int reversed = 0;
+        for (int bit = 1, mirror = fftSize / 2; bit < fftSize; bit <<= 1, mirror >>= 1) {
+            if (m & bit) reversed |= mirror;
+        }
+        bitReverse[static_cast<size_t>(m)] = reversed;
+    }
+    
+    frame.assign(static_cast<size_t>(maxChannels) * bins, 0.0f);
+    spectrumReal.assign(static_cast<size_t>(numPartitions) * bins, 0.0f);
+    spectrumImag.assign(static_cast<size_t>(numPartitions) * bins, 0.0f);
+    scratchReal.assign(bins, 0.0f);
+    scratchImag.assign(bins, 0.0f);
+    partitionOutput.assign(numKernels * maxChannels * static_cast<size_t>(partitionSize), 0.0f);
+    delayLine.assign(static_cast<size_t>(maxChannels * linearPhaseLatency), 0.0f);
+    bandData.assign(static_cast<size_t>(maxBands * maxChannels * maxBlockSize), 0.0f);
+    
+    for (int k = 0; k < numCrossovers; ++k) {
+        designCrossover(k);
+    }
+    reset();
+}
+
+void CrossoverFilterbank::reset() {
+    for (auto& crossover : crossovers) {
+        std::fill(&crossover.lowZ1[0][0], &crossover.lowZ1[0][0] + 2 * maxChannels, 0.0);
+        std::fill(&crossover.lowZ2[0][0], &crossover.lowZ2[0][0] + 2 * maxChannels, 0.0);
+        std::fill(&crossover.highZ1[0][0], &crossover.highZ1[0][0] + 2 * maxChannels, 0.0);
+        std::fill(&crossover.highZ2[0][0], &crossover.highZ2[0][0] + 2 * maxChannels, 0.0);
+        std::fill(&crossover.allPassZ1[0][0], &crossover.allPassZ1[0][0] + maxCrossovers * maxChannels, 0.0);
+        std::fill(&crossover.allPassZ2[0][0], &crossover.allPassZ2[0][0] + maxCrossovers * maxChannels, 0.0);
+    }
+    
+    std::fill(frame.begin(), frame.end(), 0.0f);
+    std::fill(spectrumReal.begin(), spectrumReal.end(), 0.0f);
+    std::fill(spectrumImag.begin(), spectrumImag.end(), 0.0f);
+    std::fill(partitionOutput.begin(), partitionOutput.end(), 0.0f);
+    std::fill(delayLine.begin(), delayLine.end(), 0.0f);
+    framePosition = 0;
+    spectrumPosition = 0;
+    delayPosition = 0;
+}
+
+void CrossoverFilterbank::setPhase(Phase newPhase) {
+    if (newPhase == phase) return;
+    
+    phase = newPhase;
+    for (int k = 0; k < numCrossovers; ++k) {
+        designCrossover(k);
+    }
+    reset();
+}
+
+void CrossoverFilterbank::setCrossovers(const float* newFrequencies, int newNumCrossovers) {
+    newNumCrossovers = std::clamp(newNumCrossovers, 0, maxCrossovers);
+    const float maxFrequency = static_cast<float>(0.49 * sampleRate);
+    
+    const bool countChanged = newNumCrossovers != numCrossovers;
+    numCrossovers = newNumCrossovers;
+    
+    for (int k = 0; k < numCrossovers; ++k) {
+        const float frequency = std::clamp(newFrequencies[k], 1.0f, maxFrequency);
+        
+        if (countChanged || !FastMath::bitsEqual(frequency, frequencies[static_cast<size_t>(k)])) {
+            frequencies[static_cast<size_t>(k)] = frequency;
+            designCrossover(k);
+        }
+    }
+    
+    if (countChanged) {
+        reset();
+    }
+}
+
+void CrossoverFilterbank::designCrossover(int k) {
+    const float frequency = frequencies[static_cast<size_t>(k)];
+    
+    if (phase == Phase::MinimumPhase) {
+        const BandDesign designs[3] = { { FilterType::LowPass, frequency, butterworthQ, 0.0f },
+                                        { FilterType::HighPass, frequency, butterworthQ, 0.0f },
+                                        { FilterType::AllPass, frequency, butterworthQ, 0.0f } };
+        BiquadFilter::Coefficients coefs[3];
+        CoefficientDesigner::design(designs, coefs, 3, sampleRate);
+        
+        auto& crossover = crossovers[static_cast<size_t>(k)];
+        crossover.lowPass = coefs[0];
+        crossover.highPass = coefs[1];
+        crossover.allPass = coefs[2];
+        return;
+    }
+    
+    if (headKernels.empty()) return;
+    
+    // Blackman-windowed sinc, normalized to unity gain at DC
+    const double cutoff = static_cast<double>(frequency) / sampleRate;
+    const double centre = static_cast<double>(linearPhaseLatency);
+    const double span = static_cast<double>(firLength - 1);
+    double sum = 0.0;
+    
+    for (int m = 0; m < firLength; ++m) {
+        const double t = static_cast<double>(m) - centre;
+        const double sinc = m == linearPhaseLatency ? 2.0 * cutoff
+                                                    : std::sin(2.0 * FastMath::pi * cutoff * t) / (FastMath::pi * t);
+        const double angle = 2.0 * FastMath::pi * static_cast<double>(m) / span;
+        const double window = 0.42 - 0.5 * std::cos(angle) + 0.08 * std::cos(2.0 * angle);
+        
+        designTaps[static_cast<size_t>(m)] = sinc * window;
+        sum += designTaps[static_cast<size_t>(m)];
+    }
+    
+    // First partition reversed, so output sample i of the current block is a
+    // dot product over frame[i + 1 .. i + partitionSize]
+    float* head = headKernels.data() + static_cast<size_t>(k * partitionSize);
+    for (int j = 0; j < partitionSize; ++j) {
+        head[j] = static_cast<float>(designTaps[static_cast<size_t>(partitionSize - 1 - j)] / sum);
+    }
+    
+    // Later partitions as spectra, zero-padded to fftSize and with the
+    // inverse transform's 1 / fftSize folded in
+    const double scale = 1.0 / (sum * static_cast<double>(fftSize));
+    for (int p = 0; p < numPartitions; ++p) {
+        const size_t offset = static_cast<size_t>((k * numPartitions + p) * fftSize);
+        float* real = partitionReal.data() + offset;
+        float* imag = partitionImag.data() + offset;
+        
+        for (int j = 0; j < fftSize; ++j) {
+            const int m = (p + 1) * partitionSize + j;
+            real[j] = j < partitionSize && m < firLength
+                    ? static_cast<float>(designTaps[static_cast<size_t>(m)] * scale) : 0.0f;
+            imag[j] = 0.0f;
+        }
+        transform(real, imag, false);
+    }
+}
+
+void CrossoverFilterbank::transform(float* real, float* imag, bool inverse) const {
+    for (int m = 0; m < fftSize; ++m) {
+        const int r = bitReverse[static_cast<size_t>(m)];
+        if (r > m) {
+            std::swap(real[m], real[r]);
+            std::swap(imag[m], imag[r]);
+        }
+    }
+    
+    for (int size = 2; size <= fftSize; size <<= 1) {
+        const int half = size / 2;
+        const int stride = fftSize / size;
+        
+        for (int start = 0; start < fftSize; start += size) {
+            for (int m = 0; m < half; ++m) {
+                const float wr = twiddleReal[static_cast<size_t>(m * stride)];
+                const float wi = inverse ? -twiddleImag[static_cast<size_t>(m * stride)]
+                                         : twiddleImag[static_cast<size_t>(m * stride)];
+                const int a = start + m;
+                const int b = a + half;
+                const float tr = real[b] * wr - imag[b] * wi;
+                const float ti = real[b] * wi + imag[b] * wr;
+                
+                real[b] = real[a] - tr;
+                imag[b] = imag[a] - ti;
+                real[a] += tr;
+                imag[a] += ti;
+            }
+        }
+    }
+}
+
+void CrossoverFilterbank::split(const float* const* input, int numChannels, int numSamples) {
+    numChannels = std::min(numChannels, maxChannels);
+    numSamples = std::min(numSamples, maxBlockSize);
+    
+    if (phase == Phase::LinearPhase) {
+        splitLinearPhase(input, numChannels, numSamples);
+        return;
+    }
+    
+    // The upper rest starts as the input and ends as the top band
+    for (int ch = 0; ch < numChannels; ++ch) {
+        std::copy(input[ch], input[ch] + numSamples, getBand(numCrossovers, ch));
+    }
+    
+    for (int k = 0; k < numCrossovers; ++k) {
+        runMinimumPhaseStage(k, numChannels, numSamples);
+    }
+}
+
+void CrossoverFilterbank::runMinimumPhaseStage(int k, int numChannels, int numSamples) {
+    auto& crossover = crossovers[static_cast<size_t>(k)];
+    LaneBank bank;
+    
+    for (int ch = 0; ch < numChannels; ++ch) {
+        float* rest = getBand(numCrossovers, ch);
+        
+        // Bands already split off get this crossover's allpass
+        for (int band = 0; band < k; ++band) {
+            float* data = getBand(band, ch);
+            bank.add(data, data,
+                     crossover.allPass, &crossover.allPassZ1[band][ch], &crossover.allPassZ2[band][ch],
+                     identity, nullptr, nullptr);
+        }
+        
+        bank.add(rest, getBand(k, ch),
+                 crossover.lowPass, &crossover.lowZ1[0][ch], &crossover.lowZ2[0][ch],
+                 crossover.lowPass, &crossover.lowZ1[1][ch], &crossover.lowZ2[1][ch]);
+        bank.add(rest, rest,
+                 crossover.highPass, &crossover.highZ1[0][ch], &crossover.highZ2[0][ch],
+                 crossover.highPass, &crossover.highZ1[1][ch], &crossover.highZ2[1][ch]);
+    }
+    
+    // Unused lanes have zero coefficients and stay silent
+    const int numLanes = bank.numLanes;
+    const int paddedLanes = (numLanes + laneWidth - 1) / laneWidth * laneWidth;
+    alignas(64) double x[maxLanes] = {};
+    
+    for (int i = 0; i < numSamples; ++i) {
+        // All lanes read before any writes: the low and high pass share the rest
+        for (int l = 0; l < numLanes; ++l) {
+            x[l] = static_cast<double>(bank.inputs[l][i]);
+        }
+        
+        for (int s = 0; s < 2; ++s) {
+            for (int l = 0; l < paddedLanes; ++l) {
+                const double in = x[l];
+                const double y = bank.b0[s][l] * in + bank.z1[s][l];
+                bank.z1[s][l] = bank.b1[s][l] * in - bank.a1[s][l] * y + bank.z2[s][l];
+                bank.z2[s][l] = bank.b2[s][l] * in - bank.a2[s][l] * y;
+                x[l] = y;
+            }
+        }
+        
+        for (int l = 0; l < numLanes; ++l) {
+            bank.outputs[l][i] = static_cast<float>(x[l]);
+        }
+    }
+    
+    bank.storeState();
+}
+
+void CrossoverFilterbank::splitLinearPhase(const float* const* input, int numChannels, int numSamples) {
+    const auto frameLength = static_cast<size_t>(fftSize);
+    
+    for (int start = 0; start < numSamples; ) {
+        // Up to the end of the current partition block
+        const int count = std::min(numSamples - start, partitionSize - framePosition);
+        
+        for (int ch = 0; ch < maxChannels; ++ch) {
+            float* samples = frame.data() + static_cast<size_t>(ch) * frameLength + partitionSize + framePosition;
+            if (ch < numChannels) {
+                std::copy(input[ch] + start, input[ch] + start + count, samples);
+            } else {
+                std::fill(samples, samples + count, 0.0f);
+            }
+        }
+        
+        // Low-pass outputs at every crossover: first partition direct, the
+        // rest computed at the last block boundary
+        for (int ch = 0; ch < numChannels; ++ch) {
+            const float* samples = frame.data() + static_cast<size_t>(ch) * frameLength + framePosition + 1;
+            
+            for (int k = 0; k < numCrossovers; ++k) {
+                const float* head = headKernels.data() + static_cast<size_t>(k * partitionSize);
+                const float* tail = partitionOutput.data()
+                                  + static_cast<size_t>((k * maxChannels + ch) * partitionSize + framePosition);
+                float* out = getBand(k, ch) + start;
+                
+                for (int i = 0; i < count; ++i) {
+                    out[i] = dotProduct(head, samples + i, partitionSize) + tail[i];
+                }
+            }
+        }
+        
+        framePosition += count;
+        start += count;
+        
+        if (framePosition == partitionSize) {
+            runPartitions();
+            framePosition = 0;
+        }
+    }
+    
+    for (int ch = 0; ch < numChannels; ++ch) {
+        // The input delayed by the kernels' centre is the top band
+        float* delay = delayLine.data() + static_cast<size_t>(ch * linearPhaseLatency);
+        float* top = getBand(numCrossovers, ch);
+        int position = delayPosition;
+        
+        for (int i = 0; i < numSamples; ++i) {
+            top[i] = delay[position];
+            delay[position] = input[ch][i];
+            if (++position == linearPhaseLatency) position = 0;
+        }
+        
+        // Adjacent differences turn the low passes into complementary bands
+        for (int band = numCrossovers; band > 0; --band) {
+            float* upper = getBand(band, ch);
+            const float* lower = getBand(band - 1, ch);
+            
+            for (int i = 0; i < numSamples; ++i) {
+                upper[i] -= lower[i];
+            }
+        }
+    }
+    
+    delayPosition = (delayPosition + numSamples) % linearPhaseLatency;
+}
+
+void CrossoverFilterbank::runPartitions() {
+    const auto frameLength = static_cast<size_t>(fftSize);
+    const float* left = frame.data();
+    const float* right = frame.data() + frameLength;
+    
+    // Spectrum of the last two blocks, both channels in one transform
+    spectrumPosition = (spectrumPosition + 1) % numPartitions;
+    float* newestReal = spectrumReal.data() + static_cast<size_t>(spectrumPosition) * frameLength;
+    float* newestImag = spectrumImag.data() + static_cast<size_t>(spectrumPosition) * frameLength;
+    std::copy(left, left + fftSize, newestReal);
+    std::copy(right, right + fftSize, newestImag);
+    transform(newestReal, newestImag, false);
+    
+    for (int k = 0; k < numCrossovers; ++k) {
+        std::fill(scratchReal.begin(), scratchReal.end(), 0.0f);
+        std::fill(scratchImag.begin(), scratchImag.end(), 0.0f);
+        
+        // Partition p meets the spectrum from p blocks ago
+        for (int p = 0; p < numPartitions; ++p) {
+            const int slot = (spectrumPosition - p + numPartitions) % numPartitions;
+            const size_t input = static_cast<size_t>(slot) * frameLength;
+            const size_t kernel = static_cast<size_t>(k * numPartitions + p) * frameLength;
+            const float* xr = spectrumReal.data() + input;
+            const float* xi = spectrumImag.data() + input;
+            const float* hr = partitionReal.data() + kernel;
+            const float* hi = partitionImag.data() + kernel;
+            
+            for (size_t m = 0; m < frameLength; ++m) {
+                scratchReal[m] += xr[m] * hr[m] - xi[m] * hi[m];
+                scratchImag[m] += xr[m] * hi[m] + xi[m] * hr[m];
+            }
+        }
+        
+        transform(scratchReal.data(), scratchImag.data(), true);
+        
+        // Overlap-save: the second half is free of circular wrap
+        float* outLeft = partitionOutput.data() + static_cast<size_t>(k * maxChannels * partitionSize);
+        float* outRight = outLeft + partitionSize;
+        std::copy(scratchReal.begin() + partitionSize, scratchReal.end(), outLeft);
+        std::copy(scratchImag.begin() + partitionSize, scratchImag.end(), outRight);
+    }
+    
+    // The completed block becomes the previous one
+    for (int ch = 0; ch < maxChannels; ++ch) {
+        float* samples = frame.data() + static_cast<size_t>(ch) * frameLength;
+        std::copy(samples + partitionSize, samples + fftSize, samples);
+    }
+}
+
+void CrossoverFilterbank::sum(float* const* output, int numChannels, int numSamples) {
+    numChannels = std::min(numChannels, maxChannels);
+    numSamples = std::min(numSamples, maxBlockSize);
+    
+    for (int ch = 0; ch < numChannels; ++ch) {
+        float* out = output[ch];
+        const float* first = getBand(0, ch);
+        std::copy(first, first + numSamples, out);
+        
+        for (int band = 1; band <= numCrossovers; ++band) {
+            const float* data = getBand(band, ch);
+            for (int i = 0; i < numSamples; ++i) {
+                out[i] += data[i];
+            }
+        }
+    }
+}
+
+} // namespace SeshEQ
@@ -0,0 +1,199 @@
+#pragma once
+
+#include "BiquadFilter.h"
+#include <array>
+#include <vector>
+
+namespace SeshEQ {
+
+/**
+ * @brief Splits a signal into frequency bands that sum back to the input
+ *
+ * MinimumPhase runs Linkwitz-Riley 4th-order (LR4) crossovers, lowest first:
+ * crossover k splits the remaining upper signal into band k (two Butterworth
+ * low-pass sections) and the rest above it (two Butterworth high-pass
+ * sections). The LR4 pair sums to a second-order allpass, so every band below
+ * crossover k also runs through that allpass; the bands then sum to the input
+ * through a flat allpass chain instead of notching at the crossovers.
+ *
+ * Each crossover is one pass over the block: its low-pass, high-pass and
+ * compensation sections of all channels sit side by side in
+ * structure-of-arrays lanes, every lane filtering its own signal, so one step
+ * updates them all with full-width SIMD arithmetic.
+ *
+ * LinearPhase splits with complementary windowed-sinc FIRs instead: band k is
+ * the difference of the low-pass kernels at crossovers k and k - 1, so the
+ * bands sum to the input delayed by getLatency() samples exactly. The kernels
+ * grow with the sample rate, so the transition bands keep their width in Hz.
+ * Each kernel runs as a uniformly partitioned convolution without added
+ * latency: its first partition directly, the rest as overlap-save FFT blocks
+ * that multiply the spectra of past input blocks. Both channels share one
+ * complex FFT (left + j right) and all crossovers share its input spectra.
+ */
+class CrossoverFilterbank {
+public:
+    static constexpr int maxCrossovers = 16;
+    static constexpr int maxBands = maxCrossovers + 1;
+    static constexpr int maxChannels = 2;
+    
+    // Linear-phase kernel delay at the reference rate; other rates scale it
+    static constexpr int referenceLatency = 512;
+    static constexpr double referenceSampleRate = 48000.0;
+    
+    enum class Phase {
+        MinimumPhase,  // LR4 IIR crossovers with allpass compensation (default)
+        LinearPhase    // Complementary FIR crossovers (adds getLinearPhaseLatency())
+    };
+    
+    /**
+     * @brief Delay of the linear-phase kernels at a sample rate
+     *
+     * A multiple of 8, so the delay stays whole when an oversampled rate
+     * reports it at the base rate. The kernels have 2 * latency + 1 taps.
+     */
+    static int getLinearPhaseLatency(double sampleRate);
+    
+    CrossoverFilterbank() = default;
+    
+    /**
+     * @brief Allocate the band buffers
+     * @param maxBlockSize Largest numSamples passed to split()
+     */
+    void prepare(double sampleRate, int maxBlockSize);
+    
+    /**
+     * @brief Clear all filter state and the FIR history
+     */
+    void reset();
+    
+    /**
+     * @brief Switch the crossover type (clears the state if it changed)
+     */
+    void setPhase(Phase phase);
+    
+    Phase getPhase() const { return phase; }
+    
+    /**
+     * @brief Set the crossover frequencies
+     *
+     * Unchanged frequencies keep their design; a different count clears the
+     * state, since the bands no longer line up.
+     * @param frequencies Ascending frequencies in Hz (clamped below Nyquist)
+     * @param numCrossovers 0 to maxCrossovers (0 = one band)
+     */
+    void setCrossovers(const float* frequencies, int numCrossovers);
+    
+    int getNumBands() const { return numCrossovers + 1; }
+    
+    int getLatency() const { return phase == Phase::LinearPhase ? linearPhaseLatency : 0; }
+    
+    int getMaxBlockSize() const { return maxBlockSize; }
+    
+    /**
+     * @brief Split a block into getNumBands() band signals
+     * @param numSamples At most getMaxBlockSize()
+     */
+    void split(const float* const* input, int numChannels, int numSamples);
+    
+    /**
+     * @brief Band signal of the last split (numSamples valid samples)
+     */
+    float* getBand(int band, int channel) {
+        return bandData.data() + static_cast<size_t>((band * maxChannels + channel) * maxBlockSize);
+    }
+    
+    /**
+     * @brief Write the sum of all bands of the last split
+     */
+    void sum(float* const* output, int numChannels, int numSamples);
+
+private:
+    /**
+     * @brief Run crossover k of the LR4 tree: split the rest into band k and
+     *        the new rest, and compensate the bands below
+     */
+    void runMinimumPhaseStage(int k, int numChannels, int numSamples);
+    
+    void splitLinearPhase(const float* const* input, int numChannels, int numSamples);
+    
+    /**
+     * @brief Take the completed input block into the spectrum delay line and
+     *        compute every crossover's FFT partitions for the next block
+     */
+    void runPartitions();
+    
+    /**
+     * @brief In-place radix-2 FFT of one frame (inverse is unscaled)
+     */
+    void transform(float* real, float* imag, bool inverse) const;
+    
+    /**
+     * @brief Redesign crossover k for the current phase
+     */
+    void designCrossover(int k);
+    
+    double sampleRate = 44100.0;
+    int maxBlockSize = 0;
+    Phase phase = Phase::MinimumPhase;
+    
+    int numCrossovers = 0;
+    std::array<float, maxCrossovers> frequencies {};
+    
+    // LR4 sections per crossover: two low-pass, two high-pass and one allpass
+    struct Crossover {
+        BiquadFilter::Coefficients lowPass { 1.0, 0.0, 0.0, 0.0, 0.0 };
+        BiquadFilter::Coefficients highPass { 1.0, 0.0, 0.0, 0.0, 0.0 };
+        BiquadFilter::Coefficients allPass { 1.0, 0.0, 0.0, 0.0, 0.0 };
+        
+        // TDF-II state [section][channel] of the split and [band below][channel]
+        // of the compensation
+        double lowZ1[2][maxChannels] = {};
+        double lowZ2[2][maxChannels] = {};
+        double highZ1[2][maxChannels] = {};
+        double highZ2[2][maxChannels] = {};
+        double allPassZ1[maxCrossovers][maxChannels] = {};
+        double allPassZ2[maxCrossovers][maxChannels] = {};
+    };
+    std::array<Crossover, maxCrossovers> crossovers;
+    
+    // Linear phase: kernels of firLength taps, latency samples delay. The
+    // first partitionSize taps run directly from time-reversed copies, the
+    // numPartitions partitions after them as spectra of fftSize bins
+    int firLength = 0;
+    int linearPhaseLatency = 0;
+    int partitionSize = 0;
+    int numPartitions = 0;
+    int fftSize = 0;
+    std::vector<float> headKernels;     // maxCrossovers x partitionSize
+    std::vector<float> partitionReal;   // maxCrossovers x numPartitions x fftSize
+    std::vector<float> partitionImag;
+    std::vector<double> designTaps;     // firLength
+    
+    // FFT tables: twiddles exp(-2 pi j m / fftSize) and bit-reversed indices
+    std::vector<float> twiddleReal;
+    std::vector<float> twiddleImag;
+    std::vector<int> bitReverse;
+    
+    // Input frame per channel: the previous block, then the one filling up
+    std::vector<float> frame;           // maxChannels x 2 partitionSize
+    int framePosition = 0;
+    
+    // Spectra of the last numPartitions frames, newest at spectrumPosition
+    std::vector<float> spectrumReal;    // numPartitions x fftSize
+    std::vector<float> spectrumImag;
+    int spectrumPosition = 0;
+    
+    // Scratch frame and the partitions' share of the current block
+    std::vector<float> scratchReal;
+    std::vector<float> scratchImag;
+    std::vector<float> partitionOutput; // maxCrossovers x maxChannels x partitionSize
+    
+    // Input delayed by the latency for the top band
+    std::vector<float> delayLine;       // maxChannels x linearPhaseLatency
+    int delayPosition = 0;
+    
+    // maxBands x maxChannels x maxBlockSize
+    std::vector<float> bandData;
+};
+
+} // namespace SeshEQ
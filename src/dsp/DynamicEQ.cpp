@@ -1,160 +1,137 @@
 #include "DynamicEQ.h"
-#include "LevelDetector.h"
+#include "CoefficientDesigner.h"
+#include "utils/FastMath.h"
 #include <algorithm>
-#include <atomic>
+#include <cmath>
 
 namespace SeshEQ {
 
-//==============================================================================
-// DynamicEQBand
-//==============================================================================
+namespace {
 
-DynamicEQBand::DynamicEQBand() = default;
-
-void DynamicEQBand::prepare(double sampleRate, int /*samplesPerBlock*/) {
-    currentSampleRate = sampleRate;
-    filter.prepare(sampleRate);
-    detector.prepare(sampleRate);
-    prepared = true;
+/**
+ * @brief One-pole smoothing coefficient for a time constant (as LevelDetector)
+ */
+float getBallisticsCoefficient(float timeMs, double sampleRate) {
+    if (timeMs <= 0.0f) return 0.0f;  // Instant
+    return static_cast<float>(std::exp(-1.0 / (timeMs / 1000.0 * sampleRate)));
 }
 
-void DynamicEQBand::reset() {
-    filter.reset();
-    detector.reset();
-    gainReductionDb.store(0.0f);
-}
+} // namespace
 
-void DynamicEQBand::setEQParameters(FilterType type, float freq, float qValue, float gainDb) {
-    filterType = type;
-    frequency = freq;
-    q = qValue;
-    staticGainDb = gainDb;
+void SidechainFilterbank::prepare(double newSampleRate) {
+    sampleRate = newSampleRate;
     
-    if (prepared) {
-        filter.setParameters(type, freq, qValue, gainDb);
+    // Redesign every band on its next setBand/setDynamics
+    for (int band = 0; band < maxBands; ++band) {
+        auto& s = settings[static_cast<size_t>(band)];
+        s.frequency = 0.0f;
+        s.attackMs = -1.0f;
+        s.releaseMs = -1.0f;
     }
+    
+    reset();
 }
 
-void DynamicEQBand::setDynamicParameters(float threshold, float ratioValue, float attack, float release, bool enabled) {
-    thresholdDb = threshold;
-    ratio = ratioValue;
-    dynamicEnabled = enabled;
-    
-    if (prepared) {
-        detector.setAttackTime(attack);
-        detector.setReleaseTime(release);
+void SidechainFilterbank::reset() {
+    for (int band = 0; band < maxBands; ++band) {
+        resetBand(band);
     }
 }
 
-void DynamicEQBand::process(juce::AudioBuffer<float>& buffer, const juce::AudioBuffer<float>& sidechainBuffer) {
-    if (!prepared || !dynamicEnabled) {
-        // Process with static gain only
-        filter.setParameters(filterType, frequency, q, staticGainDb);
-        const int numSamples = buffer.getNumSamples();
-        if (buffer.getNumChannels() >= 2) {
-            filter.processBlock(buffer.getWritePointer(0), buffer.getWritePointer(1), numSamples);
-        } else if (buffer.getNumChannels() >= 1) {
-            float* left = buffer.getWritePointer(0);
-            for (int i = 0; i < numSamples; ++i) {
-                float sample = left[i];
-                filter.processStereo(sample, sample);
-                left[i] = sample;
-            }
-        }
-        gainReductionDb.store(0.0f);
-        return;
-    }
+void SidechainFilterbank::resetBand(int band) {
+    if (band < 0 || band >= maxBands) return;
     
-    // Detect level from sidechain
-    const int numSamples = buffer.getNumSamples();
-    const int numChannels = sidechainBuffer.getNumChannels();
-    
-    float maxLevel = 0.0f;
-    for (int ch = 0; ch < numChannels; ++ch) {
-        const float* channelData = sidechainBuffer.getReadPointer(ch);
-        for (int i = 0; i < numSamples; ++i) {
-            maxLevel = std::max(maxLevel, std::abs(channelData[i]));
-        }
+    for (int ch = 0; ch < maxChannels; ++ch) {
+        const int lane = ch * maxBands + band;
+        z1[lane] = 0.0;
+        z2[lane] = 0.0;
     }
+    envelope[band] = 0.0f;
+}
+
+void SidechainFilterbank::setBand(int band, FilterType type, float frequency, float q) {
+    if (band < 0 || band >= maxBands) return;
     
-    const float levelDb = dBUtils::linearToDb(maxLevel);
+    auto& s = settings[static_cast<size_t>(band)];
+    if (type == s.type && FastMath::bitsEqual(frequency, s.frequency) && FastMath::bitsEqual(q, s.q)) return;
     
-    // Calculate gain reduction based on threshold and ratio
-    float dynamicGainDb = staticGainDb;
-    float gr = 0.0f;
+    s.type = type;
+    s.frequency = frequency;
+    s.q = q;
     
-    if (levelDb > thresholdDb) {
-        const float excess = levelDb - thresholdDb;
-        const float compressedExcess = excess / ratio;
-        gr = excess - compressedExcess;
-        dynamicGainDb = staticGainDb - gr;  // Reduce gain when level exceeds threshold
+    // Listen where the band acts: below a low shelf, above a high shelf,
+    // around the centre otherwise
+    FilterType detectionType = FilterType::BandPass;
+    if (type == FilterType::LowShelf) {
+        detectionType = FilterType::LowPass;
+    } else if (type == FilterType::HighShelf) {
+        detectionType = FilterType::HighPass;
     }
     
-    gainReductionDb.store(gr);
+    const auto c = CoefficientDesigner::design({ detectionType, frequency, q, 0.0f }, sampleRate);
     
-    // Apply dynamic gain to filter
-    filter.setParameters(filterType, frequency, q, dynamicGainDb);
-    
-    // Process audio
-    const int bufferChannels = buffer.getNumChannels();
-    if (bufferChannels >= 2) {
-        filter.processBlock(buffer.getWritePointer(0), buffer.getWritePointer(1), numSamples);
-    } else if (bufferChannels >= 1) {
-        float* left = buffer.getWritePointer(0);
-        for (int i = 0; i < numSamples; ++i) {
-            float sample = left[i];
-            filter.processStereo(sample, sample);
-            left[i] = sample;
-        }
+    for (int ch = 0; ch < maxChannels; ++ch) {
+        const int lane = ch * maxBands + band;
+        b0[lane] = c.b0;
+        b1[lane] = c.b1;
+        b2[lane] = c.b2;
+        a1[lane] = c.a1;
+        a2[lane] = c.a2;
     }
 }
 
-//==============================================================================
-// DynamicEQProcessor
-//==============================================================================
-
-DynamicEQProcessor::DynamicEQProcessor() = default;
-
-void DynamicEQProcessor::prepare(double sampleRate, int samplesPerBlock) {
-    for (auto& band : bands) {
-        band.prepare(sampleRate, samplesPerBlock);
-    }
-    prepared = true;
-}
-
-void DynamicEQProcessor::reset() {
-    for (auto& band : bands) {
-        band.reset();
-    }
-}
-
-void DynamicEQProcessor::setBandParameters(int bandIndex, FilterType type, float freq, float q, float gain, bool enabled) {
-    if (bandIndex >= 0 && bandIndex < numBands) {
-        bands[static_cast<size_t>(bandIndex)].setEQParameters(type, freq, q, gain);
+void SidechainFilterbank::setDynamics(int band, float thresholdDb, float ratio, float kneeDb,
+                                      float attackMs, float releaseMs) {
+    if (band < 0 || band >= maxBands) return;
+    
+    auto& s = settings[static_cast<size_t>(band)];
+    s.thresholdDb = thresholdDb;
+    s.ratio = ratio;
+    s.kneeDb = kneeDb;
+    
+    if (!FastMath::bitsEqual(attackMs, s.attackMs)) {
+        s.attackMs = attackMs;
+        attackCoef[band] = getBallisticsCoefficient(attackMs, sampleRate);
     }
-}
-
-void DynamicEQProcessor::setBandDynamicParameters(int bandIndex, float threshold, float ratio, float attack, float release, bool enabled) {
-    if (bandIndex >= 0 && bandIndex < numBands) {
-        bands[static_cast<size_t>(bandIndex)].setDynamicParameters(threshold, ratio, attack, release, enabled);
+    if (!FastMath::bitsEqual(releaseMs, s.releaseMs)) {
+        s.releaseMs = releaseMs;
+        releaseCoef[band] = getBallisticsCoefficient(releaseMs, sampleRate);
     }
 }
 
-void DynamicEQProcessor::process(juce::AudioBuffer<float>& buffer, const juce::AudioBuffer<float>& sidechainBuffer) {
-    if (!prepared) return;
+void SidechainFilterbank::process(const float* left, const float* right, int numSamples) {
+    alignas(64) double x[numLanes];
+    alignas(64) float y[numLanes];
     
-    // Process each band in series
-    for (auto& band : bands) {
-        band.process(buffer, sidechainBuffer);
+    for (int i = 0; i < numSamples; ++i) {
+        const double inLeft = static_cast<double>(left[i]);
+        const double inRight = right != nullptr ? static_cast<double>(right[i]) : 0.0;
+        
+        for (int band = 0; band < maxBands; ++band) {
+            x[band] = inLeft;
+            x[maxBands + band] = inRight;
+        }
+    
+        // Every detection filter of every channel in one step
+        for (int l = 0; l < numLanes; ++l) {
+            const double out = b0[l] * x[l] + z1[l];
+            z1[l] = b1[l] * x[l] - a1[l] * out + z2[l];
+            z2[l] = b2[l] * x[l] - a2[l] * out;
+            y[l] = static_cast<float>(out);
+        }
+    
+        // Peak of both channels, then attack or release (branch-free per band)
+        for (int band = 0; band < maxBands; ++band) {
+            const float level = std::max(std::abs(y[band]), std::abs(y[maxBands + band]));
+            const float coef = level > envelope[band] ? attackCoef[band] : releaseCoef[band];
+            envelope[band] = coef * envelope[band] + (1.0f - coef) * level;
+        }
     }
 }
 
-float DynamicEQProcessor::getBandGainReduction(int bandIndex) const {
-    if (bandIndex >= 0 && bandIndex < numBands) {
-        return bands[static_cast<size_t>(bandIndex)].getGainReduction();
-    }
-    return 0.0f;
+float SidechainFilterbank::getGainChange(int band) const {
+    const auto& s = settings[static_cast<size_t>(band)];
+    return DynamicsCurve::computeGain(dBUtils::linearToDb(envelope[band]), s.thresholdDb, s.ratio, s.kneeDb);
 }
 
 } // namespace SeshEQ
-
@@ -2,109 +2,104 @@
 
 #include "BiquadFilter.h"
 #include "LevelDetector.h"
-#include "utils/SmoothValue.h"
 #include <array>
-#include <juce_audio_processors/juce_audio_processors.h>
 
 namespace SeshEQ {
 
 /**
- * @brief Dynamic EQ band - EQ that responds to audio level
+ * @brief Sidechain analysis of all dynamic EQ bands in one pass
  * 
- * Each band can have its gain modulated by a sidechain signal.
- * Useful for de-essing, dynamic frequency shaping, etc.
+ * Dynamic bands run on the EQ's own filters (one filter state and one
+ * coefficient path per band, see EQProcessor); this is all they add to become
+ * dynamic. Every band listens to a band-limited copy of the sidechain (a
+ * band-pass at the band frequency, or a low/high-pass for shelves) through
+ * peak ballistics like LevelDetector's, and getGainChange() turns its level
+ * into a change of the band gain with the DynamicsCurve.
+ *
+ * The detection filters of all bands and channels sit side by side in
+ * structure-of-arrays lanes (left channels first, then right), and the
+ * envelopes of all bands in another set, so each sample updates every band
+ * with full-width SIMD arithmetic: one pass over the sidechain, whatever the
+ * number of dynamic bands. Bands that are not in use cost their lanes anyway.
  */
-class DynamicEQBand {
+class SidechainFilterbank {
 public:
-    DynamicEQBand();
+    static constexpr int maxBands = 8;
+    static constexpr int maxChannels = 2;
     
-    void prepare(double sampleRate, int samplesPerBlock);
-    void reset();
+    SidechainFilterbank() = default;
     
-    /**
-     * @brief Set static EQ parameters
-     */
-    void setEQParameters(FilterType type, float frequency, float q, float gainDb);
+    void prepare(double sampleRate);
     
     /**
-     * @brief Set dynamic parameters
-     * @param threshold Detection threshold in dB
-     * @param ratio Compression ratio (1.0 = no compression, higher = more)
-     * @param attack Attack time in ms
-     * @param release Release time in ms
-     * @param enabled Whether dynamic mode is enabled
+     * @brief Clear the filter states and envelopes of all bands
      */
-    void setDynamicParameters(float threshold, float ratio, float attack, float release, bool enabled);
+    void reset();
     
     /**
-     * @brief Process audio with sidechain detection
-     * @param buffer Audio buffer to process
-     * @param sidechainBuffer Sidechain signal for detection (can be same as buffer)
+     * @brief Clear one band (before it starts listening again)
      */
-    void process(juce::AudioBuffer<float>& buffer, const juce::AudioBuffer<float>& sidechainBuffer);
+    void resetBand(int band);
     
     /**
-     * @brief Get current gain reduction from dynamic processing
+     * @brief Point a band's detection filter at it (redesigns only on change)
      */
-    float getGainReduction() const { return gainReductionDb.load(); }
-    
-private:
-    StereoBiquadFilter filter;
-    LevelDetector detector;
-    
-    // Static EQ parameters
-    FilterType filterType = FilterType::Peak;
-    float frequency = 1000.0f;
-    float q = 0.707f;
-    float staticGainDb = 0.0f;
-    
-    // Dynamic parameters
-    float thresholdDb = -12.0f;
-    float ratio = 2.0f;
-    bool dynamicEnabled = false;
-    
-    // State
-    std::atomic<float> gainReductionDb { 0.0f };
-    double currentSampleRate = 44100.0;
-    bool prepared = false;
-};
-
-/**
- * @brief Multi-band Dynamic EQ processor
- */
-class DynamicEQProcessor {
-public:
-    static constexpr int numBands = 8;
-    
-    DynamicEQProcessor();
-    
-    void prepare(double sampleRate, int samplesPerBlock);
-    void reset();
+    void setBand(int band, FilterType type, float frequency, float q);
     
     /**
-     * @brief Set band parameters
+     * @brief Set a band's gain curve and ballistics
+     * @param ratio Above 1 cuts the band when loud, below 1 when quiet
      */
-    void setBandParameters(int bandIndex, FilterType type, float freq, float q, float gain, bool enabled);
+    void setDynamics(int band, float thresholdDb, float ratio, float kneeDb, float attackMs, float releaseMs);
     
     /**
-     * @brief Set dynamic parameters for a band
+     * @brief Follow the sidechain with every band
+     * @param right May be nullptr for mono
      */
-    void setBandDynamicParameters(int bandIndex, float threshold, float ratio, float attack, float release, bool enabled);
+    void process(const float* left, const float* right, int numSamples);
     
     /**
-     * @brief Process audio with sidechain
+     * @brief Envelope of a band (linear)
      */
-    void process(juce::AudioBuffer<float>& buffer, const juce::AudioBuffer<float>& sidechainBuffer);
+    float getLevel(int band) const { return envelope[band]; }
     
     /**
-     * @brief Get gain reduction for a band
+     * @brief Band gain change for the level detected so far (dB, negative cuts)
      */
-    float getBandGainReduction(int bandIndex) const;
+    float getGainChange(int band) const;
     
 private:
-    std::array<DynamicEQBand, numBands> bands;
-    bool prepared = false;
+    static constexpr int numLanes = maxBands * maxChannels;
+    
+    double sampleRate = 44100.0;
+    
+    // Detection filters, lane = channel * maxBands + band (TDF-II, a0 = 1)
+    alignas(64) double b0[numLanes] = {};
+    alignas(64) double b1[numLanes] = {};
+    alignas(64) double b2[numLanes] = {};
+    alignas(64) double a1[numLanes] = {};
+    alignas(64) double a2[numLanes] = {};
+    alignas(64) double z1[numLanes] = {};
+    alignas(64) double z2[numLanes] = {};
+    
+    // Ballistics per band
+    alignas(64) float envelope[maxBands] = {};
+    alignas(64) float attackCoef[maxBands] = {};
+    alignas(64) float releaseCoef[maxBands] = {};
+
+    struct BandSettings {
+        // Design of the detection filter
+        FilterType type = FilterType::Peak;
+        float frequency = 0.0f;
+        float q = 0.0f;
+    
+        float thresholdDb = -12.0f;
+        float ratio = 2.0f;
+        float kneeDb = 3.0f;
+        float attackMs = -1.0f;
+        float releaseMs = -1.0f;
+    };
+    std::array<BandSettings, maxBands> settings;
 };
 
 } // namespace SeshEQ
-
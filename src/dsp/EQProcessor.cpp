@@ -1,8 +1,92 @@
 #include "EQProcessor.h"
 #include "utils/MidSideProcessor.h"
+#include "utils/FastMath.h"
+#include "utils/LockFreeExchange.h"
+#include <cmath>
+#include <limits>
 
 namespace SeshEQ {
 
+//==============================================================================
+// Background design of the parallel form
+//==============================================================================
+
+/**
+ * @brief Designs ParallelDesigns on its own thread
+ *
+ * The audio thread posts the current cascade and picks finished designs up
+ * through lock-free exchanges, so it never waits for the pole/residue math.
+ */
+class EQProcessor::ParallelDesignWorker : public juce::Thread {
+public:
+    ParallelDesignWorker() : juce::Thread("SeshEQ Parallel Design") {
+        // Match nothing, so the first request is always posted
+        lastRequest.numSources = -1;
+        startThread();
+    }
+    
+    ~ParallelDesignWorker() override {
+        stopThread(1000);
+    }
+    
+    /**
+     * @brief Ask for a design of this cascade (audio thread, ignored if unchanged)
+     */
+    void request(const int* ids, const uint32_t* revisions, const BiquadFilter::Coefficients* coefs,
+                 int numSections) {
+        if (lastRequest.matches(ids, revisions, numSections)) return;
+        
+        lastRequest.numSources = numSections;
+        for (int k = 0; k < numSections; ++k) {
+            lastRequest.sourceIds[static_cast<size_t>(k)] = ids[k];
+            lastRequest.sourceRevisions[static_cast<size_t>(k)] = revisions[k];
+            lastRequest.sources[static_cast<size_t>(k)] = coefs[k];
+        }
+        
+        requests.getWriteBuffer() = lastRequest;
+        requests.publish();
+    }
+    
+    /**
+     * @brief Pick up the latest finished design (audio thread)
+     * @return true if a new design was copied to design
+     */
+    bool fetch(ParallelDesign& design) {
+        if (!results.update()) return false;
+        
+        design = results.getReadBuffer();
+        return true;
+    }
+    
+    void run() override {
+        while (!threadShouldExit()) {
+            if (requests.update()) {
+                const auto& r = requests.getReadBuffer();
+                ParallelDesigner::design(r.sourceIds.data(), r.sourceRevisions.data(), r.sources.data(),
+                                         r.numSources, results.getWriteBuffer());
+                results.publish();
+            }
+            
+            wait(10);
+        }
+    }
+
+private:
+    // Audio thread copy of the last posted cascade
+    ParallelDesign lastRequest;
+    
+    LockFreeExchange<ParallelDesign> requests;
+    LockFreeExchange<ParallelDesign> results;
+};
+
+//==============================================================================
+// EQProcessor
+//==============================================================================
+
+EQProcessor::EQProcessor() = default;
+
+EQProcessor::~EQProcessor() = default;
+
 void EQProcessor::prepare(double sampleRate, int samplesPerBlock) {
     currentSampleRate = sampleRate;
     
@@ -22,31 +106,58 @@ void EQProcessor::prepare(double sampleRate, int samplesPerBlock) {
             0.0f
         );
         
+        auto& svf = svfFilters[static_cast<size_t>(i)];
+        svf.prepare(sampleRate);
+        svf.setParameters(Constants::defaultBandTypes[static_cast<size_t>(i)],
+                          Constants::defaultBandFrequencies[static_cast<size_t>(i)],
+                          Constants::defaultQ,
+                          0.0f);
+        
         bandEnabled[static_cast<size_t>(i)] = true;
         
-        // Prepare per-band dynamics
-        bandDynamics[static_cast<size_t>(i)].prepare(sampleRate, samplesPerBlock);
+        bandGainReductions[static_cast<size_t>(i)].store(0.0f);
     }
     
-    // Prepare Mid/Side buffers
-    midBuffer.setSize(1, samplesPerBlock);
-    sideBuffer.setSize(1, samplesPerBlock);
+    sidechain.prepare(sampleRate);
+    multibandDynamics.prepare(sampleRate);
+    bandCompressing.fill(false);
+    bandDynamic.fill(false);
+    bandLeavingDynamic.fill(false);
     
-    // Prepare Linear Phase EQ
-    if (linearPhaseMode) {
-        if (!linearPhaseEQ) {
-            linearPhaseEQ = std::make_unique<LinearPhaseEQ>();
-        }
-        linearPhaseEQ->prepare(sampleRate, samplesPerBlock);
+    cascade.reset();
+    parallel.reset();
+    parallelActive = false;
+    
+    crossover.prepare(sampleRate, samplesPerBlock);
+    
+    // Parallel form: design thread, priming history and crossfade buffer
+    if (!designWorker) {
+        designWorker = std::make_unique<ParallelDesignWorker>();
     }
+    history.setSize(CascadeEngine::maxChannels, historyLength);
+    primeBuffer.setSize(CascadeEngine::maxChannels, historyLength);
+    fadeBuffer.setSize(CascadeEngine::maxChannels, samplesPerBlock);
+    historyWritePosition = 0;
+    historyFill = 0;
     
-    // Prepare Dynamic EQ
-    if (dynamicEQMode) {
-        if (!dynamicEQ) {
-            dynamicEQ = std::make_unique<DynamicEQProcessor>();
-        }
-        dynamicEQ->prepare(sampleRate, samplesPerBlock);
+    // Control-rate design tables (one extra segment for a partial tail)
+    maxSegments = samplesPerBlock / coefficientUpdateInterval + 2;
+    segmentDesigns.assign(static_cast<size_t>(maxSegments * numBands), BandDesign());
+    segmentCoefficients.assign(static_cast<size_t>(maxSegments * numBands * maxStages),
+                               BiquadFilter::Coefficients { 1.0, 0.0, 0.0, 0.0, 0.0 });
+    segmentGainChanges.assign(static_cast<size_t>(maxSegments * numBands), 0.0f);
+    segmentSectionTargets.assign(static_cast<size_t>(maxSegments * CascadeEngine::maxSections),
+                                 BiquadFilter::Coefficients { 1.0, 0.0, 0.0, 0.0, 0.0 });
+    
+    // Linear Phase EQ is prepared up front, so switching modes never
+    // allocates on the audio thread
+    if (!linearPhaseEQ) {
+        linearPhaseEQ = std::make_unique<LinearPhaseEQ>();
     }
+    linearPhaseImpulseLength = getLinearPhaseImpulseLength();
+    linearPhaseEQ->setImpulseLength(linearPhaseImpulseLength);
+    linearPhaseEQ->setFirPhase(firPhase, firPhaseMix);
+    linearPhaseEQ->prepare(sampleRate, samplesPerBlock);
     
     prepared = true;
 }
@@ -55,6 +166,16 @@ void EQProcessor::reset() {
     for (auto& filter : filters) {
         filter.reset();
     }
+    for (auto& svf : svfFilters) {
+        svf.reset();
+    }
+    sidechain.reset();
+    cascade.reset();
+    parallel.reset();
+    parallelActive = false;
+    historyFill = 0;
+    crossover.reset();
+    multibandDynamics.reset();
 }
 
 void EQProcessor::process(juce::AudioBuffer<float>& buffer) {
@@ -70,31 +191,17 @@ void EQProcessor::process(juce::AudioBuffer<float>& buffer) {
         return;
     }
     
-    // Use Dynamic EQ if enabled
-    if (dynamicEQMode && dynamicEQ) {
-        dynamicEQ->process(buffer, buffer);  // Use same buffer as sidechain
-        return;
-    }
-    
     // Standard processing with optional Mid/Side
     if (midSideMode && numChannels >= 2) {
-        // Process in Mid/Side domain
-        MidSideProcessor::process(buffer,
-            [this](float* mid, int numSamples) {
-                // Process mid channel
-                juce::AudioBuffer<float> midBuf(1, numSamples);
-                std::copy(mid, mid + numSamples, midBuf.getWritePointer(0));
-                processStandard(midBuf);
-                std::copy(midBuf.getReadPointer(0), midBuf.getReadPointer(0) + numSamples, mid);
-            },
-            [this](float* side, int numSamples) {
-                // Process side channel
-                juce::AudioBuffer<float> sideBuf(1, numSamples);
-                std::copy(side, side + numSamples, sideBuf.getWritePointer(0));
-                processStandard(sideBuf);
-                std::copy(sideBuf.getReadPointer(0), sideBuf.getReadPointer(0) + numSamples, side);
-            }
-        );
+        // Process in Mid/Side domain: Mid and Side replace L/R in place and run
+        // through the bands as one pair, each with its own filter state
+        float* left = buffer.getWritePointer(0);
+        float* right = buffer.getWritePointer(1);
+        const int numSamples = buffer.getNumSamples();
+        
+        MidSideProcessor::encodeInPlace(left, right, numSamples);
+        processStandard(buffer);
+        MidSideProcessor::decodeInPlace(left, right, numSamples);
     } else {
         // Standard stereo/mono processing
         processStandard(buffer);
@@ -102,78 +209,754 @@ void EQProcessor::process(juce::AudioBuffer<float>& buffer) {
 }
 
 void EQProcessor::processStandard(juce::AudioBuffer<float>& buffer) {
+    if (buffer.getNumChannels() < 1) return;
+    
+    // The dynamics settings drive either the dynamic bands or the crossover split
+    for (auto& dynamics : bandDynamics) {
+        dynamics.updateFromParameters();
+    }
+    
+    processBands(buffer);
+    processDynamics(buffer);
+}
+
+void EQProcessor::processBands(juce::AudioBuffer<float>& buffer) {
     const int numChannels = buffer.getNumChannels();
     const int numSamples = buffer.getNumSamples();
     
-    if (numChannels < 1) return;
+    bool anySmoothing = false;
     
-    // Create a working buffer for each band's processing
-    juce::AudioBuffer<float> bandBuffer(numChannels, numSamples);
+    // Detect on the input, before the bands filter it in place
+    detectDynamicBands(buffer);
     
-    // Process each enabled band
     for (int band = 0; band < numBands; ++band) {
-        if (!bandEnabled[static_cast<size_t>(band)]) continue;
+        const auto& smoother = smoothers[static_cast<size_t>(band)];
+        const bool enabled = bandEnabled[static_cast<size_t>(band)];
         
-        // Copy current buffer state to band buffer
-        bandBuffer.makeCopyOf(buffer, true);
+        // Dynamic bands are designed at control rate like smoothing ones; a band
+        // that just left dynamic mode takes one more block to lose its gain change
+        bandSmoothing[static_cast<size_t>(band)] = enabled
+                                                   && (smoother.frequency.isSmoothing()
+                                                       || smoother.q.isSmoothing()
+                                                       || smoother.gain.isSmoothing()
+                                                       || bandDynamic[static_cast<size_t>(band)]
+                                                       || bandLeavingDynamic[static_cast<size_t>(band)]);
+        anySmoothing = anySmoothing || bandSmoothing[static_cast<size_t>(band)];
+        
+        if (enabled) {
+            bandLeavingDynamic[static_cast<size_t>(band)] = false;
+        }
+    }
+    
+    // Switching engines starts the new engine from cleared state
+    const FilterEngine engine = filterEngine;
+    if (engine != activeEngine) {
+        for (auto& filter : filters) {
+            filter.reset();
+        }
+        for (auto& svf : svfFilters) {
+            svf.reset();
+        }
+        cascade.reset();
+        parallel.reset();
+        parallelActive = false;
+        activeEngine = engine;
+    }
+    
+    // The SVF engine interpolates smoothed parameters itself; its multi-stage
+    // bands run on the band filters, so those take the state back from the cascade
+    if (engine == FilterEngine::StateVariable) {
+        setCascadeActive(false);
+        historyFill = 0;
+        processStateVariable(buffer);
+        return;
+    }
+    
+    // In BlockRate mode, all smoothing bands are designed together per segment
+    const bool segmentsDesigned = smoothingMode == SmoothingMode::BlockRate
+                                  && designSmoothingSegments(numSamples);
+    
+    // The band dynamics run on their own split afterwards, so the bands are a
+    // plain serial chain: run them in one pass
+    const bool useCascade = numChannels <= CascadeEngine::maxChannels
+                            && (!anySmoothing || segmentsDesigned);
+    
+    // A static chain may run in parallel form once its background design is ready
+    bool useParallel = false;
+    if (useCascade && !anySmoothing && !midSideMode && filterStructure == FilterStructure::Parallel
+        && designWorker) {
+        std::array<int, CascadeEngine::maxSections> ids;
+        std::array<BiquadFilter::Coefficients, CascadeEngine::maxSections> coefs;
+        const int numSections = getCascadeSections(ids, coefs);
+        
+        // Sections are told apart by the redesigns of their band
+        std::array<uint32_t, CascadeEngine::maxSections> revisions;
+        for (int k = 0; k < numSections; ++k) {
+            const auto band = static_cast<size_t>(ids[static_cast<size_t>(k)] / maxStages);
+            revisions[static_cast<size_t>(k)] = filters[band].getRevision();
+        }
+        
+        designWorker->request(ids.data(), revisions.data(), coefs.data(), numSections);
+        designWorker->fetch(latestDesign);
+        
+        useParallel = latestDesign.valid
+                      && latestDesign.matches(ids.data(), revisions.data(), numSections)
+                      && historyFill == historyLength;
+    }
+    
+    // Leaving the parallel form for the per-band filters: the cascade hands them its state
+    if (parallelActive && !useCascade) {
+        primeFilterStructure(false);
+        parallelActive = false;
+    }
+    
+    setCascadeActive(useCascade);
+    
+    const bool switchStructure = useCascade && useParallel != parallelActive;
+    if (switchStructure) {
+        primeFilterStructure(useParallel);
+    }
+    
+    recordHistory(buffer);
+    
+    if (useCascade) {
+        if (switchStructure) {
+            crossfadeFilterStructure(buffer, useParallel, anySmoothing);
+        } else if (parallelActive) {
+            processParallel(buffer);
+        } else {
+            processCascade(buffer, anySmoothing);
+        }
+        return;
+    }
+    
+    float* leftChannel = buffer.getWritePointer(0);
+    float* rightChannel = numChannels > 1 ? buffer.getWritePointer(1) : nullptr;
+    
+    // Process each enabled band in series
+    for (int band = 0; band < numBands; ++band) {
+        if (!bandEnabled[static_cast<size_t>(band)]) continue;
         
         auto& filter = filters[static_cast<size_t>(band)];
         auto& smoother = smoothers[static_cast<size_t>(band)];
         
-        // Get channel pointers for band buffer
-        float* leftChannel = bandBuffer.getWritePointer(0);
-        float* rightChannel = numChannels > 1 ? bandBuffer.getWritePointer(1) : nullptr;
-        
         // Check if we need per-sample parameter updates
-        const bool needsSmoothing = smoother.frequency.isSmoothing() ||
-                                     smoother.q.isSmoothing() ||
-                                     smoother.gain.isSmoothing();
+        const bool needsSmoothing = bandSmoothing[static_cast<size_t>(band)];
         
-        if (needsSmoothing) {
+        if (needsSmoothing && smoothingMode == SmoothingMode::BlockRate) {
+            // Design coefficients at control rate and ramp them linearly in between
+            for (int start = 0, segment = 0; start < numSamples;
+                 start += coefficientUpdateInterval, ++segment) {
+                const int count = std::min(coefficientUpdateInterval, numSamples - start);
+        
+                if (segmentsDesigned) {
+                    const auto index = static_cast<size_t>(segment * numBands + band);
+                    const auto& d = segmentDesigns[index];
+                    filter.setDesignedParameters(d.type, d.frequency, d.q, d.gainDb,
+                                                 segmentCoefficients.data() + index * maxStages);
+                } else {
+                    filter.setParameters(filter.getType(),
+                                         smoother.frequency.skip(count),
+                                         smoother.q.skip(count),
+                                         smoother.gain.skip(count) + getDynamicGainChange(segment, band));
+                }
+                
+                filter.processBlockRamped(leftChannel + start,
+                                          rightChannel ? rightChannel + start : nullptr,
+                                          count);
+            }
+        } else if (needsSmoothing) {
             // Per-sample processing with smoothing
             for (int i = 0; i < numSamples; ++i) {
-                // Update filter parameters with smoothed values
-                filter.setFrequency(smoother.frequency.getNextValue());
-                filter.setQ(smoother.q.getNextValue());
-                filter.setGain(smoother.gain.getNextValue());
+                // Update filter parameters with smoothed values (one design per sample)
+                filter.setParameters(filter.getType(),
+                                     smoother.frequency.getNextValue(),
+                                     smoother.q.getNextValue(),
+                                     smoother.gain.getNextValue()
+                                         + getDynamicGainChange(i / coefficientUpdateInterval, band));
                 
                 // Process sample
                 if (rightChannel) {
                     filter.processStereo(leftChannel[i], rightChannel[i]);
                 } else {
-                    leftChannel[i] = filter.getMagnitudeAtFrequency(leftChannel[i]);
+                    filter.processMono(leftChannel + i, 1);
                 }
             }
         } else {
-            // Block processing (faster)
+            // Block processing (faster, both channels in one SIMD loop)
             if (rightChannel) {
                 filter.processBlock(leftChannel, rightChannel, numSamples);
             } else {
                 // Mono - process left channel only
-                for (int i = 0; i < numSamples; ++i) {
-                    float sample = leftChannel[i];
-                    filter.processStereo(sample, sample);
-                    leftChannel[i] = sample;
+                filter.processMono(leftChannel, numSamples);
+            }
+        }
+    }
+}
+
+void EQProcessor::processDynamics(juce::AudioBuffer<float>& buffer) {
+    crossover.setPhase(crossoverPhase);
+    const int numDynamic = updateCrossovers();
+    
+    // Lane of each band that owns a crossover band; a band that starts
+    // compressing again starts from silence
+    std::array<bool, numBands> compressing {};
+    for (int band = 0; band < crossover.getNumBands(); ++band) {
+        const int owner = crossoverOwners[static_cast<size_t>(band)];
+        if (owner < 0) continue;
+        
+        const auto& dynamics = bandDynamics[static_cast<size_t>(owner)];
+        if (!bandCompressing[static_cast<size_t>(owner)]) {
+            multibandDynamics.resetBand(owner);
+        }
+        multibandDynamics.setBand(owner, dynamics.getThreshold(), dynamics.getRatio(), dynamics.getKnee(),
+                                  dynamics.getAttack(), dynamics.getRelease());
+        compressing[static_cast<size_t>(owner)] = true;
+    }
+    bandCompressing = compressing;
+    
+    std::array<float, numBands> reductions {};
+    
+    // Without band dynamics the minimum-phase split is only an allpass: skip it.
+    // The linear-phase split keeps running so the reported latency holds.
+    if (numDynamic > 0 || crossover.getPhase() == CrossoverFilterbank::Phase::LinearPhase) {
+        const int numChannels = std::min(buffer.getNumChannels(), CrossoverFilterbank::maxChannels);
+        const int numSamples = buffer.getNumSamples();
+        const int blockSize = crossover.getMaxBlockSize();
+        
+        for (int start = 0; start < numSamples; start += blockSize) {
+            const int count = std::min(blockSize, numSamples - start);
+            
+            float* channels[CrossoverFilterbank::maxChannels] = {
+                buffer.getWritePointer(0) + start,
+                numChannels > 1 ? buffer.getWritePointer(1) + start : nullptr
+            };
+            
+            crossover.split(channels, numChannels, count);
+            
+            // Each band's crossover band in its lane, compressed in one pass
+            float* left[MultibandDynamics::maxBands] = {};
+            float* right[MultibandDynamics::maxBands] = {};
+            
+            for (int band = 0; band < crossover.getNumBands(); ++band) {
+                const int owner = crossoverOwners[static_cast<size_t>(band)];
+                if (owner < 0) continue;
+                
+                left[owner] = crossover.getBand(band, 0);
+                right[owner] = numChannels > 1 ? crossover.getBand(band, 1) : nullptr;
+            }
+            
+            if (numDynamic > 0) {
+                multibandDynamics.process(left, right, count);
+                
+                // Lanes no band owns keep the gain of their last owner
+                for (int band = 0; band < numBands; ++band) {
+                    if (!compressing[static_cast<size_t>(band)]) continue;
+                    
+                    reductions[static_cast<size_t>(band)] = std::min(reductions[static_cast<size_t>(band)],
+                                                                     multibandDynamics.getGainReduction(band));
                 }
             }
+            
+            crossover.sum(channels, numChannels, count);
+        }
+    }
+    
+    if (!dynamicEQMode) {
+        for (int band = 0; band < numBands; ++band) {
+            bandGainReductions[static_cast<size_t>(band)].store(reductions[static_cast<size_t>(band)]);
         }
+    }
+}
+
+int EQProcessor::updateCrossovers() {
+    // Bands with dynamics by rising frequency
+    std::array<int, numBands> dynamicBands;
+    int numDynamic = 0;
+    
+    auto frequencyOf = [this](int band) { return filters[static_cast<size_t>(band)].getFrequency(); };
+    
+    for (int band = 0; band < numBands; ++band) {
+        // In Dynamic EQ mode the dynamics settings belong to the dynamic bands
+        const bool enabled = bandEnabled[static_cast<size_t>(band)] && !dynamicEQMode;
+        if (!enabled || !bandDynamics[static_cast<size_t>(band)].isEnabled()) continue;
         
-        // Apply per-band dynamics processing
-        auto& dynamics = bandDynamics[static_cast<size_t>(band)];
-        dynamics.updateFromParameters();
-        dynamics.process(bandBuffer);
+        int position = numDynamic++;
+        while (position > 0 && frequencyOf(dynamicBands[static_cast<size_t>(position - 1)]) > frequencyOf(band)) {
+            dynamicBands[static_cast<size_t>(position)] = dynamicBands[static_cast<size_t>(position - 1)];
+            --position;
+        }
+        dynamicBands[static_cast<size_t>(position)] = band;
+    }
+    
+    std::array<float, CrossoverFilterbank::maxCrossovers> edges;
+    int numEdges = 0;
+    crossoverOwners[0] = -1;
+    
+    const float maxEdge = static_cast<float>(0.45 * currentSampleRate);
+    
+    // Edges stay ascending and inside the audio range; a range squeezed out
+    // above the top edge joins the band below
+    auto addEdge = [&](float frequency, int owner) {
+        frequency = std::max(frequency, numEdges > 0 ? edges[static_cast<size_t>(numEdges - 1)] * 1.01f
+                                                     : Constants::minFrequency);
+        if (frequency >= maxEdge) return;
+        
+        edges[static_cast<size_t>(numEdges++)] = frequency;
+        crossoverOwners[static_cast<size_t>(numEdges)] = owner;
+    };
+    
+    const float infinity = std::numeric_limits<float>::infinity();
+    float previousFrequency = 0.0f;
+    float previousUpper = 0.0f;
+    
+    for (int i = 0; i < numDynamic; ++i) {
+        const int band = dynamicBands[static_cast<size_t>(i)];
+        const auto& filter = filters[static_cast<size_t>(band)];
+        const float frequency = filter.getFrequency();
+        
+        float lower = 0.0f;
+        float upper = infinity;
+        
+        switch (filter.getType()) {
+            case FilterType::LowShelf:
+            case FilterType::LowPass:
+                upper = frequency;
+                break;
+            case FilterType::HighShelf:
+            case FilterType::HighPass:
+                lower = frequency;
+                break;
+            case FilterType::Peak:
+            case FilterType::BandPass:
+            case FilterType::Notch:
+            case FilterType::AllPass: {
+                // Bandwidth in octaves between the -3 dB points of a band of this Q
+                const float octaves = 2.0f / std::log(2.0f) * std::asinh(0.5f / std::max(filter.getQ(), 0.01f));
+                lower = frequency * std::exp2(-0.5f * octaves);
+                upper = frequency * std::exp2(0.5f * octaves);
+                break;
+            }
+        }
+        
+        if (i == 0) {
+            if (lower > 0.0f) {
+                addEdge(lower, band);
+            } else {
+                crossoverOwners[0] = band;
+            }
+        } else if (lower > previousUpper * 1.01f) {
+            // The gap between the two ranges passes without dynamics
+            addEdge(previousUpper, -1);
+            addEdge(lower, band);
+        } else {
+            addEdge(std::sqrt(previousFrequency * frequency), band);
+        }
+        
+        previousFrequency = frequency;
+        previousUpper = upper;
+    }
+    
+    if (numDynamic > 0 && previousUpper < infinity) {
+        addEdge(previousUpper, -1);
+    }
+    
+    crossover.setCrossovers(edges.data(), numEdges);
+    return numDynamic;
+}
+
+void EQProcessor::processCascade(juce::AudioBuffer<float>& buffer, bool anySmoothing) {
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples = buffer.getNumSamples();
+    
+    float* channels[CascadeEngine::maxChannels] = {
+        buffer.getWritePointer(0),
+        numChannels > 1 ? buffer.getWritePointer(1) : nullptr
+    };
+    
+    std::array<int, CascadeEngine::maxSections> ids;
+    std::array<BiquadFilter::Coefficients, CascadeEngine::maxSections> coefs;
+    
+    if (!anySmoothing) {
+        const int numSections = getCascadeSections(ids, coefs);
+        cascade.setSections(ids.data(), coefs.data(), numSections);
+        cascade.process(channels, numChannels, numSamples);
+        return;
+    }
+    
+    // Ramp every band to its control-rate design: one row of section targets
+    // per segment, all run through the cascade in one pass
+    int numSections = 0;
+    for (int start = 0, segment = 0; start < numSamples; start += coefficientUpdateInterval, ++segment) {
+        auto* row = segmentSectionTargets.data() + segment * CascadeEngine::maxSections;
+        numSections = 0;
+        
+        for (int band = 0; band < numBands; ++band) {
+            if (!bandEnabled[static_cast<size_t>(band)]) continue;
+            
+            auto& filter = filters[static_cast<size_t>(band)];
+            
+            // Keep the band filter on the smoothed design (UI readback and path hand-over)
+            if (bandSmoothing[static_cast<size_t>(band)]) {
+                const auto index = static_cast<size_t>(segment * numBands + band);
+                const auto& d = segmentDesigns[index];
+                filter.setDesignedParameters(d.type, d.frequency, d.q, d.gainDb,
+                                             segmentCoefficients.data() + index * maxStages);
+            }
+            
+            for (int stage = 0; stage < filter.getNumStages(); ++stage) {
+                ids[static_cast<size_t>(numSections)] = band * maxStages + stage;
+                row[numSections] = filter.getStageCoefficients(stage);
+                ++numSections;
+            }
+        }
+    }
+    
+    // The rows are packed numSections wide, as the cascade reads them
+    const int numSegments = (numSamples + coefficientUpdateInterval - 1) / coefficientUpdateInterval;
+    for (int segment = 1; segment < numSegments; ++segment) {
+        std::copy_n(segmentSectionTargets.data() + segment * CascadeEngine::maxSections, numSections,
+                    segmentSectionTargets.data() + segment * numSections);
+    }
+    
+    const auto* lastRow = segmentSectionTargets.data() + (numSegments - 1) * numSections;
+    cascade.setSections(ids.data(), lastRow, numSections);
+    cascade.processRampedSegments(channels, numChannels, numSamples, segmentSectionTargets.data(),
+                                  coefficientUpdateInterval);
+}
+
+void EQProcessor::processStateVariable(juce::AudioBuffer<float>& buffer) {
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples = buffer.getNumSamples();
+    
+    float* leftChannel = buffer.getWritePointer(0);
+    float* rightChannel = numChannels > 1 ? buffer.getWritePointer(1) : nullptr;
+    
+    for (int band = 0; band < numBands; ++band) {
+        if (!bandEnabled[static_cast<size_t>(band)]) continue;
+        
+        auto& filter = filters[static_cast<size_t>(band)];
+        auto& svf = svfFilters[static_cast<size_t>(band)];
+        
+        // Steeper slopes than one section stay on the biquad cascade
+        const bool useSVF = filter.getNumStages() == 1;
+        
+        if (bandSmoothing[static_cast<size_t>(band)]) {
+            auto& smoother = smoothers[static_cast<size_t>(band)];
+            
+            for (int start = 0, segment = 0; start < numSamples;
+                 start += coefficientUpdateInterval, ++segment) {
+                const int count = std::min(coefficientUpdateInterval, numSamples - start);
+                const float freq = smoother.frequency.skip(count);
+                const float q = smoother.q.skip(count);
+                const float gain = smoother.gain.skip(count) + getDynamicGainChange(segment, band);
+                float* right = rightChannel ? rightChannel + start : nullptr;
+                
+                // Keep the biquad design in step (UI readback and engine switches)
+                filter.setParameters(filter.getType(), freq, q, gain);
+                
+                if (useSVF) {
+                    svf.setParameters(filter.getType(), freq, q, gain);
+                    svf.processBlockRamped(leftChannel + start, right, count);
+                } else {
+                    filter.processBlockRamped(leftChannel + start, right, count);
+                }
+            }
+        } else if (!useSVF) {
+            if (rightChannel) {
+                filter.processBlock(leftChannel, rightChannel, numSamples);
+            } else {
+                filter.processMono(leftChannel, numSamples);
+            }
+        } else {
+            // Type changes glide over the block as well
+            svf.setParameters(filter.getType(), filter.getFrequency(), filter.getQ(), filter.getGain());
+            svf.processBlockRamped(leftChannel, rightChannel, numSamples);
+        }
+    }
+}
+
+int EQProcessor::getCascadeSections(std::array<int, CascadeEngine::maxSections>& ids,
+                                    std::array<BiquadFilter::Coefficients, CascadeEngine::maxSections>& coefs) const {
+    int numSections = 0;
+    
+    for (int band = 0; band < numBands; ++band) {
+        if (!bandEnabled[static_cast<size_t>(band)]) continue;
+        
+        const auto& filter = filters[static_cast<size_t>(band)];
+        for (int stage = 0; stage < filter.getNumStages(); ++stage) {
+            ids[static_cast<size_t>(numSections)] = band * maxStages + stage;
+            coefs[static_cast<size_t>(numSections)] = filter.getStageCoefficients(stage);
+            ++numSections;
+        }
+    }
+    
+    return numSections;
+}
+
+void EQProcessor::processParallel(juce::AudioBuffer<float>& buffer) {
+    parallel.process(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), buffer.getNumSamples());
+}
+
+void EQProcessor::primeFilterStructure(bool toParallel) {
+    const int numChannels = std::min(primeBuffer.getNumChannels(), ParallelEngine::maxChannels);
+    
+    if (toParallel) {
+        parallel.setDesign(latestDesign);
+    } else {
+        // Start every section from rest on the coefficients the parallel form was made from
+        const auto& design = parallel.getDesign();
         
-        // Mix band output back into main buffer (additive mixing for multiband)
+        for (int band = 0; band < numBands; ++band) {
+            const auto& filter = filters[static_cast<size_t>(band)];
+            for (int stage = 0; stage < maxStages; ++stage) {
+                cascade.setSectionState(band * maxStages + stage, BiquadLaneState(),
+                                        filter.getStageCoefficients(stage));
+            }
+        }
+        for (int k = 0; k < design.numSources; ++k) {
+            cascade.setSectionState(design.sourceIds[static_cast<size_t>(k)], BiquadLaneState(),
+                                    design.sources[static_cast<size_t>(k)]);
+        }
+        cascade.setSections(design.sourceIds.data(), design.sources.data(), design.numSources);
+    }
+    
+    // Run the recent input through it; what is left of the start-up transient is faded over
+    const int length = copyHistory(numChannels);
+    if (length == 0) return;
+    
+    if (toParallel) {
+        parallel.process(primeBuffer.getArrayOfWritePointers(), numChannels, length);
+    } else {
+        cascade.process(primeBuffer.getArrayOfWritePointers(), numChannels, length);
+    }
+}
+
+void EQProcessor::crossfadeFilterStructure(juce::AudioBuffer<float>& buffer, bool toParallel, bool anySmoothing) {
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples = buffer.getNumSamples();
+    
+    // Larger blocks than prepared for switch directly (the new engine is primed)
+    const bool crossfade = numSamples <= fadeBuffer.getNumSamples()
+                           && numChannels <= fadeBuffer.getNumChannels();
+    
+    if (crossfade) {
         for (int ch = 0; ch < numChannels; ++ch) {
-            const float* bandData = bandBuffer.getReadPointer(ch);
-            float* mainData = buffer.getWritePointer(ch);
-            for (int i = 0; i < numSamples; ++i) {
-                mainData[i] += (bandData[i] - mainData[i]) * 0.5f; // Blend
+            fadeBuffer.copyFrom(ch, 0, buffer, ch, 0, numSamples);
+        }
+        
+        // Refers to fadeBuffer's memory (no allocation)
+        juce::AudioBuffer<float> outgoing(fadeBuffer.getArrayOfWritePointers(), numChannels, numSamples);
+        
+        if (toParallel) {
+            processCascade(outgoing, false);
+        } else {
+            processParallel(outgoing);
+        }
+    }
+    
+    if (toParallel) {
+        processParallel(buffer);
+    } else {
+        processCascade(buffer, anySmoothing);
+    }
+    
+    parallelActive = toParallel;
+    
+    if (!crossfade) return;
+    
+    const float step = 1.0f / static_cast<float>(numSamples);
+    
+    for (int ch = 0; ch < numChannels; ++ch) {
+        const float* from = fadeBuffer.getReadPointer(ch);
+        float* to = buffer.getWritePointer(ch);
+        
+        for (int i = 0; i < numSamples; ++i) {
+            const float fade = static_cast<float>(i + 1) * step;
+            to[i] = from[i] + (to[i] - from[i]) * fade;
+        }
+    }
+}
+
+void EQProcessor::recordHistory(const juce::AudioBuffer<float>& buffer) {
+    // Only needed while the parallel form can be used
+    if (filterStructure != FilterStructure::Parallel || midSideMode || history.getNumSamples() == 0) {
+        historyFill = 0;
+        return;
+    }
+    
+    const int numChannels = std::min(buffer.getNumChannels(), history.getNumChannels());
+    const int numSamples = std::min(buffer.getNumSamples(), historyLength);
+    const int offset = buffer.getNumSamples() - numSamples;
+    
+    // Write in up to two pieces around the end of the ring
+    const int first = std::min(numSamples, historyLength - historyWritePosition);
+    
+    for (int ch = 0; ch < numChannels; ++ch) {
+        history.copyFrom(ch, historyWritePosition, buffer, ch, offset, first);
+        if (numSamples > first) {
+            history.copyFrom(ch, 0, buffer, ch, offset + first, numSamples - first);
+        }
+    }
+    
+    historyWritePosition = (historyWritePosition + numSamples) % historyLength;
+    historyFill = std::min(historyFill + numSamples, historyLength);
+}
+
+int EQProcessor::copyHistory(int numChannels) {
+    const int length = historyFill;
+    const int start = (historyWritePosition - length + historyLength) % historyLength;
+    const int first = std::min(length, historyLength - start);
+    
+    for (int ch = 0; ch < numChannels; ++ch) {
+        primeBuffer.copyFrom(ch, 0, history, ch, start, first);
+        if (length > first) {
+            primeBuffer.copyFrom(ch, first, history, ch, 0, length - first);
+        }
+    }
+    
+    return length;
+}
+
+void EQProcessor::setCascadeActive(bool active) {
+    if (active == cascadeActive) return;
+    
+    for (int band = 0; band < numBands; ++band) {
+        auto& filter = filters[static_cast<size_t>(band)];
+        
+        for (int stage = 0; stage < maxStages; ++stage) {
+            const int id = band * maxStages + stage;
+            
+            if (active) {
+                cascade.setSectionState(id, filter.getStageState(stage), filter.getStageCoefficients(stage));
+            } else {
+                filter.setStageState(stage, cascade.getSectionState(id));
+            }
+        }
+    }
+    
+    cascadeActive = active;
+}
+
+void EQProcessor::clearAddedSections(int band, int previousNumStages) {
+    const auto& filter = filters[static_cast<size_t>(band)];
+    
+    // As BandFilter does for its own stages: no ramp from stale coefficients or state
+    for (int stage = previousNumStages; stage < filter.getNumStages(); ++stage) {
+        cascade.setSectionState(band * maxStages + stage, BiquadLaneState(), filter.getStageCoefficients(stage));
+    }
+}
+
+bool EQProcessor::designSmoothingSegments(int numSamples) {
+    const int numSegments = (numSamples + coefficientUpdateInterval - 1) / coefficientUpdateInterval;
+    if (numSegments > maxSegments) return false;
+    
+    std::array<int, numBands> orders;
+    for (int band = 0; band < numBands; ++band) {
+        orders[static_cast<size_t>(band)] = filters[static_cast<size_t>(band)].getOrder();
+    }
+    
+    for (int segment = 0; segment < numSegments; ++segment) {
+        const int count = std::min(coefficientUpdateInterval,
+                                   numSamples - segment * coefficientUpdateInterval);
+        BandDesign* designs = segmentDesigns.data() + segment * numBands;
+        
+        for (int band = 0; band < numBands; ++band) {
+            const auto& filter = filters[static_cast<size_t>(band)];
+            auto& d = designs[band];
+            d.type = filter.getType();
+            
+            if (bandSmoothing[static_cast<size_t>(band)]) {
+                auto& smoother = smoothers[static_cast<size_t>(band)];
+                d.frequency = smoother.frequency.skip(count);
+                d.q = smoother.q.skip(count);
+                d.gainDb = smoother.gain.skip(count) + getDynamicGainChange(segment, band);
+            } else {
+                d.frequency = filter.getFrequency();
+                d.q = filter.getQ();
+                d.gainDb = filter.getGain();
+            }
+        }
+        
+        // One batched pass for the whole EQ
+        CoefficientDesigner::designStages(designs, orders.data(),
+                                          segmentCoefficients.data() + segment * numBands * maxStages,
+                                          numBands, currentSampleRate);
+    }
+    
+    return true;
+}
+
+void EQProcessor::detectDynamicBands(const juce::AudioBuffer<float>& buffer) {
+    bool anyDynamic = false;
+    
+    for (int band = 0; band < numBands; ++band) {
+        const auto& dynamics = bandDynamics[static_cast<size_t>(band)];
+        const bool wasDynamic = bandDynamic[static_cast<size_t>(band)];
+        const bool dynamic = dynamicEQMode && bandEnabled[static_cast<size_t>(band)] && dynamics.isEnabled();
+        
+        bandDynamic[static_cast<size_t>(band)] = dynamic;
+        
+        if (!dynamic) {
+            // The band's design still carries the last gain change
+            if (wasDynamic) {
+                bandLeavingDynamic[static_cast<size_t>(band)] = true;
             }
+            
+            // Outside Dynamic EQ mode the band dynamics meter instead
+            if (dynamicEQMode) {
+                bandGainReductions[static_cast<size_t>(band)].store(0.0f);
+            }
+            continue;
+        }
+        
+        anyDynamic = true;
+        
+        if (!wasDynamic) {
+            sidechain.resetBand(band);
+        }
+        
+        const auto& smoother = smoothers[static_cast<size_t>(band)];
+        sidechain.setBand(band, filters[static_cast<size_t>(band)].getType(),
+                          smoother.frequency.getTargetValue(), smoother.q.getTargetValue());
+        sidechain.setDynamics(band, dynamics.getThreshold(), dynamics.getRatio(), dynamics.getKnee(),
+                              dynamics.getAttack(), dynamics.getRelease());
+    }
+    
+    if (!anyDynamic) return;
+    
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples = buffer.getNumSamples();
+    const float* left = buffer.getReadPointer(0);
+    const float* right = numChannels > 1 ? buffer.getReadPointer(1) : nullptr;
+    
+    // Each segment applies the change for the level detected before it
+    // (segments past the table share its last entry)
+    for (int start = 0, segment = 0; start < numSamples; start += coefficientUpdateInterval, ++segment) {
+        const int count = std::min(coefficientUpdateInterval, numSamples - start);
+        float* changes = segmentGainChanges.data() + std::min(segment, maxSegments - 1) * numBands;
+        
+        for (int band = 0; band < numBands; ++band) {
+            changes[band] = sidechain.getGainChange(band);
+        }
+        
+        sidechain.process(left + start, right != nullptr ? right + start : nullptr, count);
+    }
+    
+    for (int band = 0; band < numBands; ++band) {
+        if (bandDynamic[static_cast<size_t>(band)]) {
+            bandGainReductions[static_cast<size_t>(band)].store(sidechain.getGainChange(band));
         }
     }
 }
 
+float EQProcessor::getDynamicGainChange(int segment, int band) const {
+    if (!bandDynamic[static_cast<size_t>(band)]) return 0.0f;
+    
+    const int entry = std::min(segment, maxSegments - 1);
+    return segmentGainChanges[static_cast<size_t>(entry * numBands + band)];
+}
+
 void EQProcessor::setBandParameters(int bandIndex, FilterType type, float freq, float q, float gain, bool enabled) {
     if (bandIndex < 0 || bandIndex >= numBands) return;
     
@@ -183,7 +966,9 @@ void EQProcessor::setBandParameters(int bandIndex, FilterType type, float freq,
     auto& smoother = smoothers[static_cast<size_t>(bandIndex)];
     
     // Set filter type immediately (no smoothing)
+    const int previousNumStages = filter.getNumStages();
     filter.setType(type);
+    clearAddedSections(bandIndex, previousNumStages);
     
     // Set target values for smoothing
     smoother.frequency.setTargetValue(freq);
@@ -191,6 +976,25 @@ void EQProcessor::setBandParameters(int bandIndex, FilterType type, float freq,
     smoother.gain.setTargetValue(gain);
     
     bandEnabled[static_cast<size_t>(bandIndex)] = enabled;
+    
+    // The linear-phase FIR is designed from the targets, like the EQ curve
+    if (linearPhaseEQ) {
+        linearPhaseEQ->setBandParameters(bandIndex, type, freq, q, gain, enabled);
+    }
+}
+
+void EQProcessor::setBandSlope(int bandIndex, int order) {
+    if (bandIndex < 0 || bandIndex >= numBands) return;
+    
+    juce::ScopedLock sl(lock);
+    auto& filter = filters[static_cast<size_t>(bandIndex)];
+    const int previousNumStages = filter.getNumStages();
+    filter.setOrder(order);
+    clearAddedSections(bandIndex, previousNumStages);
+    
+    if (linearPhaseEQ) {
+        linearPhaseEQ->setBandOrder(bandIndex, order);
+    }
 }
 
 void EQProcessor::setBandEnabled(int bandIndex, bool enabled) {
@@ -198,6 +1002,13 @@ void EQProcessor::setBandEnabled(int bandIndex, bool enabled) {
     
     juce::ScopedLock sl(lock);
     bandEnabled[static_cast<size_t>(bandIndex)] = enabled;
+    
+    if (linearPhaseEQ) {
+        const auto& smoother = smoothers[static_cast<size_t>(bandIndex)];
+        linearPhaseEQ->setBandParameters(bandIndex, filters[static_cast<size_t>(bandIndex)].getType(),
+                                         smoother.frequency.getTargetValue(), smoother.q.getTargetValue(),
+                                         smoother.gain.getTargetValue(), enabled);
+    }
 }
 
 EQProcessor::BandParams EQProcessor::getBandParameters(int bandIndex) const {
@@ -213,7 +1024,8 @@ EQProcessor::BandParams EQProcessor::getBandParameters(int bandIndex) const {
             ptrs.frequency->load(),
             ptrs.q->load(),
             ptrs.gain->load(),
-            ptrs.enabled->load() > 0.5f
+            ptrs.enabled->load() > 0.5f,
+            ptrs.slope ? getSlopeOrder(static_cast<int>(ptrs.slope->load())) : 2
         };
     }
 
@@ -225,46 +1037,108 @@ EQProcessor::BandParams EQProcessor::getBandParameters(int bandIndex) const {
         filter.getFrequency(),
         filter.getQ(),
         filter.getGain(),
-        bandEnabled[static_cast<size_t>(bandIndex)]
+        bandEnabled[static_cast<size_t>(bandIndex)],
+        filter.getOrder()
     };
 }
 
 float EQProcessor::getMagnitudeAtFrequency(float frequency) const {
-    float totalMagnitude = 1.0f;
+    float magnitude = 1.0f;
+    getMagnitudeResponse(&frequency, &magnitude, 1);
+    return magnitude;
+}
+
+float EQProcessor::getBandMagnitudeAtFrequency(int bandIndex, float frequency) const {
+    float magnitude = 1.0f;
+    getBandMagnitudeResponse(bandIndex, &frequency, &magnitude, 1);
+    return magnitude;
+}
+
+int EQProcessor::getEnabledBandDesigns(std::array<BandDesign, Constants::numEQBands>& designs,
+                                       std::array<int, Constants::numEQBands>& orders) const {
+    int numEnabled = 0;
 
     for (int i = 0; i < numBands; ++i) {
         const auto& ptrs = paramPtrs[static_cast<size_t>(i)];
         if (ptrs.enabled && ptrs.enabled->load() > 0.5f) {
-            // Use static calculation from APVTS params (stable, no smoothing)
-            totalMagnitude *= BiquadFilter::calcMagnitudeFromParams(
+            orders[static_cast<size_t>(numEnabled)] = ptrs.slope
+                                                    ? getSlopeOrder(static_cast<int>(ptrs.slope->load()))
+                                                    : 2;
+            designs[static_cast<size_t>(numEnabled++)] = {
                 static_cast<FilterType>(static_cast<int>(ptrs.type->load())),
                 ptrs.frequency->load(),
                 ptrs.q->load(),
-                ptrs.gain->load(),
-                currentSampleRate,
-                frequency
-            );
+                ptrs.gain->load()
+            };
         }
     }
 
-    return totalMagnitude;
+    return numEnabled;
 }
 
-float EQProcessor::getBandMagnitudeAtFrequency(int bandIndex, float frequency) const {
-    if (bandIndex < 0 || bandIndex >= numBands) return 1.0f;
+void EQProcessor::getMagnitudeResponse(const float* frequencies, float* magnitudes, int numPoints) const {
+    std::array<BandDesign, numBands> designs;
+    std::array<int, numBands> orders;
+    std::array<BiquadFilter::Coefficients, numBands * maxStages> coefs;
 
-    const auto& ptrs = paramPtrs[static_cast<size_t>(bandIndex)];
-    if (!ptrs.enabled || ptrs.enabled->load() <= 0.5f) return 1.0f;
+    // Design all enabled bands once (stable APVTS values, no smoothing)
+    const int numEnabled = getEnabledBandDesigns(designs, orders);
+    CoefficientDesigner::designStages(designs.data(), orders.data(), coefs.data(), numEnabled, currentSampleRate);
 
-    // Use static calculation from APVTS params (stable, no smoothing)
-    return BiquadFilter::calcMagnitudeFromParams(
-        static_cast<FilterType>(static_cast<int>(ptrs.type->load())),
-        ptrs.frequency->load(),
-        ptrs.q->load(),
-        ptrs.gain->load(),
-        currentSampleRate,
-        frequency
-    );
+    std::array<int, numBands> numStages;
+    for (int band = 0; band < numEnabled; ++band) {
+        numStages[static_cast<size_t>(band)] = CoefficientDesigner::getNumStages(designs[static_cast<size_t>(band)].type,
+                                                                                 orders[static_cast<size_t>(band)]);
+    }
+    
+    for (int i = 0; i < numPoints; ++i) {
+        const double w = 2.0 * FastMath::pi * static_cast<double>(frequencies[i]) / currentSampleRate;
+        const double phi = CoefficientDesigner::getPhi(w);
+        
+        double magnitude = 1.0;
+        for (int band = 0; band < numEnabled; ++band) {
+            for (int stage = 0; stage < numStages[static_cast<size_t>(band)]; ++stage) {
+                magnitude *= CoefficientDesigner::getMagnitude(coefs[static_cast<size_t>(band * maxStages + stage)], phi);
+            }
+        }
+        
+        magnitudes[i] = static_cast<float>(magnitude);
+    }
+}
+
+void EQProcessor::getBandMagnitudeResponse(int bandIndex, const float* frequencies, float* magnitudes,
+                                           int numPoints) const {
+    const auto* ptrs = bandIndex >= 0 && bandIndex < numBands
+                     ? &paramPtrs[static_cast<size_t>(bandIndex)] : nullptr;
+    
+    if (ptrs == nullptr || !ptrs->enabled || ptrs->enabled->load() <= 0.5f) {
+        std::fill(magnitudes, magnitudes + numPoints, 1.0f);
+        return;
+    }
+    
+    const BandDesign design {
+        static_cast<FilterType>(static_cast<int>(ptrs->type->load())),
+        ptrs->frequency->load(),
+        ptrs->q->load(),
+        ptrs->gain->load()
+    };
+    const int order = ptrs->slope ? getSlopeOrder(static_cast<int>(ptrs->slope->load())) : 2;
+    
+    std::array<BiquadFilter::Coefficients, maxStages> coefs;
+    CoefficientDesigner::designStages(&design, &order, coefs.data(), 1, currentSampleRate);
+    const int numStages = CoefficientDesigner::getNumStages(design.type, order);
+    
+    for (int i = 0; i < numPoints; ++i) {
+        const double w = 2.0 * FastMath::pi * static_cast<double>(frequencies[i]) / currentSampleRate;
+        const double phi = CoefficientDesigner::getPhi(w);
+        
+        double magnitude = 1.0;
+        for (int stage = 0; stage < numStages; ++stage) {
+            magnitude *= CoefficientDesigner::getMagnitude(coefs[static_cast<size_t>(stage)], phi);
+        }
+        
+        magnitudes[i] = static_cast<float>(magnitude);
+    }
 }
 
 void EQProcessor::connectToParameters(juce::AudioProcessorValueTreeState& apvts) {
@@ -278,6 +1152,7 @@ void EQProcessor::connectToParameters(juce::AudioProcessorValueTreeState& apvts)
         ptrs.gain = apvts.getRawParameterValue(getBandParamID(i, bandGain));
         ptrs.type = apvts.getRawParameterValue(getBandParamID(i, bandType));
         ptrs.enabled = apvts.getRawParameterValue(getBandParamID(i, bandEnable));
+        ptrs.slope = apvts.getRawParameterValue(getBandParamID(i, bandSlope));
         
         // Connect per-band dynamics
         bandDynamics[static_cast<size_t>(i)].connectToParameters(apvts, i);
@@ -298,6 +1173,20 @@ void EQProcessor::updateFromParameters() {
                 ptrs.enabled->load() > 0.5f
             );
         }
+        
+        if (ptrs.slope) {
+            setBandSlope(i, getSlopeOrder(static_cast<int>(ptrs.slope->load())));
+        }
+    }
+    
+    // The FIR length follows the lowest enabled band, and the latency with it
+    if (linearPhaseEQ) {
+        const int length = getLinearPhaseImpulseLength();
+        if (length != linearPhaseImpulseLength) {
+            linearPhaseImpulseLength = length;
+            linearPhaseEQ->setImpulseLength(length);
+            latencyChanged.store(true);
+        }
     }
 }
 
@@ -305,36 +1194,65 @@ void EQProcessor::setMidSideMode(bool enabled) {
     midSideMode = enabled;
 }
 
+void EQProcessor::setSmoothingMode(SmoothingMode mode) {
+    smoothingMode = mode;
+}
+
+void EQProcessor::setFilterStructure(FilterStructure structure) {
+    filterStructure = structure;
+}
+
+void EQProcessor::setFilterEngine(FilterEngine engine) {
+    filterEngine = engine;
+}
+
 void EQProcessor::setLinearPhaseMode(bool enabled) {
     linearPhaseMode = enabled;
-    if (enabled && prepared) {
-        if (!linearPhaseEQ) {
-            linearPhaseEQ = std::make_unique<LinearPhaseEQ>();
-        }
-        linearPhaseEQ->prepare(currentSampleRate, 512);  // Default block size
+}
+
+void EQProcessor::setLinearPhaseLength(LinearPhaseEQ::LengthTier tier) {
+    linearPhaseLength.store(tier);
+    if (linearPhaseEQ) {
+        linearPhaseEQ->setImpulseLength(getLinearPhaseImpulseLength());
+    }
+}
+
+void EQProcessor::setFirPhase(LinearPhaseEQ::FirPhase phase, float mix) {
+    firPhase = phase;
+    firPhaseMix = mix;
+    if (linearPhaseEQ) {
+        linearPhaseEQ->setFirPhase(phase, mix);
     }
 }
 
+int EQProcessor::getLinearPhaseImpulseLength() const {
+    std::array<BandDesign, numBands> designs;
+    std::array<int, numBands> orders;
+    const int numEnabled = getEnabledBandDesigns(designs, orders);
+    
+    return FirDesigner::getImpulseLength(linearPhaseLength.load(), currentSampleRate, designs.data(), numEnabled);
+}
+
 void EQProcessor::setDynamicEQMode(bool enabled) {
     dynamicEQMode = enabled;
-    if (enabled && prepared) {
-        if (!dynamicEQ) {
-            dynamicEQ = std::make_unique<DynamicEQProcessor>();
-        }
-        dynamicEQ->prepare(currentSampleRate, 512);  // Default block size
-    }
+}
+
+void EQProcessor::setCrossoverPhase(CrossoverFilterbank::Phase phase) {
+    // Applied on the audio thread at the start of the next dynamics pass
+    crossoverPhase = phase;
 }
 
 float EQProcessor::getBandGainReduction(int bandIndex) const {
     if (bandIndex < 0 || bandIndex >= numBands) return 0.0f;
-    return bandDynamics[static_cast<size_t>(bandIndex)].getGainReduction();
+    return bandGainReductions[static_cast<size_t>(bandIndex)].load();
 }
 
 int EQProcessor::getLatency() const {
     if (linearPhaseMode && linearPhaseEQ) {
         return linearPhaseEQ->getLatency();
     }
-    return 0;
+    return crossoverPhase == CrossoverFilterbank::Phase::LinearPhase
+        ? CrossoverFilterbank::getLinearPhaseLatency(currentSampleRate) : 0;
 }
 
 } // namespace SeshEQ
@@ -1,14 +1,23 @@
 #pragma once
 
+#include "BandFilter.h"
 #include "BiquadFilter.h"
+#include "CascadeEngine.h"
+#include "CoefficientDesigner.h"
+#include "CrossoverFilterbank.h"
+#include "ParallelEngine.h"
+#include "StateVariableFilter.h"
 #include "LinearPhaseEQ.h"
 #include "DynamicEQ.h"
 #include "BandDynamics.h"
+#include "MultibandDynamics.h"
 #include "utils/MidSideProcessor.h"
 #include "utils/Parameters.h"
 #include "utils/SmoothValue.h"
 #include <array>
+#include <atomic>
 #include <memory>
+#include <vector>
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_core/juce_core.h>
 
@@ -22,7 +31,8 @@ namespace SeshEQ {
  */
 class EQProcessor {
 public:
-    EQProcessor() = default;
+    EQProcessor();
+    ~EQProcessor();
     
     /**
      * @brief Prepare the EQ for processing
@@ -36,6 +46,9 @@ public:
     
     /**
      * @brief Process a stereo audio buffer
+     * 
+     * Does not allocate: scratch storage is sized in prepare() for the
+     * (oversampled) block size, and the bands run in place.
      */
     void process(juce::AudioBuffer<float>& buffer);
     
@@ -52,15 +65,98 @@ public:
     void setLinearPhaseMode(bool enabled);
     
     /**
-     * @brief Get latency in samples (for linear phase mode)
+     * @brief Set the linear phase FIR length tier (default: Medium)
+     * 
+     * The length follows from the tier, the sample rate and the lowest enabled
+     * band; updateFromParameters() recomputes it as bands move or switch (see
+     * pollLatencyChange()).
+     */
+    void setLinearPhaseLength(LinearPhaseEQ::LengthTier tier);
+    
+    /**
+     * @brief Set the phase of the FIR mode (default: Linear)
+     * @param mix For Mixed: 0 = minimum phase to 1 = linear phase
+     */
+    void setFirPhase(LinearPhaseEQ::FirPhase phase, float mix);
+    
+    /**
+     * @brief How smoothed band parameters are turned into filter coefficients
+     */
+    enum class SmoothingMode {
+        PerSample,  // Redesign every sample (reference path)
+        BlockRate   // Redesign at control rate, ramp coefficients linearly in between
+    };
+    
+    /**
+     * @brief Set the parameter smoothing mode (default: BlockRate)
+     */
+    void setSmoothingMode(SmoothingMode mode);
+    
+    /**
+     * @brief How the bands are realized when they run as a static IIR chain
+     */
+    enum class FilterStructure {
+        Serial,   // Biquad cascade (reference path)
+        Parallel  // Partial-fraction sections summed in SIMD lanes, designed off the audio thread
+    };
+    
+    /**
+     * @brief Set the IIR filter structure (default: Serial)
+     * 
+     * The parallel form only replaces the cascade while no band is smoothing
+     * and Mid/Side mode is off; the cascade runs otherwise and whenever the
+     * background design is missing or out of date.
+     */
+    void setFilterStructure(FilterStructure structure);
+    
+    /**
+     * @brief Set the filter engine the bands run on (default: Biquad)
+     * 
+     * StateVariable runs every single-section band as a TPT state-variable filter
+     * that glides through smoothed parameters sample by sample (no cascade or
+     * parallel form); steeper slopes stay on biquads. Also applies to the
+     * Dynamic EQ bands.
+     */
+    void setFilterEngine(FilterEngine engine);
+    
+    /**
+     * @brief Set the crossover the band dynamics split the signal with (default: MinimumPhase)
+     * 
+     * LinearPhase adds CrossoverFilterbank::getLinearPhaseLatency() samples whenever
+     * the standard path runs, with or without band dynamics, so the latency
+     * does not change as dynamics are switched.
+     */
+    void setCrossoverPhase(CrossoverFilterbank::Phase phase);
+    
+    /**
+     * @brief Get latency in samples (linear phase EQ or linear-phase crossover)
+     *
+     * Counted at the rate passed to prepare(), which is the oversampled rate
+     * when the host runs the EQ oversampled.
      */
     int getLatency() const;
     
+    /**
+     * @brief Whether getLatency() changed during processing since the last call
+     *
+     * The FIR length follows the lowest enabled band, so moving or enabling a
+     * band can change the latency on the audio thread. Poll this from the
+     * message thread and report the new latency to the host.
+     */
+    bool pollLatencyChange() { return latencyChanged.exchange(false); }
+    
     /**
      * @brief Update parameters for a specific band
      */
     void setBandParameters(int bandIndex, FilterType type, float freq, float q, float gain, bool enabled);
     
+    /**
+     * @brief Set the slope of a band as filter order (6 dB/oct per order)
+     * 
+     * Applies to HighPass and LowPass bands (order 1 to 8); other types ignore it.
+     */
+    void setBandSlope(int bandIndex, int order);
+    
     /**
      * @brief Enable or disable a band
      */
@@ -75,6 +171,7 @@ public:
         float q;
         float gain;
         bool enabled;
+        int order = 2;
     };
     
     BandParams getBandParameters(int bandIndex) const;
@@ -91,6 +188,23 @@ public:
      */
     float getBandMagnitudeAtFrequency(int bandIndex, float frequency) const;
     
+    /**
+     * @brief Get the combined magnitude response at many frequencies
+     * 
+     * Designs every band once and evaluates all points from those coefficients,
+     * which is much cheaper than calling getMagnitudeAtFrequency per point.
+     * @param frequencies Frequencies in Hz
+     * @param magnitudes Output magnitudes in linear scale
+     * @param numPoints Number of frequencies
+     */
+    void getMagnitudeResponse(const float* frequencies, float* magnitudes, int numPoints) const;
+    
+    /**
+     * @brief Get the magnitude response of a single band at many frequencies
+     */
+    void getBandMagnitudeResponse(int bandIndex, const float* frequencies, float* magnitudes,
+                                  int numPoints) const;
+    
     /**
      * @brief Connect to APVTS for parameter automation
      */
@@ -103,12 +217,19 @@ public:
     
     /**
      * @brief Set Dynamic EQ mode
+     * 
+     * Bands with dynamics enabled then modulate their own gain from a
+     * band-limited detector on the EQ input, instead of compressing a
+     * crossover band. They stay in the same filter path as the static bands
+     * (cascade, Mid/Side and all), only designed at control rate.
      * @param enabled If true, enable dynamic EQ processing
      */
     void setDynamicEQMode(bool enabled);
     
     /**
      * @brief Get gain reduction for a specific band (for metering)
+     * 
+     * In Dynamic EQ mode, the cut of the band gain (positive dB).
      */
     float getBandGainReduction(int bandIndex) const;
     
@@ -118,11 +239,151 @@ private:
      */
     void processStandard(juce::AudioBuffer<float>& buffer);
     
+    /**
+     * @brief Run the enabled bands as filters (cascade, parallel form, SVF or per band)
+     */
+    void processBands(juce::AudioBuffer<float>& buffer);
+    
+    /**
+     * @brief Multiband dynamics: split the EQ output around the bands with
+     *        dynamics, compress all split bands in one pass and sum
+     */
+    void processDynamics(juce::AudioBuffer<float>& buffer);
+    
+    /**
+     * @brief Place the crossovers around the enabled bands with dynamics
+     * 
+     * Each such band owns the range its Q covers (from DC for low shelf and
+     * low pass, up to Nyquist for high shelf and high pass); overlapping
+     * ranges meet halfway between the band frequencies (in octaves), and the
+     * gaps between ranges pass without dynamics.
+     * @return Number of bands with dynamics
+     */
+    int updateCrossovers();
+    
+    /**
+     * @brief Run all enabled bands as one serial cascade
+     * @param anySmoothing Ramp to the per-segment designs of designSmoothingSegments
+     */
+    void processCascade(juce::AudioBuffer<float>& buffer, bool anySmoothing);
+    
+    /**
+     * @brief Switch between the cascade and the per-band filters, handing the
+     *        filter state over so the switch is seamless
+     */
+    void setCascadeActive(bool active);
+    
+    /**
+     * @brief Start the cascade sections a band gained (slope or type change) from rest
+     */
+    void clearAddedSections(int band, int previousNumStages);
+    
+    /**
+     * @brief Run all enabled bands on the state-variable filters
+     * 
+     * Smoothing bands take a new target every control-rate segment and
+     * interpolate their coefficients per sample in between.
+     */
+    void processStateVariable(juce::AudioBuffer<float>& buffer);
+    
+    /**
+     * @brief Collect the sections of all enabled bands as cascade sections
+     *        (ids = band * BandFilter::maxStages + stage)
+     * @return Number of sections
+     */
+    int getCascadeSections(std::array<int, CascadeEngine::maxSections>& ids,
+                           std::array<BiquadFilter::Coefficients, CascadeEngine::maxSections>& coefs) const;
+    
+    /**
+     * @brief Run the installed parallel design over the buffer
+     */
+    void processParallel(juce::AudioBuffer<float>& buffer);
+    
+    /**
+     * @brief Bring the engine that takes over up to speed on the recent input
+     * @param toParallel true when switching cascade -> parallel
+     */
+    void primeFilterStructure(bool toParallel);
+    
+    /**
+     * @brief Process a block with the new engine, crossfading from the old one
+     */
+    void crossfadeFilterStructure(juce::AudioBuffer<float>& buffer, bool toParallel, bool anySmoothing);
+    
+    /**
+     * @brief Append the block input to the history used for priming
+     */
+    void recordHistory(const juce::AudioBuffer<float>& buffer);
+    
+    /**
+     * @brief Copy the recorded history in time order into primeBuffer
+     * @return Number of samples copied
+     */
+    int copyHistory(int numChannels);
+    
+    /**
+     * @brief Advance the smoothers of all smoothing bands and design their
+     *        coefficients for every control-rate segment of the block
+     *        (dynamic bands include their gain change)
+     * @return false if the block has more segments than the tables hold
+     */
+    bool designSmoothingSegments(int numSamples);
+    
+    /**
+     * @brief Run the sidechain analysis over the block input and record each
+     *        dynamic band's gain change for every control-rate segment
+     */
+    void detectDynamicBands(const juce::AudioBuffer<float>& buffer);
+    
+    /**
+     * @brief Gain change of a band in a control-rate segment (0 for static bands)
+     */
+    float getDynamicGainChange(int segment, int band) const;
+    
+    /**
+     * @brief Collect the UI design and order of all bands from APVTS
+     * @return Number of enabled bands written to designs
+     */
+    int getEnabledBandDesigns(std::array<BandDesign, Constants::numEQBands>& designs,
+                              std::array<int, Constants::numEQBands>& orders) const;
+
 private:
     static constexpr int numBands = Constants::numEQBands;
     
-    // Stereo filters for each band
-    std::array<StereoBiquadFilter, numBands> filters;
+    // Samples between coefficient designs in BlockRate smoothing mode
+    static constexpr int coefficientUpdateInterval = 32;
+    
+    // Stereo filters for each band (one or more sections)
+    std::array<BandFilter, numBands> filters;
+    static constexpr int maxStages = BandFilter::maxStages;
+    static_assert(numBands * maxStages <= CascadeEngine::maxSections, "Cascade ids must fit every band section");
+    
+    // All bands in one pass when no band needs its output separately
+    CascadeEngine cascade;
+    bool cascadeActive = false;
+    
+    // State-variable engine (see setFilterEngine)
+    std::array<StateVariableFilter, numBands> svfFilters;
+    FilterEngine filterEngine = FilterEngine::Biquad;
+    FilterEngine activeEngine = FilterEngine::Biquad;  // Engine the last block ran on
+    
+    // Parallel form of the cascade (see setFilterStructure)
+    class ParallelDesignWorker;
+    std::unique_ptr<ParallelDesignWorker> designWorker;
+    ParallelEngine parallel;
+    ParallelDesign latestDesign;
+    FilterStructure filterStructure = FilterStructure::Serial;
+    bool parallelActive = false;
+    
+    // Recent input for priming an engine before it takes over
+    static constexpr int historyLength = 8192;
+    juce::AudioBuffer<float> history;
+    juce::AudioBuffer<float> primeBuffer;
+    int historyWritePosition = 0;
+    int historyFill = 0;
+    
+    // Output of the outgoing engine during a structure switch
+    juce::AudioBuffer<float> fadeBuffer;
     
     // Band enabled states
     std::array<bool, numBands> bandEnabled;
@@ -134,6 +395,18 @@ private:
         SmoothValue<float> gain { 0.0f };
     };
     std::array<BandSmoothers, numBands> smoothers;
+    SmoothingMode smoothingMode = SmoothingMode::BlockRate;
+    
+    // Bands whose parameters are smoothing in the current block (dynamic bands
+    // always are, and a band leaving dynamic mode for one more block)
+    std::array<bool, numBands> bandSmoothing {};
+    
+    // BlockRate designs of all bands per segment (segment-major, numBands per segment,
+    // maxStages coefficients per band)
+    std::vector<BandDesign> segmentDesigns;
+    std::vector<BiquadFilter::Coefficients> segmentCoefficients;
+    std::vector<BiquadFilter::Coefficients> segmentSectionTargets;  // [segment][cascade section]
+    int maxSegments = 0;
     
     // APVTS parameter pointers
     struct BandParamPtrs {
@@ -142,6 +415,7 @@ private:
         std::atomic<float>* gain = nullptr;
         std::atomic<float>* type = nullptr;
         std::atomic<float>* enabled = nullptr;
+        std::atomic<float>* slope = nullptr;
     };
     std::array<BandParamPtrs, numBands> paramPtrs;
     
@@ -156,18 +430,43 @@ private:
     bool linearPhaseMode = false;
     bool dynamicEQMode = false;
     
-    // Mid/Side buffers
-    juce::AudioBuffer<float> midBuffer;
-    juce::AudioBuffer<float> sideBuffer;
-    
     // Linear Phase EQ (for zero phase distortion)
     std::unique_ptr<LinearPhaseEQ> linearPhaseEQ;
+    std::atomic<LinearPhaseEQ::LengthTier> linearPhaseLength { LinearPhaseEQ::LengthTier::Medium };
+    int linearPhaseImpulseLength = 0;  // Last length set from the audio thread
+    std::atomic<bool> latencyChanged { false };
+    LinearPhaseEQ::FirPhase firPhase = LinearPhaseEQ::FirPhase::Linear;
+    float firPhaseMix = 0.5f;
     
-    // Dynamic EQ (for sidechain-responsive bands)
-    std::unique_ptr<DynamicEQProcessor> dynamicEQ;
+    /**
+     * @brief FIR length of the current tier for the lowest enabled band
+     */
+    int getLinearPhaseImpulseLength() const;
+    
+    // Dynamic EQ: one analysis pass for all bands whose gain follows the input
+    SidechainFilterbank sidechain;
+    static_assert(numBands <= SidechainFilterbank::maxBands, "Every band needs a sidechain lane");
+    std::array<bool, numBands> bandDynamic {};
+    std::array<bool, numBands> bandLeavingDynamic {};
     
-    // Per-band dynamics processors
+    // Gain change per segment (segment-major, numBands per segment)
+    std::vector<float> segmentGainChanges;
+    
+    // Per-band dynamics settings; the bands compress their own crossover band,
+    // each in its lane of the multiband kernel
     std::array<BandDynamics, numBands> bandDynamics;
+    MultibandDynamics multibandDynamics;
+    static_assert(numBands <= MultibandDynamics::maxBands, "Every band needs a dynamics lane");
+    std::array<bool, numBands> bandCompressing {};
+    
+    // Metering of the band dynamics, or of the dynamic bands in Dynamic EQ mode
+    std::array<std::atomic<float>, numBands> bandGainReductions {};
+    CrossoverFilterbank crossover;
+    CrossoverFilterbank::Phase crossoverPhase = CrossoverFilterbank::Phase::MinimumPhase;
+    static_assert(2 * numBands <= CrossoverFilterbank::maxCrossovers, "Every band needs up to two crossovers");
+    
+    // Band whose dynamics run on each crossover band (-1 = none)
+    std::array<int, CrossoverFilterbank::maxBands> crossoverOwners {};
 };
 
 } // namespace SeshEQ
@@ -0,0 +1,153 @@
+#include "FirDesigner.h"
+#include "utils/FastMath.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace SeshEQ {
+
+namespace FirDesigner {
+
+int getImpulseLength(LengthTier tier, double sampleRate, float lowestFrequency) {
+    constexpr std::array<double, 4> cycles = { 3.0, 6.0, 12.0, 24.0 };
+    constexpr std::array<double, 4> lengthsAt48k = { 2048.0, 8192.0, 16384.0, 32768.0 };
+    constexpr float lowestDesignFrequency = 20.0f;
+    
+    const auto t = static_cast<size_t>(tier);
+    const int cap = std::min(FastMath::nextPowerOfTwo(static_cast<int>(std::ceil(lengthsAt48k[t] * sampleRate / 48000.0))),
+                             maxImpulseLength + 1);
+    
+    // Power of two minus one: odd, and the next design grid size up
+    const double needed = cycles[t] * sampleRate / std::max(lowestFrequency, lowestDesignFrequency);
+    const int length = FastMath::nextPowerOfTwo(static_cast<int>(std::ceil(needed)));
+    return std::clamp(length, minImpulseLength + 1, cap) - 1;
+}
+
+int getImpulseLength(LengthTier tier, double sampleRate, const BandDesign* bands, int numEnabled) {
+    auto lowestFrequency = static_cast<float>(sampleRate / 2.0);
+    for (int band = 0; band < numEnabled; ++band) {
+        lowestFrequency = std::min(lowestFrequency, bands[band].frequency);
+    }
+    
+    return getImpulseLength(tier, sampleRate, lowestFrequency);
+}
+
+void getMagnitudes(const DesignRequest& request, const float* frequencies, float* magnitudes, int numPoints) {
+    constexpr int maxStages = CoefficientDesigner::maxStages;
+    std::array<BandDesign, numBands> designs;
+    std::array<int, numBands> orders;
+    std::array<int, numBands> numStages;
+    std::array<BiquadFilter::Coefficients, numBands * maxStages> coefs;
+    
+    int numEnabled = 0;
+    for (const auto& band : request.bands) {
+        if (!band.enabled) continue;
+        
+        designs[static_cast<size_t>(numEnabled)] = { band.type, band.frequency, band.q, band.gainDb };
+        orders[static_cast<size_t>(numEnabled)] = band.order;
+        numStages[static_cast<size_t>(numEnabled)] = CoefficientDesigner::getNumStages(band.type, band.order);
+        ++numEnabled;
+    }
+    
+    CoefficientDesigner::designStages(designs.data(), orders.data(), coefs.data(), numEnabled,
+                                      request.sampleRate);
+    
+    for (int i = 0; i < numPoints; ++i) {
+        const double w = 2.0 * FastMath::pi * static_cast<double>(frequencies[i]) / request.sampleRate;
+        const double phi = CoefficientDesigner::getPhi(w);
+        
+        double magnitude = 1.0;
+        for (int band = 0; band < numEnabled; ++band) {
+            for (int stage = 0; stage < numStages[static_cast<size_t>(band)]; ++stage) {
+                magnitude *= CoefficientDesigner::getMagnitude(coefs[static_cast<size_t>(band * maxStages + stage)], phi);
+            }
+        }
+        
+        magnitudes[i] = static_cast<float>(magnitude);
+    }
+}
+
+//==============================================================================
+// Workspace
+//==============================================================================
+
+void Workspace::design(const DesignRequest& request, float* taps) {
+    const int centre = (request.length - 1) / 2;
+    const bool linear = request.delay >= centre;
+    
+    // Frequency grid of at least twice the length keeps time aliasing out;
+    // the cepstrum decays slower, so the other phases take a finer one
+    const int fftSize = FastMath::nextPowerOfTwo(request.length + 1) * (linear ? 2 : 8);
+    const int numBins = fftSize / 2 + 1;
+    prepareTransform(fftSize);
+    
+    // Zero-phase target: the exact magnitude on the FFT grid, DC to Nyquist
+    const double binWidth = request.sampleRate / fftSize;
+    for (int k = 0; k < numBins; ++k) {
+        frequencies[static_cast<size_t>(k)] = static_cast<float>(k * binWidth);
+    }
+    getMagnitudes(request, frequencies.data(), magnitudes.data(), numBins);
+    
+    for (int k = 0; k < numBins; ++k) {
+        spectrum[static_cast<size_t>(k)] = { magnitudes[static_cast<size_t>(k)], 0.0f };
+    }
+    for (int k = numBins; k < fftSize; ++k) {
+        spectrum[static_cast<size_t>(k)] = spectrum[static_cast<size_t>(fftSize - k)];
+    }
+    
+    if (!linear) {
+        applyPartialMinimumPhase(fftSize, static_cast<double>(request.delay) / centre);
+    }
+    
+    // Real impulse response around t = 0 (the inverse is scaled by 1 / fftSize)
+    fft.perform(spectrum.data(), timeData.data(), true);
+    
+    // Shift the main lobe to the delay and taper with half Hann windows
+    // reaching zero one tap before the start and one past the end
+    // (a plain Hann window for linear phase)
+    const int delay = request.delay;
+    for (int n = 0; n < request.length; ++n) {
+        const int t = (n - delay + fftSize) % fftSize;
+        const double window = n < delay
+                            ? 0.5 - 0.5 * std::cos(FastMath::pi * (n + 1) / (delay + 1))
+                            : 0.5 + 0.5 * std::cos(FastMath::pi * (n - delay) / (request.length - delay));
+        taps[n] = static_cast<float>(window * timeData[static_cast<size_t>(t)].real());
+    }
+}
+
+void Workspace::applyPartialMinimumPhase(int fftSize, double linearShare) {
+    constexpr float magnitudeFloor = 1.0e-6f;  // -120 dB, keeps the log finite
+    
+    for (auto& bin : spectrum) {
+        bin = { std::log(std::max(bin.real(), magnitudeFloor)), 0.0f };
+    }
+    fft.perform(spectrum.data(), timeData.data(), true);
+    
+    const int half = fftSize / 2;
+    for (int n = 1; n < half; ++n) {
+        timeData[static_cast<size_t>(n)] *= 2.0f;
+    }
+    for (int n = half + 1; n < fftSize; ++n) {
+        timeData[static_cast<size_t>(n)] = {};
+    }
+    fft.perform(timeData.data(), spectrum.data(), false);
+    
+    const auto minimumShare = static_cast<float>(1.0 - linearShare);
+    for (auto& bin : spectrum) {
+        bin = std::polar(std::exp(bin.real()), minimumShare * bin.imag());
+    }
+}
+
+void Workspace::prepareTransform(int fftSize) {
+    if (fft.getSize() == fftSize) return;
+    
+    fft.prepare(fftSize);
+    frequencies.resize(static_cast<size_t>(fftSize / 2 + 1));
+    magnitudes.resize(static_cast<size_t>(fftSize / 2 + 1));
+    spectrum.resize(static_cast<size_t>(fftSize));
+    timeData.resize(static_cast<size_t>(fftSize));
+}
+
+} // namespace FirDesigner
+
+} // namespace SeshEQ
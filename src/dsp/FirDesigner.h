@@ -0,0 +1,122 @@
+#pragma once
+
+#include "CoefficientDesigner.h"
+#include "ComplexFFT.h"
+#include "utils/FastMath.h"
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace SeshEQ {
+
+/**
+ * @brief FIR design of the linear-phase EQ
+ *
+ * Kept free of JUCE (like CoefficientDesigner) so the design can be tested on
+ * its own. LinearPhaseEQ runs the designs on its worker thread; EQProcessor
+ * picks the length.
+ */
+namespace FirDesigner {
+    
+    /**
+     * @brief Resolution / latency trade-off of the FIR
+     */
+    enum class LengthTier {
+        Low,     // 3 cycles of the lowest band, up to 2047 taps at 48 kHz
+        Medium,  // 6 cycles, up to 8191 taps (default)
+        High,    // 12 cycles, up to 16383 taps
+        Max      // 24 cycles, up to 32767 taps
+    };
+    
+    // Odd lengths, so the group delay is a whole number of samples
+    constexpr int minImpulseLength = 127;
+    constexpr int maxImpulseLength = 65535;
+    constexpr int defaultImpulseLength = 2047;
+    
+    constexpr int numBands = 8;
+    
+    struct BandParams {
+        FilterType type = FilterType::Peak;
+        float frequency = 1000.0f;
+        float q = 0.707f;
+        float gainDb = 0.0f;
+        int order = 2;
+        bool enabled = false;
+        
+        // Bit-wise on the floats: any change needs a redesign
+        bool operator==(const BandParams& other) const {
+            return type == other.type && FastMath::bitsEqual(frequency, other.frequency)
+                   && FastMath::bitsEqual(q, other.q) && FastMath::bitsEqual(gainDb, other.gainDb)
+                   && order == other.order && enabled == other.enabled;
+        }
+    };
+    
+    // Everything the design depends on
+    struct DesignRequest {
+        std::array<BandParams, numBands> bands {};
+        double sampleRate = 44100.0;
+        int length = defaultImpulseLength;
+        int delay = (defaultImpulseLength - 1) / 2;  // Linear phase at (length - 1) / 2
+    };
+    
+    /**
+     * @brief FIR length of a tier for a sample rate and the lowest enabled band
+     * @param lowestFrequency Lowest enabled band frequency in Hz (Nyquist if none)
+     */
+    int getImpulseLength(LengthTier tier, double sampleRate, float lowestFrequency);
+    
+    /**
+     * @brief FIR length of a tier for the lowest of the enabled bands given
+     * @param bands Enabled bands only (none: the shortest length)
+     */
+    int getImpulseLength(LengthTier tier, double sampleRate, const BandDesign* bands, int numEnabled);
+    
+    /**
+     * @brief Delay of the main lobe for a linear-phase share (0 = minimum, 1 = linear)
+     */
+    inline int getDelay(int length, float linearShare) {
+        return static_cast<int>(std::lround(linearShare * static_cast<float>((length - 1) / 2)));
+    }
+    
+    /**
+     * @brief Combined magnitude of the enabled bands at each frequency
+     */
+    void getMagnitudes(const DesignRequest& request, const float* frequencies,
+                       float* magnitudes, int numPoints);
+    
+    /**
+     * @brief Transforms and buffers of the design (one per designing thread)
+     */
+    class Workspace {
+    public:
+        /**
+         * @brief Design an impulse response of request.length taps
+         *
+         * Frequency-samples the target magnitude, gives it the phase the delay
+         * asks for and windows the result around the delay. Allocates when the
+         * length grows.
+         */
+        void design(const DesignRequest& request, float* taps);
+    
+    private:
+        /**
+         * @brief Give the magnitude spectrum a share of its minimum phase
+         *
+         * Homomorphic design: the real cepstrum of the log magnitude, folded onto
+         * positive time, transforms to log|H| + j * (minimum phase). The phase is
+         * scaled by 1 - linearShare; the caller's shift adds the linear part.
+         */
+        void applyPartialMinimumPhase(int fftSize, double linearShare);
+        
+        void prepareTransform(int fftSize);
+        
+        ComplexFFT fft;
+        std::vector<float> frequencies;
+        std::vector<float> magnitudes;
+        std::vector<ComplexFFT::Complex> spectrum;
+        std::vector<ComplexFFT::Complex> timeData;
+    };
+
+} // namespace FirDesigner
+
+} // namespace SeshEQ
@@ -1,5 +1,6 @@
 #include "Gate.h"
 #include "utils/Parameters.h"
+#include "utils/FastMath.h"
 
 namespace SeshEQ {
 
@@ -83,108 +84,111 @@ void Gate::process(juce::AudioBuffer<float>& buffer) {
     
     if (numChannels < 1 || numSamples < 1) return;
     
-    float* leftChannel = buffer.getWritePointer(0);
-    float* rightChannel = numChannels > 1 ? buffer.getWritePointer(1) : nullptr;
+    const int numDetected = std::min(numChannels, 2);
+    float* channels[2] = {
+        buffer.getWritePointer(0),
+        numChannels > 1 ? buffer.getWritePointer(1) : nullptr
+    };
     
     // Calculate target gain based on range
     const float closedGain = dBUtils::dbToLinear(rangeDb);
-    float maxGainReduction = 0.0f;
+    const float thresholdLinear = dBUtils::dbToLinear(thresholdDb);
+    const float inverseRatio = 1.0f / ratio;
+    float minGain = 1.0f;
     
-    for (int i = 0; i < numSamples; ++i) {
-        // Get input level
-        float inputLevel;
-        if (rightChannel) {
-            inputLevel = levelDetector.processStereo(leftChannel[i], rightChannel[i]);
-        } else {
-            inputLevel = levelDetector.processSample(leftChannel[i]);
-        }
+    for (int start = 0; start < numSamples; start += chunkSize) {
+        const int count = std::min(chunkSize, numSamples - start);
+        float* leftChannel = channels[0] + start;
+        float* rightChannel = channels[1] != nullptr ? channels[1] + start : nullptr;
         
-        const float thresholdLinear = dBUtils::dbToLinear(thresholdDb);
+        // Input level of the whole chunk first
+        const float* detected[2] = { leftChannel, rightChannel };
+        levelDetector.processBlock(detected, numDetected, envelopeBuffer, count);
         
-        // Determine if we're above or below threshold
-        const bool aboveThreshold = inputLevel > thresholdLinear;
+        for (int i = 0; i < count; ++i) {
+            // Determine if we're above or below threshold
+            const bool aboveThreshold = envelopeBuffer[i] > thresholdLinear;
         
-        // State machine for gate
-        float targetGain = closedGain;
+            // State machine for gate
+            float targetGain = closedGain;
         
-        switch (state) {
-            case GateState::Closed:
-                if (aboveThreshold) {
-                    state = GateState::Attack;
-                }
-                targetGain = closedGain;
-                break;
+            switch (state) {
+                case GateState::Closed:
+                    if (aboveThreshold) {
+                        state = GateState::Attack;
+                    }
+                    targetGain = closedGain;
+                    break;
                 
-            case GateState::Attack:
-                targetGain = 1.0f;
-                if (currentGain >= 0.99f) {
-                    state = GateState::Open;
-                    currentGain = 1.0f;
-                }
-                if (!aboveThreshold) {
-                    state = GateState::Hold;
-                    holdCounter = holdSamples;
-                }
-                break;
+                case GateState::Attack:
+                    targetGain = 1.0f;
+                    if (currentGain >= 0.99f) {
+                        state = GateState::Open;
+                        currentGain = 1.0f;
+                    }
+                    if (!aboveThreshold) {
+                        state = GateState::Hold;
+                        holdCounter = holdSamples;
+                    }
+                    break;
                 
-            case GateState::Open:
-                targetGain = 1.0f;
-                if (!aboveThreshold) {
-                    state = GateState::Hold;
-                    holdCounter = holdSamples;
-                }
-                break;
+                case GateState::Open:
+                    targetGain = 1.0f;
+                    if (!aboveThreshold) {
+                        state = GateState::Hold;
+                        holdCounter = holdSamples;
+                    }
+                    break;
                 
-            case GateState::Hold:
-                targetGain = 1.0f;
-                if (aboveThreshold) {
-                    state = GateState::Open;
-                } else if (--holdCounter <= 0) {
-                    state = GateState::Release;
-                }
-                break;
+                case GateState::Hold:
+                    targetGain = 1.0f;
+                    if (aboveThreshold) {
+                        state = GateState::Open;
+                    } else if (--holdCounter <= 0) {
+                        state = GateState::Release;
+                    }
+                    break;
                 
-            case GateState::Release:
-                targetGain = closedGain;
-                if (aboveThreshold) {
-                    state = GateState::Attack;
-                } else if (currentGain <= closedGain + 0.001f) {
-                    state = GateState::Closed;
-                    currentGain = closedGain;
-                }
-                break;
-        }
+                case GateState::Release:
+                    targetGain = closedGain;
+                    if (aboveThreshold) {
+                        state = GateState::Attack;
+                    } else if (currentGain <= closedGain + 0.001f) {
+                        state = GateState::Closed;
+                        currentGain = closedGain;
+                    }
+                    break;
+            }
         
-        // Smooth gain changes
-        if (targetGain > currentGain) {
-            // Attack (opening)
-            currentGain = attackCoef * currentGain + (1.0f - attackCoef) * targetGain;
-        } else {
-            // Release (closing)
-            currentGain = releaseCoef * currentGain + (1.0f - releaseCoef) * targetGain;
-        }
+            // Smooth gain changes
+            if (targetGain > currentGain) {
+                // Attack (opening)
+                currentGain = attackCoef * currentGain + (1.0f - attackCoef) * targetGain;
+            } else {
+                // Release (closing)
+                currentGain = releaseCoef * currentGain + (1.0f - releaseCoef) * targetGain;
+            }
         
-        // Apply expansion ratio for soft gate behavior
-        float finalGain = currentGain;
-        if (ratio < 100.0f && currentGain < 1.0f) {
-            // Apply expansion ratio
-            const float expansionDb = dBUtils::linearToDb(currentGain);
-            const float expandedDb = expansionDb / ratio;
-            finalGain = std::max(closedGain, dBUtils::dbToLinear(expandedDb));
-        }
+            // Apply expansion ratio for soft gate behavior
+            float finalGain = currentGain;
+            if (ratio < 100.0f && currentGain < 1.0f) {
+                // Apply expansion ratio: the gain in dB divided by the ratio
+                const float expandedDb = FastMath::gainToDb(currentGain) * inverseRatio;
+                finalGain = std::max(closedGain, FastMath::dbToGain(expandedDb));
+            }
         
-        // Track gain reduction
-        const float gr = dBUtils::linearToDb(finalGain);
-        maxGainReduction = std::min(maxGainReduction, gr);
+            // Track gain reduction (converted to dB once per block)
+            minGain = std::min(minGain, finalGain);
         
-        // Apply gain
-        leftChannel[i] *= finalGain;
-        if (rightChannel) {
-            rightChannel[i] *= finalGain;
+            // Apply gain
+            leftChannel[i] *= finalGain;
+            if (rightChannel) {
+                rightChannel[i] *= finalGain;
+            }
         }
     }
     
-    gainReductionDb.store(maxGainReduction);
+    gainReductionDb.store(dBUtils::linearToDb(minGain));
 }
 
 void Gate::connectToParameters(juce::AudioProcessorValueTreeState& apvts) {
@@ -54,6 +54,10 @@ private:
     
     LevelDetector levelDetector;
     
+    // Envelope of the current chunk of samples
+    static constexpr int chunkSize = 64;
+    float envelopeBuffer[chunkSize] = {};
+    
     // Parameters
     float thresholdDb = -40.0f;
     float ratio = 10.0f;
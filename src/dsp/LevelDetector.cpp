@@ -1,10 +1,91 @@
 #include "LevelDetector.h"
+#include "utils/SIMDSupport.h"
 
 namespace SeshEQ {
 
+namespace {
+
+// Largest magnitude across the channels, optionally squared (for RMS)
+void rectifyScalar(const float* const* channels, int numChannels, float* out, int numSamples, bool square) {
+    for (int i = 0; i < numSamples; ++i) {
+        float level = 0.0f;
+        for (int ch = 0; ch < numChannels; ++ch) {
+            level = std::max(level, std::abs(channels[ch][i]));
+        }
+        out[i] = square ? level * level : level;
+    }
+}
+
+#if SESHEQ_SIMD_X86
+void rectifySSE2(const float* const* channels, int numChannels, float* out, int numSamples, bool square) {
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    int i = 0;
+    
+    for (; i + 4 <= numSamples; i += 4) {
+        __m128 level = _mm_setzero_ps();
+        for (int ch = 0; ch < numChannels; ++ch) {
+            level = _mm_max_ps(level, _mm_andnot_ps(signMask, _mm_loadu_ps(channels[ch] + i)));
+        }
+        _mm_storeu_ps(out + i, square ? _mm_mul_ps(level, level) : level);
+    }
+    
+    const float* tail[2] = { channels[0] + i, numChannels > 1 ? channels[1] + i : nullptr };
+    rectifyScalar(tail, std::min(numChannels, 2), out + i, numSamples - i, square);
+}
+
+SESHEQ_TARGET_AVX
+void rectifyAVX(const float* const* channels, int numChannels, float* out, int numSamples, bool square) {
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    int i = 0;
+    
+    for (; i + 8 <= numSamples; i += 8) {
+        __m256 level = _mm256_setzero_ps();
+        for (int ch = 0; ch < numChannels; ++ch) {
+            level = _mm256_max_ps(level, _mm256_andnot_ps(signMask, _mm256_loadu_ps(channels[ch] + i)));
+        }
+        _mm256_storeu_ps(out + i, square ? _mm256_mul_ps(level, level) : level);
+    }
+    
+    const float* tail[2] = { channels[0] + i, numChannels > 1 ? channels[1] + i : nullptr };
+    rectifyScalar(tail, std::min(numChannels, 2), out + i, numSamples - i, square);
+}
+#endif
+
+#if SESHEQ_SIMD_NEON
+void rectifyNEON(const float* const* channels, int numChannels, float* out, int numSamples, bool square) {
+    int i = 0;
+    
+    for (; i + 4 <= numSamples; i += 4) {
+        float32x4_t level = vdupq_n_f32(0.0f);
+        for (int ch = 0; ch < numChannels; ++ch) {
+            level = vmaxq_f32(level, vabsq_f32(vld1q_f32(channels[ch] + i)));
+        }
+        vst1q_f32(out + i, square ? vmulq_f32(level, level) : level);
+    }
+    
+    const float* tail[2] = { channels[0] + i, numChannels > 1 ? channels[1] + i : nullptr };
+    rectifyScalar(tail, std::min(numChannels, 2), out + i, numSamples - i, square);
+}
+#endif
+
+using RectifyFn = void (*)(const float* const*, int, float*, int, bool);
+
+RectifyFn selectRectify() {
+#if SESHEQ_SIMD_X86
+    return SIMD::getCapabilities().avx ? &rectifyAVX : &rectifySSE2;
+#elif SESHEQ_SIMD_NEON
+    return &rectifyNEON;
+#else
+    return &rectifyScalar;
+#endif
+}
+
+} // namespace
+
 void LevelDetector::prepare(double newSampleRate) {
     sampleRate = newSampleRate;
     rmsWindowSamples = static_cast<int>((rmsWindowMs / 1000.0) * sampleRate);
+    rmsCoef = static_cast<float>(std::exp(-1.0 / rmsWindowSamples));
     reset();
     updateCoefficients();
 }
@@ -13,6 +94,7 @@ void LevelDetector::reset() {
     envelope = 0.0f;
     rmsSum = 0.0f;
     rmsSampleCount = 0;
+    truePeak.reset();
 }
 
 void LevelDetector::setAttackTime(float ms) {
@@ -64,18 +146,16 @@ float LevelDetector::processSample(float input) {
             const float squared = input * input;
             
             // Simple exponential moving average of squared signal
-            const float rmsCoef = static_cast<float>(std::exp(-1.0 / rmsWindowSamples));
             rmsSum = rmsCoef * rmsSum + (1.0f - rmsCoef) * squared;
             level = std::sqrt(rmsSum);
             break;
         }
             
-        case DetectionMode::TruePeak:
-            // Simplified true peak (in reality would use oversampling)
-            // For now, use peak detection with some interpolation estimation
-            level = std::abs(input);
-            // Could add oversampled peak detection here
+        case DetectionMode::TruePeak: {
+            const float* channel = &input;
+            level = truePeak.process(&channel, 1, nullptr, 1);
             break;
+        }
     }
     
     // Apply attack/release envelope
@@ -96,9 +176,11 @@ float LevelDetector::processStereo(float left, float right) {
     
     float level = maxInput;
     
-    if (mode == DetectionMode::RMS) {
+    if (mode == DetectionMode::TruePeak) {
+        const float* channels[2] = { &left, &right };
+        level = truePeak.process(channels, 2, nullptr, 1);
+    } else if (mode == DetectionMode::RMS) {
         const float squared = maxInput * maxInput;
-        const float rmsCoef = static_cast<float>(std::exp(-1.0 / rmsWindowSamples));
         rmsSum = rmsCoef * rmsSum + (1.0f - rmsCoef) * squared;
         level = std::sqrt(rmsSum);
     }
@@ -113,8 +195,110 @@ float LevelDetector::processStereo(float left, float right) {
     return envelope;
 }
 
+void LevelDetector::processBlock(const float* const* channels, int numChannels, float* envelopeOut,
+                                 int numSamples) {
+    if (numChannels < 1 || numSamples < 1) return;
+    
+    // Stereo at most, as processStereo
+    numChannels = std::min(numChannels, 2);
+    
+    static const RectifyFn rectify = selectRectify();
+    const bool rms = mode == DetectionMode::RMS;
+    
+    if (mode == DetectionMode::TruePeak) {
+        truePeak.process(channels, numChannels, envelopeOut, numSamples);
+    } else {
+        rectify(channels, numChannels, envelopeOut, numSamples, rms);
+    }
+    
+    if (rms) {
+        float sum = rmsSum;
+        for (int i = 0; i < numSamples; ++i) {
+            sum = rmsCoef * sum + (1.0f - rmsCoef) * envelopeOut[i];
+            envelopeOut[i] = sum;
+        }
+        rmsSum = sum;
+        
+        for (int i = 0; i < numSamples; ++i) {
+            envelopeOut[i] = std::sqrt(envelopeOut[i]);
+        }
+    }
+    
+    // Attack/release envelope: the comparison selects the coefficient
+    float env = envelope;
+    for (int i = 0; i < numSamples; ++i) {
+        const float level = envelopeOut[i];
+        const float coef = level > env ? attackCoef : releaseCoef;
+        env = coef * env + (1.0f - coef) * level;
+        envelopeOut[i] = env;
+    }
+    envelope = env;
+}
+
 float LevelDetector::getCurrentLevelDb() const {
     return dBUtils::linearToDb(envelope);
 }
 
+//==============================================================================
+// DynamicsCurve
+//==============================================================================
+
+namespace DynamicsCurve {
+
+float computeGain(float inputDb, float thresholdDb, float ratio, float kneeDb) {
+    // Soft knee dynamics curve
+    // Supports both compression (ratio > 1) and expansion (ratio < 1)
+    // Based on: https://www.musicdsp.org/en/latest/Effects/169-compressor.html
+    
+    const float halfKnee = kneeDb / 2.0f;
+    const float kneeStart = thresholdDb - halfKnee;
+    const float kneeEnd = thresholdDb + halfKnee;
+    
+    float outputDb;
+    
+    if (ratio >= 1.0f) {
+        // COMPRESSION MODE (ratio >= 1.0)
+        // Reduce gain for signals above threshold
+        if (inputDb < kneeStart) {
+            // Below knee - no compression
+            outputDb = inputDb;
+        } else if (inputDb > kneeEnd) {
+            // Above knee - full compression
+            outputDb = thresholdDb + (inputDb - thresholdDb) / ratio;
+        } else {
+            // In knee region - smooth transition
+            const float kneeInput = inputDb - kneeStart;
+            const float kneeRange = kneeDb;
+            const float compressionRatio = 1.0f + (ratio - 1.0f) * (kneeInput / kneeRange);
+            outputDb = kneeStart + kneeInput / compressionRatio;
+        }
+    } else {
+        // EXPANSION MODE (ratio < 1.0)
+        // Reduce gain for signals BELOW threshold (downward expansion)
+        // This creates a gate-like effect with smooth transition
+        if (inputDb > kneeEnd) {
+            // Above knee - no expansion (pass through)
+            outputDb = inputDb;
+        } else if (inputDb < kneeStart) {
+            // Below knee - full expansion
+            // For expansion, we attenuate signals below threshold
+            // The expansion ratio inverts: ratio 0.5 means 2:1 expansion
+            const float expansionRatio = 1.0f / ratio;
+            outputDb = thresholdDb - (thresholdDb - inputDb) * expansionRatio;
+        } else {
+            // In knee region - smooth transition
+            const float kneeInput = kneeEnd - inputDb;
+            const float kneeRange = kneeDb;
+            const float t = kneeInput / kneeRange; // 0 at kneeEnd, 1 at kneeStart
+            const float expansionRatio = 1.0f + (1.0f / ratio - 1.0f) * t;
+            outputDb = inputDb - (thresholdDb - inputDb) * (expansionRatio - 1.0f) * t;
+        }
+    }
+    
+    // Return gain change (negative for reduction, positive for boost)
+    return outputDb - inputDb;
+}
+
+} // namespace DynamicsCurve
+
 } // namespace SeshEQ
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "TruePeakDetector.h"
 #include <cmath>
 #include <algorithm>
 
@@ -11,13 +12,20 @@ namespace SeshEQ {
 enum class DetectionMode {
     Peak,       // Instantaneous peak level
     RMS,        // Root Mean Square level
-    TruePeak    // Oversampled peak (simplified)
+    TruePeak    // Inter-sample peak per ITU-R BS.1770 (trails the input by TruePeakDetector::latency)
 };
 
 /**
  * @brief Envelope follower with attack/release ballistics
  * 
  * Used for compressor/gate level detection. Operates in linear domain.
+ * 
+ * processBlock() works in passes over the block: the rectification (largest
+ * magnitude across the channels, squared for RMS) runs on SSE2/AVX/NEON
+ * vectors; the RMS average and the attack/release envelope are recursive,
+ * so they run sample by sample with branch-free coefficient selection.
+ * TruePeak mode takes its levels from the 4x interpolated signal of a
+ * TruePeakDetector instead.
  */
 class LevelDetector {
 public:
@@ -60,6 +68,13 @@ public:
      */
     float processStereo(float left, float right);
     
+    /**
+     * @brief Process a block and write the envelope of every sample
+     * @param channels Input channels (the level is their largest magnitude)
+     * @param envelopeOut numSamples envelope levels (linear)
+     */
+    void processBlock(const float* const* channels, int numChannels, float* envelopeOut, int numSamples);
+    
     /**
      * @brief Get current envelope level without processing
      */
@@ -84,8 +99,12 @@ private:
     
     DetectionMode mode = DetectionMode::Peak;
     
+    // True-peak interpolation
+    TruePeakDetector truePeak;
+    
     // RMS calculation
     float rmsSum = 0.0f;
+    float rmsCoef = 0.0f;
     int rmsWindowSamples = 0;
     int rmsSampleCount = 0;
     static constexpr float rmsWindowMs = 50.0f;
@@ -112,4 +131,18 @@ namespace dBUtils {
     }
 }
 
+/**
+ * @brief Static gain curve of the dynamics processors (soft knee)
+ */
+namespace DynamicsCurve {
+    /**
+     * @brief Gain change for an input level
+     *
+     * Ratios of 1 and above compress above the threshold; ratios below 1
+     * expand downwards below it. The knee spans kneeDb around the threshold.
+     * @return Gain change in dB (negative for reduction)
+     */
+    float computeGain(float inputDb, float thresholdDb, float ratio, float kneeDb);
+}
+
 } // namespace SeshEQ
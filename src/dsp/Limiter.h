@@ -1,25 +1,34 @@
 #pragma once
 
 #include "LevelDetector.h"
+#include "TruePeakLimiter.h"
 #include <juce_audio_processors/juce_audio_processors.h>
-#include <juce_dsp/juce_dsp.h>
 #include <atomic>
-#include <memory>
 
 namespace SeshEQ {
 
 /**
- * @brief True Peak Limiter with oversampling
+ * @brief Lookahead True Peak Limiter
  * 
  * Features:
- * - True Peak detection (inter-sample peak detection)
- * - Up to 8x oversampling for accurate peak detection
+ * - True Peak detection (ITU-R BS.1770 inter-sample peaks) on the sidechain
+ * - Lookahead: the audio is delayed so the gain is already down when a peak arrives
  * - Adjustable threshold and ceiling
  * - Auto release
- * - Gain reduction and True Peak metering
+ * - Gain reduction metering
+ *
+ * The signal path is a TruePeakLimiter: the gain ramps down over the
+ * lookahead and reaches the held gain exactly when the peak leaves the delay
+ * line, so limiting needs no hard clipping or oversampling. This class adds
+ * the parameters, thread-safe lookahead and enable, and metering.
+ *
+ * Up to two channels; all storage is allocated in prepare().
  */
 class Limiter {
 public:
+    static constexpr int maxChannels = TruePeakDetector::maxChannels;
+    static constexpr float maxLookaheadMs = 10.0f;
+    
     Limiter() = default;
     ~Limiter();
     
@@ -30,8 +39,8 @@ public:
     void setThreshold(float dB);
     void setCeiling(float dB);
     void setRelease(float ms);
-    void setEnabled(bool enabled);
-    void setOversamplingFactor(int factor); // 1, 2, 4, or 8
+    void setEnabled(bool enabled);   // Any thread
+    void setLookahead(float ms);     // Any thread; 0 to maxLookaheadMs
     
     // Process audio
     void process(juce::AudioBuffer<float>& buffer);
@@ -39,50 +48,41 @@ public:
     // Get current gain reduction for metering
     float getGainReduction() const { return gainReductionDb.load(); }
     
-    // Get True Peak level for metering
-    float getTruePeak() const { return truePeakDb.load(); }
-    
     // Connect to APVTS
     void connectToParameters(juce::AudioProcessorValueTreeState& apvts);
     void updateFromParameters();
     
-    bool isEnabled() const { return enabled; }
+    bool isEnabled() const { return enabled.load(); }
     
-    // Get latency in samples (for oversampling)
+    // Get latency in samples (lookahead plus true peak detection; 0 when disabled).
+    // Follows setEnabled() and setLookahead() at once.
     int getLatency() const;
     
 private:
-    // True Peak detection using oversampling
-    float detectTruePeak(const float* samples, int numSamples, int numChannels);
-    
     // Parameters
     float thresholdDb = -3.0f;
     float ceilingDb = -0.3f;
     float releaseMs = 100.0f;
-    bool enabled = false;
-    int oversamplingFactor = 4; // Default 4x oversampling
+    std::atomic<bool> enabled { false };
+    std::atomic<float> lookaheadMs { 1.5f };
     
     // State
     std::atomic<float> gainReductionDb { 0.0f };
-    std::atomic<float> truePeakDb { -100.0f };
-    float currentGain = 1.0f;
     double sampleRate = 44100.0;
-    int maxBlockSize = 512;
-    
-    // Release coefficient
-    float releaseCoef = 0.0f;
+    bool running = false;
+    int maxLookaheadSamples = 0;
     
-    // Oversampling
-    std::unique_ptr<juce::dsp::Oversampling<float>> oversampler;
+    TruePeakLimiter limiter;
     
+    int getLookaheadSamples() const;
     void updateCoefficients();
-    void updateOversampling();
     
     // APVTS parameter pointers
     std::atomic<float>* thresholdParam = nullptr;
     std::atomic<float>* ceilingParam = nullptr;
     std::atomic<float>* releaseParam = nullptr;
     std::atomic<float>* enabledParam = nullptr;
+    std::atomic<float>* lookaheadParam = nullptr;
 };
 
 } // namespace SeshEQ
@@ -1,164 +1,239 @@
 #include "LinearPhaseEQ.h"
-#include <juce_dsp/juce_dsp.h>
+#include "utils/LockFreeExchange.h"
 #include <algorithm>
-#include <cmath>
-
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
 
 namespace SeshEQ {
 
-LinearPhaseEQ::LinearPhaseEQ()
-    : fft(static_cast<int>(std::log2(fftSize))) {
-    frequencyResponse.resize(fftSize);
-    impulseResponse.resize(fftSize);
-}
+//==============================================================================
+// Background FIR design
+//==============================================================================
+
+/**
+ * @brief Designs impulse responses on its own thread
+ *
+ * The audio thread posts the current band parameters and picks finished
+ * impulse responses up through lock-free exchanges, so a parameter change
+ * never stalls the callback on the transforms.
+ */
+class LinearPhaseEQ::DesignWorker : public juce::Thread {
+public:
+    struct Design {
+        std::vector<float> taps;
+        int length = 0;
+        int delay = 0;
+    };
+    
+    DesignWorker() : juce::Thread("SeshEQ Linear Phase Design") {}
+    
+    ~DesignWorker() override {
+        stopThread(1000);
+    }
+    
+    /**
+     * @brief Ask for a design of these parameters (audio thread)
+     *
+     * Lock-free only: the thread polls for requests rather than being woken,
+     * since notify() signals a WaitableEvent under a lock.
+     */
+    void request(const DesignRequest& params) {
+        requests.getWriteBuffer() = params;
+        requests.publish();
+    }
+    
+    /**
+     * @brief Pick up the latest finished design (audio thread)
+     * @return nullptr if nothing new was designed
+     */
+    const Design* fetch() {
+        if (!results.update()) return nullptr;
+        
+        return &results.getReadBuffer();
+    }
+    
+    /**
+     * @brief Drop pending requests and results (only while the thread is stopped)
+     */
+    void flush() {
+        requests.update();
+        results.update();
+    }
+    
+    /**
+     * @brief Design an impulse response of params.length taps on the calling thread
+     *
+     * Only one thread may design at a time: run() while the thread runs,
+     * otherwise the owner. Allocates when the length grows.
+     */
+    void design(const DesignRequest& params, float* taps) {
+        workspace.design(params, taps);
+    }
+    
+    void run() override {
+        while (!threadShouldExit()) {
+            if (requests.update()) {
+                const auto& params = requests.getReadBuffer();
+                auto& result = results.getWriteBuffer();
+                result.taps.resize(static_cast<size_t>(params.length));
+                result.length = params.length;
+                result.delay = params.delay;
+                design(params, result.taps.data());
+                results.publish();
+            }
+            
+            wait(10);
+        }
+    }
+
+private:
+    FirDesigner::Workspace workspace;
+    
+    LockFreeExchange<DesignRequest> requests;
+    LockFreeExchange<Design> results;
+};
+
+//==============================================================================
+// LinearPhaseEQ
+//==============================================================================
+
+LinearPhaseEQ::LinearPhaseEQ() = default;
+
+LinearPhaseEQ::~LinearPhaseEQ() = default;
 
 void LinearPhaseEQ::prepare(double sampleRate, int maximumBlockSize) {
-    currentSampleRate = sampleRate;
+    current.sampleRate = sampleRate;
+    
+    // Room for the longest tier at this rate, so tier changes never allocate
+    preparedMaxLength = FirDesigner::getImpulseLength(LengthTier::Max, sampleRate, 0.0f);
+    current.length = std::clamp(targetLength.load(), minImpulseLength, preparedMaxLength);
+    current.delay = FirDesigner::getDelay(current.length, targetLinearShare.load());
     
-    inputBuffer.setSize(2, fftSize);
-    outputBuffer.setSize(2, fftSize);
-    inputBuffer.clear();
-    outputBuffer.clear();
-    inputBufferPos = 0;
+    juce::ignoreUnused(maximumBlockSize);
+    convolver.prepare(convolverHeadSize, preparedMaxLength);
+    directForm.prepare(directFormMaxLength);
+    impulseResponse.resize(static_cast<size_t>(preparedMaxLength));
     
-    updateImpulseResponse();
+    // Design the current response right away; anything in flight is for the old rate
+    if (!designWorker) {
+        designWorker = std::make_unique<DesignWorker>();
+    }
+    designWorker->stopThread(1000);
+    designWorker->flush();
+    designWorker->design(current, impulseResponse.data());
+    impulseLength = 0;
+    installImpulseResponse(impulseResponse.data(), current.length, current.delay);
+    designWorker->startThread();
+    
+    paramsChanged = false;
     prepared = true;
 }
 
 void LinearPhaseEQ::reset() {
-    inputBuffer.clear();
-    outputBuffer.clear();
-    inputBufferPos = 0;
+    convolver.reset();
+    directForm.reset();
 }
 
-void LinearPhaseEQ::setBandParameters(int bandIndex, float frequency, float q, float gainDb, bool enabled) {
+void LinearPhaseEQ::setImpulseLength(int length) {
+    targetLength.store(std::clamp(length, minImpulseLength, maxImpulseLength) | 1);
+}
+
+void LinearPhaseEQ::setFirPhase(FirPhase phase, float mix) {
+    const float share = phase == FirPhase::Linear ? 1.0f
+                      : phase == FirPhase::Minimum ? 0.0f
+                      : std::clamp(mix, 0.0f, 1.0f);
+    targetLinearShare.store(share);
+}
+
+void LinearPhaseEQ::setBandParameters(int bandIndex, FilterType type, float frequency, float q,
+                                      float gainDb, bool enabled) {
     if (bandIndex < 0 || bandIndex >= numBands) return;
     
-    auto& params = bandParams[static_cast<size_t>(bandIndex)];
-    if (params.frequency != frequency || params.q != q || 
-        params.gainDb != gainDb || params.enabled != enabled) {
-        params.frequency = frequency;
-        params.q = q;
-        params.gainDb = gainDb;
-        params.enabled = enabled;
-        paramsChanged = true;
-    }
+    auto params = current.bands[static_cast<size_t>(bandIndex)];
+    params.type = type;
+    params.frequency = frequency;
+    params.q = q;
+    params.gainDb = gainDb;
+    params.enabled = enabled;
+    setBand(bandIndex, params);
 }
 
-float LinearPhaseEQ::calculateBandResponse(float frequency, float q, float gainDb, float freq) const {
-    if (frequency <= 0.0f || q <= 0.0f) return 1.0f;
-    
-    const float w = 2.0f * static_cast<float>(M_PI) * freq / static_cast<float>(currentSampleRate);
-    const float w0 = 2.0f * static_cast<float>(M_PI) * frequency / static_cast<float>(currentSampleRate);
-    const float A = std::pow(10.0f, gainDb / 40.0f);
-    const float alpha = std::sin(w0) / (2.0f * q);
-    
-    // Simplified peak filter response
-    const float cosW = std::cos(w);
-    const float cosW0 = std::cos(w0);
-    
-    const float numerator = 1.0f + alpha * A;
-    const float denominator = 1.0f + alpha / A;
-    
-    const float H = (numerator + (A - 1.0f) * cosW * cosW0) / 
-                    (denominator + (1.0f / A - 1.0f) * cosW * cosW0);
+void LinearPhaseEQ::setBandOrder(int bandIndex, int order) {
+    if (bandIndex < 0 || bandIndex >= numBands) return;
     
-    return std::abs(H);
+    auto params = current.bands[static_cast<size_t>(bandIndex)];
+    params.order = order;
+    setBand(bandIndex, params);
 }
 
-void LinearPhaseEQ::updateImpulseResponse() {
-    if (!prepared) return;
+void LinearPhaseEQ::setBand(int bandIndex, const BandParams& params) {
+    auto& band = current.bands[static_cast<size_t>(bandIndex)];
+    if (band == params) return;
     
-    // Initialize frequency response to unity
-    std::fill(frequencyResponse.begin(), frequencyResponse.end(), std::complex<float>(1.0f, 0.0f));
+    band = params;
+    paramsChanged = true;
+}
     
-    // Calculate combined frequency response
-    for (size_t i = 0; i < static_cast<size_t>(fftSize / 2 + 1); ++i) {
-        const float freq = static_cast<float>(i) * static_cast<float>(currentSampleRate) / static_cast<float>(fftSize);
-        float magnitude = 1.0f;
-        
-        // Multiply responses of all enabled bands
-        for (int band = 0; band < numBands; ++band) {
-            if (bandParams[static_cast<size_t>(band)].enabled) {
-                const auto& params = bandParams[static_cast<size_t>(band)];
-                magnitude *= calculateBandResponse(params.frequency, params.q, params.gainDb, freq);
-            }
-        }
-        
-        frequencyResponse[i] = std::complex<float>(magnitude, 0.0f);
-        
-        // Mirror for negative frequencies (Hermitian symmetry)
-        if (i > 0 && i < static_cast<size_t>(fftSize / 2)) {
-            frequencyResponse[fftSize - i] = std::conj(frequencyResponse[i]);
-        }
-    }
+void LinearPhaseEQ::process(juce::AudioBuffer<float>& buffer) {
+    if (!prepared) return;
     
-    // Simplified Linear Phase implementation
-    // Full FIR would require proper IFFT - for now use windowed approximation
-    // Create a simple windowed impulse response based on magnitude response
-    for (size_t i = 0; i < static_cast<size_t>(impulseLength); ++i) {
-        const float n = static_cast<float>(i) / static_cast<float>(impulseLength);
-        const float window = 0.5f * (1.0f - std::cos(2.0f * static_cast<float>(M_PI) * n));
-        
-        // Use average magnitude as approximation
-        float avgMagnitude = 0.0f;
-        for (size_t j = 0; j < static_cast<size_t>(fftSize / 2 + 1); ++j) {
-            avgMagnitude += frequencyResponse[j].real();
-        }
-        avgMagnitude /= static_cast<float>(fftSize / 2 + 1);
-        
-        impulseResponse[i] = avgMagnitude * window / static_cast<float>(impulseLength);
+    const int length = std::min(targetLength.load(), preparedMaxLength);
+    const int delay = FirDesigner::getDelay(length, targetLinearShare.load());
+    if (length != current.length || delay != current.delay) {
+        current.length = length;
+        current.delay = delay;
+        paramsChanged = true;
     }
     
-    // Zero pad the rest
-    for (size_t i = static_cast<size_t>(impulseLength); i < static_cast<size_t>(fftSize); ++i) {
-        impulseResponse[i] = 0.0f;
+    // Post changes to the designer; the old response plays until the new one is ready
+    if (paramsChanged) {
+        designWorker->request(current);
+        paramsChanged = false;
     }
     
-    paramsChanged = false;
-}
-
-void LinearPhaseEQ::process(juce::AudioBuffer<float>& buffer) {
-    if (!prepared) return;
-    
-    if (paramsChanged) {
-        updateImpulseResponse();
+    // One arriving mid-fade waits in the exchange
+    if (!convolver.isCrossfading()) {
+        if (const auto* design = designWorker->fetch()) {
+            installImpulseResponse(design->taps.data(), design->length, design->delay);
+        }
     }
     
     const int numChannels = buffer.getNumChannels();
-    const int numSamples = buffer.getNumSamples();
+    if (numChannels < 1) return;
     
-    // Simple overlap-save convolution (simplified for now)
-    // In production, use optimized convolution
-    for (int ch = 0; ch < numChannels; ++ch) {
-        float* channelData = buffer.getWritePointer(ch);
+    if (usesDirectForm(impulseLength, impulseDelay)) {
+        directForm.process(buffer.getArrayOfWritePointers(), numChannels, buffer.getNumSamples());
+        return;
+    }
         
-        for (int i = 0; i < numSamples; ++i) {
-            // Simplified: direct convolution (not optimal, but works)
-            float output = 0.0f;
-            for (int j = 0; j < impulseLength && (i - j) >= 0; ++j) {
-                output += channelData[i - j] * impulseResponse[j];
-            }
-            channelData[i] = output;
-        }
+    // Stereo pairs share one complex FFT per partition
+    convolver.process(buffer.getWritePointer(0),
+                      numChannels > 1 ? buffer.getWritePointer(1) : nullptr,
+                      buffer.getNumSamples());
+}
+
+void LinearPhaseEQ::installImpulseResponse(const float* taps, int length, int delay) {
+    const bool direct = usesDirectForm(length, delay);
+    const bool wasDirect = usesDirectForm(impulseLength, impulseDelay);
+    
+    if (direct) {
+        if (!wasDirect) directForm.reset();
+        directForm.setImpulseResponse(taps, length);
+    } else {
+        // Same length and delay: crossfade. Otherwise the delay moves, so
+        // switch at once (the host realigns to the new latency anyway)
+        if (wasDirect) convolver.reset();
+        convolver.setImpulseResponse(taps, length, length == impulseLength && delay == impulseDelay);
     }
+    
+    impulseLength = length;
+    impulseDelay = delay;
 }
 
 float LinearPhaseEQ::getMagnitudeAtFrequency(float frequency) const {
     if (!prepared || frequency <= 0.0f) return 1.0f;
     
     float magnitude = 1.0f;
-    for (int band = 0; band < numBands; ++band) {
-        if (bandParams[static_cast<size_t>(band)].enabled) {
-            const auto& params = bandParams[static_cast<size_t>(band)];
-            magnitude *= calculateBandResponse(params.frequency, params.q, params.gainDb, frequency);
-        }
-    }
+    FirDesigner::getMagnitudes(current, &frequency, &magnitude, 1);
     return magnitude;
 }
 
 } // namespace SeshEQ
-
@@ -1,11 +1,15 @@
 #pragma once
 
+#include "BiquadFilter.h"
+#include "FirDesigner.h"
+#include "PartitionedConvolver.h"
+#include "SymmetricFIR.h"
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
 #include <array>
+#include <atomic>
+#include <memory>
 #include <vector>
-#include <complex>
-#include <cmath>
 
 namespace SeshEQ {
 
@@ -13,25 +17,93 @@ namespace SeshEQ {
  * @brief Linear Phase EQ using FIR filters
  * 
  * Provides zero phase distortion at the cost of higher latency.
- * Uses FFT-based convolution for efficient processing.
+ * The FIR runs on a non-uniformly partitioned convolver (see PartitionedConvolver),
+ * which adds no latency beyond the FIR's own group delay at any host block size.
+ *
+ * The FIR is designed on a background thread with FirDesigner: it
+ * frequency-samples the exact magnitude of all enabled bands (every FilterType
+ * and slope, designed with CoefficientDesigner like the EQ curve), inverse
+ * transforms the zero-phase spectrum, centres and windows it. The audio thread
+ * only posts parameter changes and picks finished impulse responses up through
+ * lock-free exchanges, then crossfades to them inside the convolver so
+ * automated moves do not click.
+ *
+ * The FIR length (and with it the latency, half the length) follows a
+ * LengthTier: enough cycles of the lowest enabled band to resolve it, capped
+ * per tier and scaled with the sample rate. Short FIRs of up to
+ * directFormMaxLength taps run on a SymmetricFIR instead of the convolver.
+ *
+ * The same target magnitude can also be realized with less delay (FirPhase):
+ * the designer derives the minimum-phase response through the real cepstrum
+ * (fold the cepstrum of the log magnitude onto positive time, exponentiate)
+ * and scales its phase; the rest of the delay is a plain linear-phase shift.
+ * Minimum phase has no latency; Mixed puts its latency (and pre-ringing)
+ * anywhere in between. All phases share the design thread, the convolver and
+ * the crossfaded swaps.
  */
 class LinearPhaseEQ {
 public:
+    /**
+     * @brief Resolution / latency trade-off of the FIR (see FirDesigner::getImpulseLength)
+     */
+    using LengthTier = FirDesigner::LengthTier;
+    
+    /**
+     * @brief Phase response of the FIR
+     */
+    enum class FirPhase {
+        Linear,   // Symmetric, latency (length - 1) / 2 (default)
+        Minimum,  // Cepstral minimum phase, no latency
+        Mixed     // Minimum-phase share scaled down, latency mix * (length - 1) / 2
+    };
+    
+    // Odd lengths, so the group delay is a whole number of samples
+    static constexpr int minImpulseLength = FirDesigner::minImpulseLength;
+    static constexpr int directFormMaxLength = 255;
+    static constexpr int maxImpulseLength = FirDesigner::maxImpulseLength;
+    static constexpr int defaultImpulseLength = FirDesigner::defaultImpulseLength;
+    
     LinearPhaseEQ();
-    ~LinearPhaseEQ() = default;
+    ~LinearPhaseEQ();
     
+    /**
+     * @brief Prepare the convolver and design the current response (not real-time safe)
+     */
     void prepare(double sampleRate, int maximumBlockSize);
     void reset();
     
     /**
-     * @brief Set EQ band parameters
+     * @brief Set EQ band parameters (audio thread, never blocks)
      * @param bandIndex Band index (0-7)
+     * @param type Filter type
      * @param frequency Center frequency in Hz
      * @param q Q factor
      * @param gainDb Gain in dB
      * @param enabled Whether band is enabled
      */
-    void setBandParameters(int bandIndex, float frequency, float q, float gainDb, bool enabled);
+    void setBandParameters(int bandIndex, FilterType type, float frequency, float q, float gainDb, bool enabled);
+    
+    /**
+     * @brief Set the filter order of a band (HighPass/LowPass slopes)
+     */
+    void setBandOrder(int bandIndex, int order);
+    
+    /**
+     * @brief Set the FIR length (any thread; getLatency() follows at once)
+     *
+     * The audio thread switches to the new length with the next design,
+     * without a crossfade, since the delay moves with it.
+     * @param length Odd, see FirDesigner::getImpulseLength (clamped to what prepare() allows)
+     */
+    void setImpulseLength(int length);
+    
+    /**
+     * @brief Set the FIR phase (any thread; getLatency() follows at once)
+     *
+     * Like a length change, a new latency is switched to without a crossfade.
+     * @param mix For Mixed: 0 = minimum phase to 1 = linear phase
+     */
+    void setFirPhase(FirPhase phase, float mix);
     
     /**
      * @brief Process audio buffer
@@ -39,46 +111,56 @@ public:
     void process(juce::AudioBuffer<float>& buffer);
     
     /**
-     * @brief Get magnitude response at frequency
+     * @brief Get magnitude response at frequency (the response the FIR is designed from)
      */
     float getMagnitudeAtFrequency(float frequency) const;
     
     /**
-     * @brief Get latency in samples
+     * @brief Get latency in samples (the FIR's group delay)
      */
-    int getLatency() const { return fftSize / 2; }
+    int getLatency() const { return FirDesigner::getDelay(targetLength.load(), targetLinearShare.load()); }
     
 private:
-    static constexpr int numBands = 8;
-    static constexpr int fftSize = 4096;  // Must be power of 2
-    static constexpr int impulseLength = fftSize / 2;
-    
-    void updateImpulseResponse();
-    float calculateBandResponse(float frequency, float q, float gainDb, float freq) const;
-    
-    struct BandParams {
-        float frequency = 1000.0f;
-        float q = 0.707f;
-        float gainDb = 0.0f;
-        bool enabled = false;
-    };
+    static constexpr int numBands = FirDesigner::numBands;
     
-    std::array<BandParams, numBands> bandParams;
+    // Taps the convolver runs direct-form before its smallest FFT partition
+    static constexpr int convolverHeadSize = 64;
+    
+    using BandParams = FirDesigner::BandParams;
+    using DesignRequest = FirDesigner::DesignRequest;
+    
+    void setBand(int bandIndex, const BandParams& params);
+    
+    /**
+     * @brief Hand a designed FIR to the direct form or the convolver
+     */
+    void installImpulseResponse(const float* taps, int length, int delay);
+    
+    /**
+     * @brief Short symmetric (linear-phase) FIRs run on the direct form
+     */
+    static bool usesDirectForm(int length, int delay) {
+        return length <= directFormMaxLength && delay == (length - 1) / 2;
+    }
+    
+    class DesignWorker;
+    std::unique_ptr<DesignWorker> designWorker;
+    
+    DesignRequest current;
     bool paramsChanged = true;
     
-    // FFT for convolution
-    juce::dsp::FFT fft;
-    std::vector<std::complex<float>> frequencyResponse;
+    std::atomic<int> targetLength { defaultImpulseLength };
+    std::atomic<float> targetLinearShare { 1.0f };
+    int preparedMaxLength = maxImpulseLength;  // Longest FIR at the prepared rate
+    int impulseLength = 0;                     // Length installed on the audio thread
+    int impulseDelay = 0;                      // and its delay
     std::vector<float> impulseResponse;
     
-    // Overlap-save buffers
-    juce::AudioBuffer<float> inputBuffer;
-    juce::AudioBuffer<float> outputBuffer;
-    int inputBufferPos = 0;
+    // Both channels in one pass; short FIRs run direct-form instead
+    PartitionedConvolver convolver;
+    SymmetricFIR directForm;
     
-    double currentSampleRate = 44100.0;
     bool prepared = false;
 };
 
 } // namespace SeshEQ
-
@@ -0,0 +1,483 @@
+#include "MultibandDynamics.h"
+#include "utils/FastMath.h"
+#include "utils/SIMDSupport.h"
+#include <algorithm>
+#include <cmath>
+
+namespace SeshEQ {
+
+namespace {
+
+/**
+ * @brief One-pole smoothing coefficient for a time constant (as LevelDetector)
+ */
+float getBallisticsCoefficient(float timeMs, double sampleRate) {
+    if (timeMs <= 0.0f) return 0.0f;  // Instant
+    return static_cast<float>(std::exp(-1.0 / (timeMs / 1000.0 * sampleRate)));
+}
+
+constexpr int maxBands = MultibandDynamics::maxBands;
+
+// Samples per pass through the stages
+constexpr int chunkSize = 64;
+
+/**
+ * @brief The lanes of all bands for one process() call, and the chunk's stage data
+ */
+struct StageLanes {
+    alignas(32) float envelope[maxBands];
+    alignas(32) float attackCoef[maxBands];
+    alignas(32) float releaseCoef[maxBands];
+    alignas(32) float thresholdDb[maxBands];
+    alignas(32) float ratio[maxBands];
+    alignas(32) float inverseRatio[maxBands];
+    alignas(32) float inverseKnee[maxBands];
+    alignas(32) float kneeStart[maxBands];
+    alignas(32) float kneeEnd[maxBands];
+    alignas(32) float gainReduction[maxBands];
+    
+    // [sample][band]: band levels in, linear gains out
+    alignas(32) float scratch[chunkSize * maxBands];
+};
+
+// Gain curve and dB conversions in the units the lanes work in
+constexpr float dbPerOctave = static_cast<float>(20.0 / FastMath::log2Of10);
+constexpr float octavesPerDb = static_cast<float>(FastMath::log2Of10 / 20.0);
+constexpr float minimumLevel = 1e-10f;  // -200 dB, as FastMath::gainToDb
+
+#if !SESHEQ_SIMD_X86 && !SESHEQ_SIMD_NEON
+/**
+ * @brief Turn a chunk of band levels into gains: envelope, dB, curve, linear
+ */
+void runStagesScalar(StageLanes& lanes, int count) {
+    const int numValues = count * maxBands;
+    float* scratch = lanes.scratch;
+    
+    // Every band's envelope in one step per sample
+    for (int i = 0; i < count; ++i) {
+        float* level = scratch + i * maxBands;
+        
+        for (int b = 0; b < maxBands; ++b) {
+            const float coef = level[b] > lanes.envelope[b] ? lanes.attackCoef[b] : lanes.releaseCoef[b];
+            lanes.envelope[b] = coef * lanes.envelope[b] + (1.0f - coef) * level[b];
+            level[b] = lanes.envelope[b];
+        }
+    }
+    
+    for (int k = 0; k < numValues; ++k) {
+        scratch[k] = FastMath::gainToDb(scratch[k]);
+    }
+    
+    // DynamicsCurve for every band at once: all branches are evaluated and
+    // the band's region selects one. Above the knee a compressor and below
+    // it an expander both follow threshold + (input - threshold) / ratio.
+    for (int i = 0; i < count; ++i) {
+        float* value = scratch + i * maxBands;
+        
+        for (int b = 0; b < maxBands; ++b) {
+            const float inputDb = value[b];
+            const float threshold = lanes.thresholdDb[b];
+            const float full = threshold + (inputDb - threshold) * lanes.inverseRatio[b];
+            
+            const float overStart = inputDb - lanes.kneeStart[b];
+            const float kneeCompressed = lanes.kneeStart[b]
+                                         + overStart / (1.0f + (lanes.ratio[b] - 1.0f) * overStart * lanes.inverseKnee[b]);
+            
+            const float t = (lanes.kneeEnd[b] - inputDb) * lanes.inverseKnee[b];
+            const float kneeExpanded = inputDb - (threshold - inputDb) * (lanes.inverseRatio[b] - 1.0f) * t * t;
+            
+            const float compressed = inputDb < lanes.kneeStart[b] ? inputDb
+                                     : inputDb > lanes.kneeEnd[b] ? full : kneeCompressed;
+            const float expanded = inputDb > lanes.kneeEnd[b] ? inputDb
+                                   : inputDb < lanes.kneeStart[b] ? full : kneeExpanded;
+            
+            const float gainDb = (lanes.ratio[b] >= 1.0f ? compressed : expanded) - inputDb;
+            lanes.gainReduction[b] = std::min(lanes.gainReduction[b], gainDb);
+            value[b] = gainDb;
+        }
+    }
+    
+    for (int k = 0; k < numValues; ++k) {
+        scratch[k] = FastMath::dbToGain(scratch[k]);
+    }
+}
+#endif
+
+//==============================================================================
+// SIMD stages: each sample's row of band levels goes through the envelope,
+// FastMath::log2, the gain curve and FastMath::exp2 in registers. The float
+// compares that pick the attack or release coefficient and the curve region
+// become masks and blends, which the compiler will not produce from the
+// scalar selects by itself.
+//==============================================================================
+
+#if SESHEQ_SIMD_X86
+/**
+ * @brief Four-lane operations for the shared stage body (SSE2)
+ */
+struct SSE2Lanes {
+    using Float = __m128;
+    using Int = __m128i;
+    using Mask = __m128;
+    
+    static SESHEQ_FORCE_INLINE Float load(const float* p) { return _mm_load_ps(p); }
+    static SESHEQ_FORCE_INLINE void store(float* p, Float v) { _mm_store_ps(p, v); }
+    static SESHEQ_FORCE_INLINE Float set(float v) { return _mm_set1_ps(v); }
+    static SESHEQ_FORCE_INLINE Float add(Float a, Float b) { return _mm_add_ps(a, b); }
+    static SESHEQ_FORCE_INLINE Float sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+    static SESHEQ_FORCE_INLINE Float mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+    static SESHEQ_FORCE_INLINE Float div(Float a, Float b) { return _mm_div_ps(a, b); }
+    static SESHEQ_FORCE_INLINE Float min(Float a, Float b) { return _mm_min_ps(a, b); }
+    static SESHEQ_FORCE_INLINE Float max(Float a, Float b) { return _mm_max_ps(a, b); }
+    static SESHEQ_FORCE_INLINE Mask greater(Float a, Float b) { return _mm_cmpgt_ps(a, b); }
+    static SESHEQ_FORCE_INLINE Mask less(Float a, Float b) { return _mm_cmplt_ps(a, b); }
+    static SESHEQ_FORCE_INLINE Float select(Mask m, Float a, Float b) {
+        return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+    }
+    
+    static SESHEQ_FORCE_INLINE Int bits(Float v) { return _mm_castps_si128(v); }
+    static SESHEQ_FORCE_INLINE Float fromBits(Int v) { return _mm_castsi128_ps(v); }
+    static SESHEQ_FORCE_INLINE Int setInt(int v) { return _mm_set1_epi32(v); }
+    static SESHEQ_FORCE_INLINE Int addInt(Int a, Int b) { return _mm_add_epi32(a, b); }
+    static SESHEQ_FORCE_INLINE Int subInt(Int a, Int b) { return _mm_sub_epi32(a, b); }
+    static SESHEQ_FORCE_INLINE Int exponent(Int v) { return _mm_srai_epi32(v, 23); }
+    static SESHEQ_FORCE_INLINE Int toExponent(Int v) { return _mm_slli_epi32(v, 23); }
+    static SESHEQ_FORCE_INLINE Float toFloat(Int v) { return _mm_cvtepi32_ps(v); }
+};
+#endif
+
+#if SESHEQ_SIMD_NEON
+/**
+ * @brief Four-lane operations for the shared stage body (NEON)
+ */
+struct NEONLanes {
+    using Float = float32x4_t;
+    using Int = int32x4_t;
+    using Mask = uint32x4_t;
+    
+    static SESHEQ_FORCE_INLINE Float load(const float* p) { return vld1q_f32(p); }
+    static SESHEQ_FORCE_INLINE void store(float* p, Float v) { vst1q_f32(p, v); }
+    static SESHEQ_FORCE_INLINE Float set(float v) { return vdupq_n_f32(v); }
+    static SESHEQ_FORCE_INLINE Float add(Float a, Float b) { return vaddq_f32(a, b); }
+    static SESHEQ_FORCE_INLINE Float sub(Float a, Float b) { return vsubq_f32(a, b); }
+    static SESHEQ_FORCE_INLINE Float mul(Float a, Float b) { return vmulq_f32(a, b); }
+    static SESHEQ_FORCE_INLINE Float div(Float a, Float b) { return vdivq_f32(a, b); }
+    static SESHEQ_FORCE_INLINE Float min(Float a, Float b) { return vminq_f32(a, b); }
+    static SESHEQ_FORCE_INLINE Float max(Float a, Float b) { return vmaxq_f32(a, b); }
+    static SESHEQ_FORCE_INLINE Mask greater(Float a, Float b) { return vcgtq_f32(a, b); }
+    static SESHEQ_FORCE_INLINE Mask less(Float a, Float b) { return vcltq_f32(a, b); }
+    static SESHEQ_FORCE_INLINE Float select(Mask m, Float a, Float b) { return vbslq_f32(m, a, b); }
+    
+    static SESHEQ_FORCE_INLINE Int bits(Float v) { return vreinterpretq_s32_f32(v); }
+    static SESHEQ_FORCE_INLINE Float fromBits(Int v) { return vreinterpretq_f32_s32(v); }
+    static SESHEQ_FORCE_INLINE Int setInt(int v) { return vdupq_n_s32(v); }
+    static SESHEQ_FORCE_INLINE Int addInt(Int a, Int b) { return vaddq_s32(a, b); }
+    static SESHEQ_FORCE_INLINE Int subInt(Int a, Int b) { return vsubq_s32(a, b); }
+    static SESHEQ_FORCE_INLINE Int exponent(Int v) { return vshrq_n_s32(v, 23); }
+    static SESHEQ_FORCE_INLINE Int toExponent(Int v) { return vshlq_n_s32(v, 23); }
+    static SESHEQ_FORCE_INLINE Float toFloat(Int v) { return vcvtq_f32_s32(v); }
+};
+#endif
+
+#if SESHEQ_SIMD_X86 || SESHEQ_SIMD_NEON
+/**
+ * @brief Four bands from lane b of every row of the chunk
+ */
+template <class Ops>
+SESHEQ_FORCE_INLINE void runStageQuad(StageLanes& lanes, int b, int count) {
+    using Float = typename Ops::Float;
+    
+    const Float attack = Ops::load(lanes.attackCoef + b);
+    const Float release = Ops::load(lanes.releaseCoef + b);
+    const Float threshold = Ops::load(lanes.thresholdDb + b);
+    const Float ratioMinusOne = Ops::sub(Ops::load(lanes.ratio + b), Ops::set(1.0f));
+    const Float inverseRatio = Ops::load(lanes.inverseRatio + b);
+    const Float inverseKnee = Ops::load(lanes.inverseKnee + b);
+    const Float kneeStart = Ops::load(lanes.kneeStart + b);
+    const Float kneeEnd = Ops::load(lanes.kneeEnd + b);
+    const auto expanding = Ops::less(ratioMinusOne, Ops::set(0.0f));
+    const Float one = Ops::set(1.0f);
+    
+    Float envelope = Ops::load(lanes.envelope + b);
+    Float reduction = Ops::load(lanes.gainReduction + b);
+    
+    for (int i = 0; i < count; ++i) {
+        float* row = lanes.scratch + i * maxBands + b;
+        const Float level = Ops::load(row);
+        
+        const Float coef = Ops::select(Ops::greater(level, envelope), attack, release);
+        envelope = Ops::add(Ops::mul(coef, envelope), Ops::mul(Ops::sub(one, coef), level));
+        
+        // FastMath::gainToDb
+        const auto levelBits = Ops::bits(Ops::max(envelope, Ops::set(minimumLevel)));
+        const auto e = Ops::exponent(Ops::subInt(levelBits, Ops::setInt(0x3f3504f3)));
+        const Float m = Ops::fromBits(Ops::subInt(levelBits, Ops::toExponent(e)));
+        const Float t = Ops::div(Ops::sub(m, one), Ops::add(m, one));
+        const Float t2 = Ops::mul(t, t);
+        Float p = Ops::set(1.0f / 9.0f);
+        p = Ops::add(Ops::mul(p, t2), Ops::set(1.0f / 7.0f));
+        p = Ops::add(Ops::mul(p, t2), Ops::set(1.0f / 5.0f));
+        p = Ops::add(Ops::mul(p, t2), Ops::set(1.0f / 3.0f));
+        p = Ops::add(Ops::mul(p, t2), one);
+        const Float octaves = Ops::add(Ops::toFloat(e), Ops::mul(Ops::mul(t, p), Ops::set(static_cast<float>(2.0 / FastMath::ln2))));
+        const Float inputDb = Ops::mul(octaves, Ops::set(dbPerOctave));
+        
+        // DynamicsCurve, as in the scalar stages
+        const Float full = Ops::add(threshold, Ops::mul(Ops::sub(inputDb, threshold), inverseRatio));
+        const Float overStart = Ops::sub(inputDb, kneeStart);
+        const Float kneeCompressed = Ops::add(kneeStart, Ops::div(overStart,
+            Ops::add(one, Ops::mul(Ops::mul(ratioMinusOne, overStart), inverseKnee))));
+        const Float u = Ops::mul(Ops::sub(kneeEnd, inputDb), inverseKnee);
+        const Float kneeExpanded = Ops::sub(inputDb, Ops::mul(Ops::mul(Ops::mul(Ops::sub(threshold, inputDb),
+            Ops::sub(inverseRatio, one)), u), u));
+        
+        const auto belowKnee = Ops::less(inputDb, kneeStart);
+        const auto aboveKnee = Ops::greater(inputDb, kneeEnd);
+        const Float compressed = Ops::select(belowKnee, inputDb, Ops::select(aboveKnee, full, kneeCompressed));
+        const Float expanded = Ops::select(aboveKnee, inputDb, Ops::select(belowKnee, full, kneeExpanded));
+        const Float gainDb = Ops::sub(Ops::select(expanding, expanded, compressed), inputDb);
+        reduction = Ops::min(reduction, gainDb);
+        
+        // FastMath::dbToGain
+        const Float x = Ops::max(Ops::min(Ops::mul(gainDb, Ops::set(octavesPerDb)), Ops::set(127.0f)),
+                                 Ops::set(-126.0f));
+        const Float shifter = Ops::set(12582912.0f);
+        const Float shifted = Ops::add(x, shifter);
+        const Float f = Ops::mul(Ops::sub(x, Ops::sub(shifted, shifter)), Ops::set(static_cast<float>(FastMath::ln2)));
+        Float q = Ops::set(1.0f / 720.0f);
+        q = Ops::add(Ops::mul(q, f), Ops::set(1.0f / 120.0f));
+        q = Ops::add(Ops::mul(q, f), Ops::set(1.0f / 24.0f));
+        q = Ops::add(Ops::mul(q, f), Ops::set(1.0f / 6.0f));
+        q = Ops::add(Ops::mul(q, f), Ops::set(0.5f));
+        q = Ops::add(Ops::mul(q, f), one);
+        q = Ops::add(Ops::mul(q, f), one);
+        const Float scale = Ops::fromBits(Ops::toExponent(Ops::addInt(Ops::bits(shifted), Ops::setInt(127))));
+        
+        Ops::store(row, Ops::mul(q, scale));
+    }
+    
+    Ops::store(lanes.envelope + b, envelope);
+    Ops::store(lanes.gainReduction + b, reduction);
+}
+#endif
+
+#if SESHEQ_SIMD_X86
+void runStagesSSE2(StageLanes& lanes, int count) {
+    runStageQuad<SSE2Lanes>(lanes, 0, count);
+    runStageQuad<SSE2Lanes>(lanes, 4, count);
+}
+
+/**
+ * @brief All eight bands in one register (the integer steps of log2 and exp2 need AVX2)
+ */
+SESHEQ_TARGET_AVX2_FMA
+void runStagesAVX2(StageLanes& lanes, int count) {
+    const __m256 attack = _mm256_load_ps(lanes.attackCoef);
+    const __m256 release = _mm256_load_ps(lanes.releaseCoef);
+    const __m256 threshold = _mm256_load_ps(lanes.thresholdDb);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 ratioMinusOne = _mm256_sub_ps(_mm256_load_ps(lanes.ratio), one);
+    const __m256 inverseRatio = _mm256_load_ps(lanes.inverseRatio);
+    const __m256 inverseKnee = _mm256_load_ps(lanes.inverseKnee);
+    const __m256 kneeStart = _mm256_load_ps(lanes.kneeStart);
+    const __m256 kneeEnd = _mm256_load_ps(lanes.kneeEnd);
+    const __m256 expanding = _mm256_cmp_ps(ratioMinusOne, _mm256_setzero_ps(), _CMP_LT_OQ);
+    
+    __m256 envelope = _mm256_load_ps(lanes.envelope);
+    __m256 reduction = _mm256_load_ps(lanes.gainReduction);
+    
+    for (int i = 0; i < count; ++i) {
+        float* row = lanes.scratch + i * maxBands;
+        const __m256 level = _mm256_load_ps(row);
+        
+        const __m256 coef = _mm256_blendv_ps(release, attack, _mm256_cmp_ps(level, envelope, _CMP_GT_OQ));
+        envelope = _mm256_add_ps(_mm256_mul_ps(coef, envelope), _mm256_mul_ps(_mm256_sub_ps(one, coef), level));
+        
+        // FastMath::gainToDb
+        const __m256i levelBits = _mm256_castps_si256(_mm256_max_ps(envelope, _mm256_set1_ps(minimumLevel)));
+        const __m256i e = _mm256_srai_epi32(_mm256_sub_epi32(levelBits, _mm256_set1_epi32(0x3f3504f3)), 23);
+        const __m256 m = _mm256_castsi256_ps(_mm256_sub_epi32(levelBits, _mm256_slli_epi32(e, 23)));
+        const __m256 t = _mm256_div_ps(_mm256_sub_ps(m, one), _mm256_add_ps(m, one));
+        const __m256 t2 = _mm256_mul_ps(t, t);
+        __m256 p = _mm256_set1_ps(1.0f / 9.0f);
+        p = _mm256_add_ps(_mm256_mul_ps(p, t2), _mm256_set1_ps(1.0f / 7.0f));
+        p = _mm256_add_ps(_mm256_mul_ps(p, t2), _mm256_set1_ps(1.0f / 5.0f));
+        p = _mm256_add_ps(_mm256_mul_ps(p, t2), _mm256_set1_ps(1.0f / 3.0f));
+        p = _mm256_add_ps(_mm256_mul_ps(p, t2), one);
+        const __m256 octaves = _mm256_add_ps(_mm256_cvtepi32_ps(e),
+            _mm256_mul_ps(_mm256_mul_ps(t, p), _mm256_set1_ps(static_cast<float>(2.0 / FastMath::ln2))));
+        const __m256 inputDb = _mm256_mul_ps(octaves, _mm256_set1_ps(dbPerOctave));
+        
+        // DynamicsCurve, as in the scalar stages
+        const __m256 full = _mm256_add_ps(threshold, _mm256_mul_ps(_mm256_sub_ps(inputDb, threshold), inverseRatio));
+        const __m256 overStart = _mm256_sub_ps(inputDb, kneeStart);
+        const __m256 kneeCompressed = _mm256_add_ps(kneeStart, _mm256_div_ps(overStart,
+            _mm256_add_ps(one, _mm256_mul_ps(_mm256_mul_ps(ratioMinusOne, overStart), inverseKnee))));
+        const __m256 u = _mm256_mul_ps(_mm256_sub_ps(kneeEnd, inputDb), inverseKnee);
+        const __m256 kneeExpanded = _mm256_sub_ps(inputDb, _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(
+            _mm256_sub_ps(threshold, inputDb), _mm256_sub_ps(inverseRatio, one)), u), u));
+        
+        const __m256 belowKnee = _mm256_cmp_ps(inputDb, kneeStart, _CMP_LT_OQ);
+        const __m256 aboveKnee = _mm256_cmp_ps(inputDb, kneeEnd, _CMP_GT_OQ);
+        const __m256 compressed = _mm256_blendv_ps(_mm256_blendv_ps(kneeCompressed, full, aboveKnee), inputDb, belowKnee);
+        const __m256 expanded = _mm256_blendv_ps(_mm256_blendv_ps(kneeExpanded, full, belowKnee), inputDb, aboveKnee);
+        const __m256 gainDb = _mm256_sub_ps(_mm256_blendv_ps(compressed, expanded, expanding), inputDb);
+        reduction = _mm256_min_ps(reduction, gainDb);
+        
+        // FastMath::dbToGain
+        const __m256 x = _mm256_max_ps(_mm256_min_ps(_mm256_mul_ps(gainDb, _mm256_set1_ps(octavesPerDb)),
+                                                     _mm256_set1_ps(127.0f)), _mm256_set1_ps(-126.0f));
+        const __m256 shifter = _mm256_set1_ps(12582912.0f);
+        const __m256 shifted = _mm256_add_ps(x, shifter);
+        const __m256 f = _mm256_mul_ps(_mm256_sub_ps(x, _mm256_sub_ps(shifted, shifter)),
+                                       _mm256_set1_ps(static_cast<float>(FastMath::ln2)));
+        __m256 q = _mm256_set1_ps(1.0f / 720.0f);
+        q = _mm256_add_ps(_mm256_mul_ps(q, f), _mm256_set1_ps(1.0f / 120.0f));
+        q = _mm256_add_ps(_mm256_mul_ps(q, f), _mm256_set1_ps(1.0f / 24.0f));
+        q = _mm256_add_ps(_mm256_mul_ps(q, f), _mm256_set1_ps(1.0f / 6.0f));
+        q = _mm256_add_ps(_mm256_mul_ps(q, f), _mm256_set1_ps(0.5f));
+        q = _mm256_add_ps(_mm256_mul_ps(q, f), one);
+        q = _mm256_add_ps(_mm256_mul_ps(q, f), one);
+        const __m256 scale = _mm256_castsi256_ps(_mm256_slli_epi32(
+            _mm256_add_epi32(_mm256_castps_si256(shifted), _mm256_set1_epi32(127)), 23));
+        
+        _mm256_store_ps(row, _mm256_mul_ps(q, scale));
+    }
+    
+    _mm256_store_ps(lanes.envelope, envelope);
+    _mm256_store_ps(lanes.gainReduction, reduction);
+}
+#endif
+
+#if SESHEQ_SIMD_NEON
+void runStagesNEON(StageLanes& lanes, int count) {
+    runStageQuad<NEONLanes>(lanes, 0, count);
+    runStageQuad<NEONLanes>(lanes, 4, count);
+}
+#endif
+
+using StagesFn = void (*)(StageLanes&, int);
+
+StagesFn selectStages() {
+#if SESHEQ_SIMD_X86
+    const auto& caps = SIMD::getCapabilities();
+    return caps.avx2 && caps.fma ? &runStagesAVX2 : &runStagesSSE2;
+#elif SESHEQ_SIMD_NEON
+    return &runStagesNEON;
+#else
+    return &runStagesScalar;
+#endif
+}
+
+} // namespace
+
+void MultibandDynamics::prepare(double newSampleRate) {
+    sampleRate = newSampleRate;
+    
+    // Recompute the ballistics on the next setBand, and pass audio until then
+    for (int band = 0; band < maxBands; ++band) {
+        attackMs[band] = -1.0f;
+        releaseMs[band] = -1.0f;
+        setBand(band, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f);
+    }
+    
+    reset();
+}
+
+void MultibandDynamics::reset() {
+    for (int band = 0; band < maxBands; ++band) {
+        resetBand(band);
+    }
+}
+
+void MultibandDynamics::resetBand(int band) {
+    if (band < 0 || band >= maxBands) return;
+    
+    envelope[band] = 0.0f;
+    gainReduction[band] = 0.0f;
+}
+
+void MultibandDynamics::setBand(int band, float newThresholdDb, float newRatio, float kneeDb,
+                                float newAttackMs, float newReleaseMs) {
+    if (band < 0 || band >= maxBands) return;
+    
+    const float clampedRatio = std::clamp(newRatio, 0.1f, 20.0f);
+    const float knee = std::max(0.0f, kneeDb);
+    
+    thresholdDb[band] = newThresholdDb;
+    ratio[band] = clampedRatio;
+    inverseRatio[band] = 1.0f / clampedRatio;
+    inverseKnee[band] = knee > 0.0f ? 1.0f / knee : 0.0f;
+    kneeStart[band] = newThresholdDb - knee / 2.0f;
+    kneeEnd[band] = newThresholdDb + knee / 2.0f;
+    
+    if (!FastMath::bitsEqual(newAttackMs, attackMs[band])) {
+        attackMs[band] = newAttackMs;
+        attackCoef[band] = getBallisticsCoefficient(newAttackMs, sampleRate);
+    }
+    if (!FastMath::bitsEqual(newReleaseMs, releaseMs[band])) {
+        releaseMs[band] = newReleaseMs;
+        releaseCoef[band] = getBallisticsCoefficient(newReleaseMs, sampleRate);
+    }
+}
+
+void MultibandDynamics::process(float* const* left, float* const* right, int numSamples) {
+    static const StagesFn stages = selectStages();
+    
+    StageLanes lanes;
+    std::copy(envelope, envelope + maxBands, lanes.envelope);
+    std::copy(attackCoef, attackCoef + maxBands, lanes.attackCoef);
+    std::copy(releaseCoef, releaseCoef + maxBands, lanes.releaseCoef);
+    std::copy(thresholdDb, thresholdDb + maxBands, lanes.thresholdDb);
+    std::copy(ratio, ratio + maxBands, lanes.ratio);
+    std::copy(inverseRatio, inverseRatio + maxBands, lanes.inverseRatio);
+    std::copy(inverseKnee, inverseKnee + maxBands, lanes.inverseKnee);
+    std::copy(kneeStart, kneeStart + maxBands, lanes.kneeStart);
+    std::copy(kneeEnd, kneeEnd + maxBands, lanes.kneeEnd);
+    std::fill(lanes.gainReduction, lanes.gainReduction + maxBands, 0.0f);
+    
+    float* scratch = lanes.scratch;
+    
+    for (int start = 0; start < numSamples; start += chunkSize) {
+        const int count = std::min(chunkSize, numSamples - start);
+        
+        // Peak of both channels, band by band
+        for (int band = 0; band < maxBands; ++band) {
+            const float* l = left[band] != nullptr ? left[band] + start : nullptr;
+            const float* r = right != nullptr && right[band] != nullptr ? right[band] + start : nullptr;
+            
+            for (int i = 0; i < count; ++i) {
+                const float leftLevel = l != nullptr ? std::abs(l[i]) : 0.0f;
+                const float rightLevel = r != nullptr ? std::abs(r[i]) : 0.0f;
+                scratch[i * maxBands + band] = std::max(leftLevel, rightLevel);
+            }
+        }
+        
+        stages(lanes, count);
+        
+        // Back onto the band signals
+        for (int band = 0; band < maxBands; ++band) {
+            float* l = left[band];
+            if (l == nullptr) continue;
+            
+            float* r = right != nullptr ? right[band] : nullptr;
+            l += start;
+            
+            for (int i = 0; i < count; ++i) {
+                l[i] *= scratch[i * maxBands + band];
+            }
+            
+            if (r != nullptr) {
+                r += start;
+                for (int i = 0; i < count; ++i) {
+                    r[i] *= scratch[i * maxBands + band];
+                }
+            }
+        }
+    }
+    
+    std::copy(lanes.envelope, lanes.envelope + maxBands, envelope);
+    std::copy(lanes.gainReduction, lanes.gainReduction + maxBands, gainReduction);
+}
+
+} // namespace SeshEQ
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "LevelDetector.h"
+
+namespace SeshEQ {
+
+/**
+ * @brief Compressor/expander for up to maxBands band signals in one pass
+ *
+ * Each band is a peak-detecting feed-forward compressor (or downward
+ * expander for ratios below 1) with the soft-knee DynamicsCurve, as the
+ * Compressor runs it. The envelopes, thresholds, ratios, knees and
+ * ballistics of all bands sit side by side in structure-of-arrays lanes, so
+ * the envelope followers and gain computers of every band advance together
+ * with full-width SIMD arithmetic: eight float lanes are one register with
+ * AVX2 (picked at runtime when the CPU has it, as in BiquadKernels) or two
+ * with SSE2/NEON.
+ *
+ * Audio runs in chunks: the band levels of a chunk are gathered into a
+ * sample-major scratch table ([sample][band]), which each stage then
+ * rewrites in place (envelope, level in dB, gain in dB, linear gain) before
+ * the gains go back onto the band signals. Bands that are not in use cost
+ * their lanes anyway.
+ */
+class MultibandDynamics {
+public:
+    static constexpr int maxBands = 8;
+    
+    MultibandDynamics() = default;
+    
+    void prepare(double sampleRate);
+    
+    /**
+     * @brief Clear the envelopes of all bands
+     */
+    void reset();
+    
+    /**
+     * @brief Clear one band (before it starts compressing again)
+     */
+    void resetBand(int band);
+    
+    /**
+     * @brief Set a band's gain curve and ballistics
+     * @param ratio 0.1 (expansion) to 20 (limiting), as the Compressor
+     */
+    void setBand(int band, float thresholdDb, float ratio, float kneeDb, float attackMs, float releaseMs);
+    
+    /**
+     * @brief Compress every band in place
+     * @param left Signal of each band (nullptr = band not in use)
+     * @param right Right channel of each band (nullptr, or nullptr entries, for mono)
+     */
+    void process(float* const* left, float* const* right, int numSamples);
+    
+    /**
+     * @brief Strongest gain change of a band in the last process() call (dB, <= 0)
+     */
+    float getGainReduction(int band) const { return gainReduction[band]; }
+
+private:
+    double sampleRate = 44100.0;
+    
+    // Ballistics
+    alignas(32) float envelope[maxBands] = {};
+    alignas(32) float attackCoef[maxBands] = {};
+    alignas(32) float releaseCoef[maxBands] = {};
+    
+    // Gain curve, with the knee edges and reciprocals precomputed
+    alignas(32) float thresholdDb[maxBands] = {};
+    alignas(32) float ratio[maxBands] = {};
+    alignas(32) float inverseRatio[maxBands] = {};
+    alignas(32) float inverseKnee[maxBands] = {};  // 0 for a hard knee
+    alignas(32) float kneeStart[maxBands] = {};
+    alignas(32) float kneeEnd[maxBands] = {};
+    
+    alignas(32) float gainReduction[maxBands] = {};
+    
+    // Settings the coefficients were computed for (-1 = none yet)
+    float attackMs[maxBands] = {};
+    float releaseMs[maxBands] = {};
+};
+
+} // namespace SeshEQ
@@ -0,0 +1,314 @@
+#include "ParallelEngine.h"
+#include "utils/SIMDSupport.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+namespace SeshEQ {
+
+namespace {
+
+using Complex = std::complex<double>;
+
+constexpr int maxLanes = ParallelDesign::maxSections;
+
+// Below this a coefficient counts as zero
+constexpr double coefficientEpsilon = 1e-12;
+
+// Poles closer than this to each other or to the origin make the residues explode
+constexpr double minPoleDistance = 1e-4;
+
+// Largest deviation from the cascade response the expansion may have
+constexpr double maxResponseError = 1e-6;
+
+Complex evalPolynomial(double c0, double c1, double c2, Complex w) {
+    return c0 + w * (c1 + w * c2);
+}
+
+// H(e^jw) of the source cascade and of the parallel form
+Complex cascadeResponse(const ParallelDesign& d, Complex zInv) {
+    Complex h = 1.0;
+    for (int k = 0; k < d.numSources; ++k) {
+        const auto& c = d.sources[static_cast<size_t>(k)];
+        h *= evalPolynomial(c.b0, c.b1, c.b2, zInv) / evalPolynomial(1.0, c.a1, c.a2, zInv);
+    }
+    return h;
+}
+
+Complex parallelResponse(const ParallelDesign& d, Complex zInv) {
+    Complex h = d.direct;
+    for (int k = 0; k < d.numSections; ++k) {
+        const auto& s = d.sections[static_cast<size_t>(k)];
+        h += evalPolynomial(s.b0, s.b1, 0.0, zInv) / evalPolynomial(1.0, s.a1, s.a2, zInv);
+    }
+    return h;
+}
+
+// Section coefficients in structure-of-arrays form, one lane per section
+struct LaneSections {
+    alignas(64) double b0[maxLanes];
+    alignas(64) double b1[maxLanes];
+    alignas(64) double a1[maxLanes];
+    alignas(64) double a2[maxLanes];
+};
+
+template <int L>
+SESHEQ_FORCE_INLINE void runLanes(const LaneSections& c, double direct, double* z1, double* z2,
+                                  float* data, int numSamples) {
+    constexpr auto lanes = static_cast<size_t>(L);
+    alignas(64) double s1[lanes];
+    alignas(64) double s2[lanes];
+    alignas(64) double y[lanes];
+    
+    std::copy(z1, z1 + L, s1);
+    std::copy(z2, z2 + L, s2);
+    
+    for (int i = 0; i < numSamples; ++i) {
+        const double x = static_cast<double>(data[i]);
+        
+        // All sections see the same input (no dependency between lanes)
+        for (int k = 0; k < L; ++k) {
+            y[k] = c.b0[k] * x + s1[k];
+            s1[k] = c.b1[k] * x - c.a1[k] * y[k] + s2[k];
+            s2[k] = -c.a2[k] * y[k];
+        }
+        
+        // Pairwise lane sum in a fixed order
+        for (int width = L / 2; width > 0; width /= 2) {
+            for (int k = 0; k < width; ++k) {
+                y[k] += y[k + width];
+            }
+        }
+        
+        data[i] = static_cast<float>(direct * x + y[0]);
+    }
+    
+    std::copy(s1, s1 + L, z1);
+    std::copy(s2, s2 + L, z2);
+}
+
+using KernelFn = void (*)(const LaneSections&, double, double*, double*, float*, int);
+
+template <int L>
+void runDefault(const LaneSections& c, double direct, double* z1, double* z2, float* data, int numSamples) {
+    runLanes<L>(c, direct, z1, z2, data, numSamples);
+}
+
+#if SESHEQ_SIMD_X86
+template <int L>
+SESHEQ_TARGET_AVX2_FMA
+void runAVX2(const LaneSections& c, double direct, double* z1, double* z2, float* data, int numSamples) {
+    runLanes<L>(c, direct, z1, z2, data, numSamples);
+}
+#endif
+
+// Lane counts are padded to 4, 8, 16 or 32
+struct KernelTable {
+    KernelFn fn[4];
+};
+
+KernelTable selectKernels() {
+#if SESHEQ_SIMD_X86
+    const auto& caps = SIMD::getCapabilities();
+    if (caps.avx2 && caps.fma) {
+        return {{ &runAVX2<4>, &runAVX2<8>, &runAVX2<16>, &runAVX2<32> }};
+    }
+#endif
+    return {{ &runDefault<4>, &runDefault<8>, &runDefault<16>, &runDefault<32> }};
+}
+
+} // namespace
+
+//==============================================================================
+// ParallelDesign
+//==============================================================================
+
+bool ParallelDesign::matches(const int* ids, const uint32_t* revisions, int count) const {
+    if (count != numSources) return false;
+    
+    for (int k = 0; k < count; ++k) {
+        if (sourceIds[static_cast<size_t>(k)] != ids[k]
+            || sourceRevisions[static_cast<size_t>(k)] != revisions[k]) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+//==============================================================================
+// ParallelDesigner
+//==============================================================================
+
+bool ParallelDesigner::design(const int* ids, const uint32_t* revisions, const BiquadFilter::Coefficients* coefs,
+                              int numSections, ParallelDesign& d) {
+    d.valid = false;
+    d.direct = 1.0;
+    d.numSections = 0;
+    d.numSources = std::clamp(numSections, 0, ParallelDesign::maxSections);
+    
+    for (int k = 0; k < d.numSources; ++k) {
+        d.sourceIds[static_cast<size_t>(k)] = ids[k];
+        d.sourceRevisions[static_cast<size_t>(k)] = revisions[k];
+        d.sources[static_cast<size_t>(k)] = coefs[k];
+    }
+    
+    // Sections that remain after dropping pole/zero cancellations, and their poles
+    std::array<BiquadFilter::Coefficients, ParallelDesign::maxSections> active;
+    std::array<Complex, 2 * ParallelDesign::maxSections> poles;
+    std::array<int, ParallelDesign::maxSections> firstPole;
+    std::array<int, ParallelDesign::maxSections> order;
+    int numActive = 0;
+    int numPoles = 0;
+    double gain = 1.0;
+    
+    for (int k = 0; k < d.numSources; ++k) {
+        const auto& c = d.sources[static_cast<size_t>(k)];
+        
+        // Numerator = b0 * denominator (0 dB peak/shelf): just a gain
+        if (std::abs(c.b1 - c.b0 * c.a1) < coefficientEpsilon
+            && std::abs(c.b2 - c.b0 * c.a2) < coefficientEpsilon) {
+            gain *= c.b0;
+            continue;
+        }
+        
+        const auto index = static_cast<size_t>(numActive);
+        active[index] = c;
+        firstPole[index] = numPoles;
+        
+        if (std::abs(c.a2) > coefficientEpsilon) {
+            // z^2 + a1 z + a2 = 0
+            const Complex root = std::sqrt(Complex(c.a1 * c.a1 - 4.0 * c.a2, 0.0));
+            poles[static_cast<size_t>(numPoles++)] = 0.5 * (-c.a1 + root);
+            poles[static_cast<size_t>(numPoles++)] = 0.5 * (-c.a1 - root);
+            order[index] = 2;
+        } else if (std::abs(c.b2) < coefficientEpsilon) {
+            // First order: z + a1 = 0
+            poles[static_cast<size_t>(numPoles++)] = Complex(-c.a1, 0.0);
+            order[index] = 1;
+        } else {
+            // Numerator of higher order than the denominator
+            return false;
+        }
+        
+        ++numActive;
+    }
+    
+    // Conditioning: poles must be away from the origin and from each other
+    for (int i = 0; i < numPoles; ++i) {
+        const Complex p = poles[static_cast<size_t>(i)];
+        if (std::abs(p) < minPoleDistance) return false;
+        
+        for (int j = i + 1; j < numPoles; ++j) {
+            if (std::abs(p - poles[static_cast<size_t>(j)]) < minPoleDistance) return false;
+        }
+    }
+    
+    // Residues of H(w) = gain * prod B_k(w) / prod A_k(w) in w = z^-1 at w = 1/p_i
+    std::array<Complex, 2 * ParallelDesign::maxSections> residues;
+    Complex residueSum = 0.0;
+    
+    for (int i = 0; i < numPoles; ++i) {
+        const Complex p = poles[static_cast<size_t>(i)];
+        const Complex w = 1.0 / p;
+        
+        Complex num = gain;
+        for (int k = 0; k < numActive; ++k) {
+            const auto& c = active[static_cast<size_t>(k)];
+            num *= evalPolynomial(c.b0, c.b1, c.b2, w);
+        }
+        
+        Complex den = 1.0;
+        for (int j = 0; j < numPoles; ++j) {
+            if (j != i) den *= 1.0 - poles[static_cast<size_t>(j)] * w;
+        }
+        
+        residues[static_cast<size_t>(i)] = num / den;
+        residueSum += residues[static_cast<size_t>(i)];
+    }
+    
+    // H(w = 0) = direct + sum of residues
+    double h0 = gain;
+    for (int k = 0; k < numActive; ++k) {
+        h0 *= active[static_cast<size_t>(k)].b0;
+    }
+    d.direct = h0 - residueSum.real();
+    
+    // Pair the residues of each section back into a real section
+    for (int k = 0; k < numActive; ++k) {
+        const auto& c = active[static_cast<size_t>(k)];
+        const auto i = static_cast<size_t>(firstPole[static_cast<size_t>(k)]);
+        auto& s = d.sections[static_cast<size_t>(k)];
+        
+        if (order[static_cast<size_t>(k)] == 2) {
+            // rp / (1 - p w) + rq / (1 - q w) = ((rp + rq) - (rp q + rq p) w) / ((1 - p w)(1 - q w))
+            const Complex rp = residues[i], rq = residues[i + 1];
+            const Complex p = poles[i], q = poles[i + 1];
+            s = { (rp + rq).real(), -(rp * q + rq * p).real(), c.a1, c.a2 };
+        } else {
+            s = { residues[i].real(), 0.0, c.a1, 0.0 };
+        }
+    }
+    d.numSections = numActive;
+    
+    // Verify against the cascade from DC to Nyquist
+    constexpr int numChecks = 48;
+    for (int n = 0; n <= numChecks; ++n) {
+        // Denser towards DC, where EQ poles crowd together
+        const double w = 3.14159265358979323846 * std::pow(static_cast<double>(n) / numChecks, 3.0);
+        const Complex zInv = std::polar(1.0, -w);
+        const Complex expected = cascadeResponse(d, zInv);
+        
+        if (std::abs(parallelResponse(d, zInv) - expected) > maxResponseError * std::max(1.0, std::abs(expected))) {
+            return false;
+        }
+    }
+    
+    d.valid = true;
+    return true;
+}
+
+//==============================================================================
+// ParallelEngine
+//==============================================================================
+
+void ParallelEngine::setDesign(const ParallelDesign& newDesign) {
+    design = newDesign;
+    reset();
+}
+
+void ParallelEngine::reset() {
+    for (int ch = 0; ch < maxChannels; ++ch) {
+        std::fill(z1[ch], z1[ch] + ParallelDesign::maxSections, 0.0);
+        std::fill(z2[ch], z2[ch] + ParallelDesign::maxSections, 0.0);
+    }
+}
+
+void ParallelEngine::process(float* const* channels, int numChannels, int numSamples) {
+    if (!design.valid || numChannels < 1 || numSamples < 1) return;
+    
+    numChannels = std::min(numChannels, maxChannels);
+    
+    const int numActive = design.numSections;
+    const int widthIndex = numActive <= 4 ? 0 : numActive <= 8 ? 1 : numActive <= 16 ? 2 : 3;
+    const int numLanes = 4 << widthIndex;
+    
+    // Padding lanes have zero coefficients and contribute nothing
+    LaneSections lanes;
+    for (int k = 0; k < numLanes; ++k) {
+        const auto s = k < numActive ? design.sections[static_cast<size_t>(k)] : ParallelDesign::Section();
+        lanes.b0[k] = s.b0;
+        lanes.b1[k] = s.b1;
+        lanes.a1[k] = s.a1;
+        lanes.a2[k] = s.a2;
+    }
+    
+    static const KernelTable kernels = selectKernels();
+    const KernelFn kernel = kernels.fn[widthIndex];
+    
+    for (int ch = 0; ch < numChannels; ++ch) {
+        kernel(lanes, design.direct, z1[ch], z2[ch], channels[ch], numSamples);
+    }
+}
+
+} // namespace SeshEQ
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "BiquadFilter.h"
+#include "CascadeEngine.h"
+#include <array>
+#include <cstdint>
+
+namespace SeshEQ {
+
+/**
+ * @brief Parallel (partial-fraction) form of a biquad cascade
+ *
+ * H(z) = direct + sum_k (b0_k + b1_k z^-1) / (1 + a1_k z^-1 + a2_k z^-2)
+ *
+ * First-order terms use a2 = 0. The cascade the design was made from is kept so
+ * the EQ can tell whether the design still matches its current parameters:
+ * each source section is identified by its id and the revision of the
+ * coefficients it had (see BandFilter::getRevision).
+ */
+struct ParallelDesign {
+    static constexpr int maxSections = CascadeEngine::maxSections;
+    
+    struct Section {
+        double b0 = 0.0, b1 = 0.0;
+        double a1 = 0.0, a2 = 0.0;
+    };
+    
+    // False if the cascade cannot be expanded reliably (the cascade must be used)
+    bool valid = false;
+    
+    double direct = 1.0;
+    int numSections = 0;
+    std::array<Section, maxSections> sections {};
+    
+    // Source cascade (section ids, revisions and coefficients in processing order)
+    int numSources = 0;
+    std::array<int, maxSections> sourceIds {};
+    std::array<uint32_t, maxSections> sourceRevisions {};
+    std::array<BiquadFilter::Coefficients, maxSections> sources {};
+    
+    /**
+     * @brief Check whether the design was made from exactly this cascade
+     */
+    bool matches(const int* ids, const uint32_t* revisions, int numSections) const;
+};
+
+namespace ParallelDesigner {
+    
+    /**
+     * @brief Expand a cascade into parallel form
+     *
+     * Finds the poles of every section (quadratic formula), computes their
+     * residues and pairs them back into real second-order sections. Sections
+     * whose zeros cancel their poles (0 dB peaks and shelves) are dropped first.
+     * Fails for coincident or near-zero poles, or sections that are not
+     * strictly second or first order, where the expansion is ill-conditioned,
+     * and when the result does not reproduce the cascade response. Meant for a
+     * background thread; does not allocate.
+     * @return design.valid
+     */
+    bool design(const int* ids, const uint32_t* revisions, const BiquadFilter::Coefficients* coefs,
+                int numSections, ParallelDesign& design);
+
+} // namespace ParallelDesigner
+
+/**
+ * @brief Runs a ParallelDesign with all sections in SIMD lanes
+ *
+ * Every section sees the same input sample, so the sections have no dependency
+ * on each other; one step updates all lanes at full vector width and sums them.
+ */
+class ParallelEngine {
+public:
+    static constexpr int maxChannels = 2;
+    
+    ParallelEngine() = default;
+    
+    /**
+     * @brief Install a design and clear the state
+     */
+    void setDesign(const ParallelDesign& design);
+    
+    /**
+     * @brief Clear the state
+     */
+    void reset();
+    
+    /**
+     * @brief Filter in place
+     */
+    void process(float* const* channels, int numChannels, int numSamples);
+    
+    const ParallelDesign& getDesign() const { return design; }
+
+private:
+    ParallelDesign design;
+    
+    // Per-channel state per section lane
+    alignas(64) double z1[maxChannels][ParallelDesign::maxSections] = {};
+    alignas(64) double z2[maxChannels][ParallelDesign::maxSections] = {};
+};
+
+} // namespace SeshEQ
@@ -0,0 +1,391 @@
+#include "PartitionedConvolver.h"
+#include "utils/FastMath.h"
+#include <algorithm>
+#include <cmath>
+
+namespace SeshEQ {
+
+namespace {
+    
+    /**
+     * @brief Dot product over a multiple of 8 samples, eight partial sums so it vectorizes
+     */
+    float dotProduct(const float* kernel, const float* samples, int length) {
+        float acc[8] = {};
+        
+        for (int j = 0; j < length; j += 8) {
+            for (int m = 0; m < 8; ++m) {
+                acc[m] += kernel[j + m] * samples[j + m];
+            }
+        }
+        
+        return ((acc[0] + acc[4]) + (acc[1] + acc[5])) + ((acc[2] + acc[6]) + (acc[3] + acc[7]));
+    }
+
+} // namespace
+
+void PartitionedConvolver::prepare(int newHeadSize, int newMaxImpulseLength) {
+    headSize = FastMath::nextPowerOfTwo(std::max(newHeadSize, 8));
+    maxImpulseLength = std::max(newMaxImpulseLength, 1);
+    
+    headKernel.assign(static_cast<size_t>(2 * headSize), 0.0f);
+    headWindow.assign(static_cast<size_t>(2 * headSize), 0.0f);
+    
+    // Stage 0 runs at its boundary from tap headSize; every later stage starts at
+    // twice its partition size, so its block can be spread over the next one
+    stages.clear();
+    int largestPartition = headSize;
+    
+    for (int offset = headSize, size = headSize; offset < maxImpulseLength; size *= 2) {
+        const bool last = size >= maxStagePartitionSize;
+        const int end = last ? maxImpulseLength : std::min(maxImpulseLength, 4 * size);
+        
+        Stage stage;
+        stage.partitionSize = size;
+        stage.fftSize = 2 * size;
+        stage.offset = offset;
+        stage.maxPartitions = (end - offset + size - 1) / size;
+        
+        const auto fftSize = static_cast<size_t>(stage.fftSize);
+        const auto spectraSize = static_cast<size_t>(stage.maxPartitions) * fftSize;
+        
+        stage.fft.prepare(stage.fftSize);
+        stage.timeData.assign(fftSize, {});
+        stage.spectrum.assign(fftSize, {});
+        stage.filterReal.assign(2 * spectraSize, 0.0f);
+        stage.filterImag.assign(2 * spectraSize, 0.0f);
+        stage.delayLineReal.assign(spectraSize, 0.0f);
+        stage.delayLineImag.assign(spectraSize, 0.0f);
+        stage.accumulatorReal.assign(2 * fftSize, 0.0f);
+        stage.accumulatorImag.assign(2 * fftSize, 0.0f);
+        
+        stages.push_back(std::move(stage));
+        largestPartition = size;
+        offset = end;
+        
+        if (last) break;
+    }
+    
+    // A crossfade spans one cycle of the largest partition
+    crossfadeLength = largestPartition;
+    
+    scratchTime.assign(static_cast<size_t>(2 * largestPartition), {});
+    scratchSpectrum.assign(static_cast<size_t>(2 * largestPartition), {});
+    
+    // Input reaches back two partitions of the largest stage; output reaches
+    // ahead by up to the impulse length
+    const int inputLength = FastMath::nextPowerOfTwo(2 * largestPartition + 2 * headSize);
+    const int outputLength = FastMath::nextPowerOfTwo(maxImpulseLength + 2 * headSize);
+    inputLeft.assign(static_cast<size_t>(inputLength), 0.0f);
+    inputRight.assign(static_cast<size_t>(inputLength), 0.0f);
+    outputLeft.assign(static_cast<size_t>(outputLength), 0.0f);
+    outputRight.assign(static_cast<size_t>(outputLength), 0.0f);
+    inputMask = inputLength - 1;
+    outputMask = outputLength - 1;
+    
+    reset();
+}
+
+void PartitionedConvolver::reset() {
+    for (auto& stage : stages) {
+        std::fill(stage.delayLineReal.begin(), stage.delayLineReal.end(), 0.0f);
+        std::fill(stage.delayLineImag.begin(), stage.delayLineImag.end(), 0.0f);
+        stage.delayLinePosition = 0;
+        stage.running = false;
+    }
+    
+    // Nothing is left playing the old response
+    if (fading) {
+        activeSet ^= 1;
+        fading = false;
+    }
+    
+    std::fill(inputLeft.begin(), inputLeft.end(), 0.0f);
+    std::fill(inputRight.begin(), inputRight.end(), 0.0f);
+    std::fill(outputLeft.begin(), outputLeft.end(), 0.0f);
+    std::fill(outputRight.begin(), outputRight.end(), 0.0f);
+    sampleTime = 0;
+}
+
+void PartitionedConvolver::setImpulseResponse(const float* impulseResponse, int length, bool crossfade) {
+    if (headSize == 0) return;
+    
+    length = std::clamp(length, 0, maxImpulseLength);
+    
+    // A running fade is cut short: its target becomes the response in use
+    if (fading) {
+        activeSet ^= 1;
+        fading = false;
+    }
+    const int target = activeSet ^ 1;
+    
+    float* head = headKernel.data() + static_cast<size_t>(target * headSize);
+    for (int i = 0; i < headSize; ++i) {
+        head[headSize - 1 - i] = i < length ? impulseResponse[i] : 0.0f;
+    }
+    
+    for (auto& stage : stages) {
+        const int size = stage.partitionSize;
+        const int taps = std::clamp(length - stage.offset, 0, stage.maxPartitions * size);
+        const int numPartitions = (taps + size - 1) / size;
+        
+        // A stage that was idle has no input history on its delay line
+        if (stage.numPartitions[static_cast<size_t>(activeSet)] == 0 && numPartitions > 0) {
+            std::fill(stage.delayLineReal.begin(), stage.delayLineReal.end(), 0.0f);
+            std::fill(stage.delayLineImag.begin(), stage.delayLineImag.end(), 0.0f);
+        }
+        stage.numPartitions[static_cast<size_t>(target)] = numPartitions;
+        
+        const auto setOffset = static_cast<size_t>(target * stage.maxPartitions * stage.fftSize);
+        for (int p = 0; p < numPartitions; ++p) {
+            // Partition zero-padded to the FFT size (overlap-save keeps the second half)
+            const int first = stage.offset + p * size;
+            const int count = std::min(size, length - first);
+            
+            std::fill(scratchTime.begin(), scratchTime.begin() + stage.fftSize, Complex());
+            for (int i = 0; i < count; ++i) {
+                scratchTime[static_cast<size_t>(i)] = { impulseResponse[first + i], 0.0f };
+            }
+            
+            stage.fft.perform(scratchTime.data(), scratchSpectrum.data(), false);
+            
+            float* real = stage.filterReal.data() + setOffset + static_cast<size_t>(p * stage.fftSize);
+            float* imag = stage.filterImag.data() + setOffset + static_cast<size_t>(p * stage.fftSize);
+            for (int k = 0; k < stage.fftSize; ++k) {
+                real[k] = scratchSpectrum[static_cast<size_t>(k)].real();
+                imag[k] = scratchSpectrum[static_cast<size_t>(k)].imag();
+            }
+        }
+    }
+    
+    if (!crossfade) {
+        activeSet = target;
+        return;
+    }
+    
+    // Blocks already started only carry the old response, so the fade begins
+    // once the first block each stage starts from now on is due. A stage that
+    // was idle first needs a full delay line of input spectra.
+    fadeStart = sampleTime;
+    for (const auto& stage : stages) {
+        const int size = stage.partitionSize;
+        const std::int64_t nextBlock = (sampleTime / size + 1) * size;
+        const int warmUp = stage.numPartitions[static_cast<size_t>(activeSet)] == 0
+                         ? std::max(stage.numPartitions[static_cast<size_t>(target)] - 1, 0) * size
+                         : 0;
+        fadeStart = std::max(fadeStart, nextBlock + warmUp + stage.offset - size);
+    }
+    fadeEnd = fadeStart + crossfadeLength;
+    fading = true;
+}
+
+void PartitionedConvolver::process(float* left, float* right, int numSamples) {
+    if (headSize == 0) return;
+    
+    for (int done = 0; done < numSamples;) {
+        // Chunks end on every head-size boundary, where stage blocks start
+        const int position = static_cast<int>(sampleTime & (headSize - 1));
+        const int count = std::min(numSamples - done, headSize - position);
+        
+        for (int i = 0; i < count; ++i) {
+            const auto index = static_cast<size_t>((sampleTime + i) & inputMask);
+            inputLeft[index] = left[done + i];
+            inputRight[index] = right ? right[done + i] : 0.0f;
+        }
+        
+        // Head: direct form over the last headSize inputs of each sample
+        for (int ch = 0; ch < 2; ++ch) {
+            float* out = ch == 0 ? left : right;
+            if (out == nullptr) continue;
+            
+            const auto& input = ch == 0 ? inputLeft : inputRight;
+            const std::int64_t start = sampleTime - (headSize - 1);
+            for (int j = 0; j < headSize - 1 + count; ++j) {
+                headWindow[static_cast<size_t>(j)] = input[static_cast<size_t>((start + j) & inputMask)];
+            }
+            
+            const float* kernel = headKernel.data() + static_cast<size_t>(activeSet * headSize);
+            if (!fading) {
+                for (int i = 0; i < count; ++i) {
+                    out[done + i] = dotProduct(kernel, headWindow.data() + i, headSize);
+                }
+                continue;
+            }
+            
+            const float* fadeKernel = headKernel.data() + static_cast<size_t>((activeSet ^ 1) * headSize);
+            for (int i = 0; i < count; ++i) {
+                const float current = dotProduct(kernel, headWindow.data() + i, headSize);
+                const float next = dotProduct(fadeKernel, headWindow.data() + i, headSize);
+                out[done + i] = current + getFadeGain(sampleTime + i) * (next - current);
+            }
+        }
+        
+        sampleTime += count;
+        
+        // Spread stage work over the chunk
+        for (auto& stage : stages) {
+            if (stage.running) {
+                stage.elapsed += count;
+                advanceStage(stage, false);
+            }
+        }
+        
+        // Stage output due in this chunk
+        for (int i = 0; i < count; ++i) {
+            const auto index = static_cast<size_t>((sampleTime - count + i) & outputMask);
+            left[done + i] += outputLeft[index];
+            outputLeft[index] = 0.0f;
+            
+            if (right) {
+                right[done + i] += outputRight[index];
+            }
+            outputRight[index] = 0.0f;
+        }
+        
+        // Blocks from here on need only the new response
+        if (fading && sampleTime >= fadeEnd) {
+            activeSet ^= 1;
+            fading = false;
+        }
+        
+        // Start the blocks whose input is now complete
+        for (auto& stage : stages) {
+            if ((sampleTime & (stage.partitionSize - 1)) == 0) {
+                if (stage.running) {
+                    advanceStage(stage, true);
+                }
+                startStage(stage);
+            }
+        }
+        
+        done += count;
+    }
+}
+
+void PartitionedConvolver::startStage(Stage& stage) {
+    const int current = stage.numPartitions[static_cast<size_t>(activeSet)];
+    const int next = fading ? stage.numPartitions[static_cast<size_t>(activeSet ^ 1)] : 0;
+    if (current == 0 && next == 0) return;
+    
+    // Both channels as one complex signal, previous and current partition
+    const std::int64_t start = sampleTime - stage.fftSize;
+    for (int j = 0; j < stage.fftSize; ++j) {
+        const auto index = static_cast<size_t>((start + j) & inputMask);
+        stage.timeData[static_cast<size_t>(j)] = { inputLeft[index], inputRight[index] };
+    }
+    
+    stage.running = true;
+    stage.unitsDone = 0;
+    stage.elapsed = 0;
+    stage.outputTime = sampleTime + stage.offset - stage.partitionSize;
+    
+    // Old response before the fade, new one after it, both in between
+    const bool afterFade = fading && stage.outputTime >= fadeEnd;
+    stage.blockBlend = fading && !afterFade && stage.outputTime + stage.partitionSize > fadeStart;
+    stage.blockSet = afterFade ? activeSet ^ 1 : activeSet;
+    stage.blockPartitions[0] = afterFade ? next : current;
+    stage.blockPartitions[1] = stage.blockBlend ? next : 0;
+    
+    // Stage 0 is due right away
+    if (stage.offset == stage.partitionSize) {
+        advanceStage(stage, true);
+    }
+}
+
+void PartitionedConvolver::advanceStage(Stage& stage, bool finish) {
+    const int numUnits = stage.getNumUnits();
+    int due = numUnits;
+    
+    // Spread over the next partition, or less if the output is needed earlier
+    const int window = std::min(stage.offset - stage.partitionSize, stage.partitionSize);
+    if (!finish && window > 0) {
+        due = std::min(numUnits, (numUnits * stage.elapsed + window - 1) / window);
+    }
+    
+    while (stage.unitsDone < due) {
+        runStageUnit(stage, stage.unitsDone++);
+    }
+    
+    stage.running = stage.unitsDone < numUnits;
+}
+
+void PartitionedConvolver::runStageUnit(Stage& stage, int unit) {
+    const int fftSize = stage.fftSize;
+    
+    if (unit == 0) {
+        // Forward transform onto the front of the delay line
+        stage.fft.perform(stage.timeData.data(), stage.spectrum.data(), false);
+        
+        stage.delayLinePosition = (stage.delayLinePosition + stage.maxPartitions - 1) % stage.maxPartitions;
+        float* newestReal = stage.delayLineReal.data() + static_cast<size_t>(stage.delayLinePosition * fftSize);
+        float* newestImag = stage.delayLineImag.data() + static_cast<size_t>(stage.delayLinePosition * fftSize);
+        for (int k = 0; k < fftSize; ++k) {
+            newestReal[k] = stage.spectrum[static_cast<size_t>(k)].real();
+            newestImag[k] = stage.spectrum[static_cast<size_t>(k)].imag();
+        }
+        
+        std::fill(stage.accumulatorReal.begin(), stage.accumulatorReal.end(), 0.0f);
+        std::fill(stage.accumulatorImag.begin(), stage.accumulatorImag.end(), 0.0f);
+        return;
+    }
+    
+    if (unit < stage.getNumUnits() - 1) {
+        // Input p blocks ago times partition p, for each response set of the block
+        const int p = unit - 1;
+        const int slot = (stage.delayLinePosition + p) % stage.maxPartitions;
+        const float* xReal = stage.delayLineReal.data() + static_cast<size_t>(slot * fftSize);
+        const float* xImag = stage.delayLineImag.data() + static_cast<size_t>(slot * fftSize);
+        
+        for (int a = 0; a < 2; ++a) {
+            if (p >= stage.blockPartitions[static_cast<size_t>(a)]) continue;
+            
+            const int set = stage.blockSet ^ a;
+            const auto filterOffset = static_cast<size_t>((set * stage.maxPartitions + p) * fftSize);
+            const float* hReal = stage.filterReal.data() + filterOffset;
+            const float* hImag = stage.filterImag.data() + filterOffset;
+            float* accReal = stage.accumulatorReal.data() + static_cast<size_t>(a * fftSize);
+            float* accImag = stage.accumulatorImag.data() + static_cast<size_t>(a * fftSize);
+            
+            for (int k = 0; k < fftSize; ++k) {
+                accReal[k] += xReal[k] * hReal[k] - xImag[k] * hImag[k];
+                accImag[k] += xReal[k] * hImag[k] + xImag[k] * hReal[k];
+            }
+        }
+        return;
+    }
+    
+    // Overlap-save: the second half of each inverse transform is the linear
+    // convolution, due from outputTime; blending blocks ramp between the sets
+    const int half = stage.partitionSize;
+    for (int a = 0; a < (stage.blockBlend ? 2 : 1); ++a) {
+        const float* accReal = stage.accumulatorReal.data() + static_cast<size_t>(a * fftSize);
+        const float* accImag = stage.accumulatorImag.data() + static_cast<size_t>(a * fftSize);
+        for (int k = 0; k < fftSize; ++k) {
+            stage.spectrum[static_cast<size_t>(k)] = { accReal[k], accImag[k] };
+        }
+        
+        // The inverse transform is scaled by 1 / fftSize
+        stage.fft.perform(stage.spectrum.data(), stage.timeData.data(), true);
+        
+        for (int i = 0; i < half; ++i) {
+            const std::int64_t time = stage.outputTime + i;
+            const auto index = static_cast<size_t>(time & outputMask);
+            const auto& value = stage.timeData[static_cast<size_t>(half + i)];
+            
+            float gain = 1.0f;
+            if (stage.blockBlend) {
+                gain = a == 0 ? 1.0f - getFadeGain(time) : getFadeGain(time);
+            }
+            
+            outputLeft[index] += gain * value.real();
+            outputRight[index] += gain * value.imag();
+        }
+    }
+}
+
+float PartitionedConvolver::getFadeGain(std::int64_t time) const {
+    const auto position = static_cast<float>(time - fadeStart) / static_cast<float>(crossfadeLength);
+    return std::clamp(position, 0.0f, 1.0f);
+}
+
+} // namespace SeshEQ
@@ -0,0 +1,174 @@
+#pragma once
+
+#include "ComplexFFT.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace SeshEQ {
+
+/**
+ * @brief Stereo FIR convolution without added latency, non-uniformly partitioned
+ *
+ * The impulse response is split into a head and stages of growing partition
+ * size:
+ * - the head (first headSize taps) runs as a direct-form FIR, sample by sample
+ * - stage 0 covers taps [headSize, 4 * headSize) with partitions of headSize
+ * - stage k covers taps [2 * N, 4 * N) with partitions of N = headSize * 2^k;
+ *   the last stage takes every remaining tap
+ *
+ * Each stage is uniformly partitioned overlap-save: every N input samples, the
+ * last 2N samples are transformed once onto a frequency-domain delay line,
+ * multiplied with the partition spectra, summed and transformed back. A stage
+ * starting at tap 2N is not needed until N samples after its input block is
+ * complete, so its work (forward FFT, one multiply-add per partition, inverse
+ * FFT) is spread evenly over the next N samples instead of landing in one
+ * callback. Only stage 0 runs at its block boundary. The per-callback cost
+ * therefore stays flat at small host buffer sizes, and the output carries only
+ * the FIR's own delay.
+ *
+ * Both channels share the (real) impulse response, so they travel as one
+ * complex signal L + jR: one complex FFT carries the pair, and after the
+ * inverse transform the real part is the left and the imaginary part the
+ * right output. All storage is allocated in prepare().
+ *
+ * Every stage holds two sets of partition spectra. A crossfaded swap writes
+ * the new response into the idle set and, for one cycle of the largest
+ * partition, runs both sets against the same input spectra on the delay
+ * lines: each block accumulates both products and blends the two outputs with
+ * a linear ramp in output time. The fade costs the extra multiply-adds and
+ * inverse transforms, never another forward transform of the input.
+ */
+class PartitionedConvolver {
+public:
+    PartitionedConvolver() = default;
+    
+    /**
+     * @brief Lay out the head and stages, allocate spectra and buffers
+     * @param headSize Direct-form taps and smallest partition (power of two, >= 8)
+     * @param maxImpulseLength Longest impulse response setImpulseResponse() accepts
+     */
+    void prepare(int headSize, int maxImpulseLength);
+    
+    /**
+     * @brief Clear the input history, the delay lines and pending output
+     */
+    void reset();
+    
+    /**
+     * @brief Install a new impulse response
+     *
+     * Transforms the stage partitions into the idle set; does not allocate. The
+     * input history is kept. Without crossfade the new response takes over
+     * with the next block of each stage. A swap during a crossfade cuts the
+     * running fade short, so wait for isCrossfading() to clear first.
+     * @param length Up to the maxImpulseLength given to prepare() (longer is cut)
+     * @param crossfade Fade from the current response over getCrossfadeLength()
+     *        samples, starting once every stage has a block on both responses
+     */
+    void setImpulseResponse(const float* impulseResponse, int length, bool crossfade = false);
+    
+    bool isCrossfading() const { return fading; }
+    
+    int getCrossfadeLength() const { return crossfadeLength; }
+    
+    /**
+     * @brief Convolve in place (no added latency)
+     * @param right May be nullptr for mono
+     */
+    void process(float* left, float* right, int numSamples);
+    
+    int getNumStages() const { return static_cast<int>(stages.size()); }
+
+private:
+    using Complex = ComplexFFT::Complex;
+    
+    // Largest stage partition; the last stage holds all partitions from there on
+    static constexpr int maxStagePartitionSize = 4096;
+    
+    struct Stage {
+        int partitionSize = 0;
+        int fftSize = 0;
+        int offset = 0;          // First tap covered
+        int maxPartitions = 0;
+        std::array<int, 2> numPartitions {};  // Partitions of each response set
+        
+        ComplexFFT fft;
+        std::vector<Complex> timeData;
+        std::vector<Complex> spectrum;
+        
+        // Partition spectra (2 sets x maxPartitions x fftSize, split
+        // real/imaginary so the accumulation vectorizes)
+        std::vector<float> filterReal;
+        std::vector<float> filterImag;
+        
+        // Input spectra of the last maxPartitions blocks, newest at delayLinePosition
+        std::vector<float> delayLineReal;
+        std::vector<float> delayLineImag;
+        int delayLinePosition = 0;
+        
+        // One fftSize accumulator per response set of a block
+        std::vector<float> accumulatorReal;
+        std::vector<float> accumulatorImag;
+        
+        // Block in progress: forward FFT, one unit per partition, inverse FFT.
+        // A blending block runs blockSet and the other set side by side.
+        bool running = false;
+        int blockSet = 0;
+        bool blockBlend = false;
+        std::array<int, 2> blockPartitions {};
+        int unitsDone = 0;
+        int elapsed = 0;
+        std::int64_t outputTime = 0;
+        
+        int getNumUnits() const { return std::max(blockPartitions[0], blockPartitions[1]) + 2; }
+    };
+    
+    /**
+     * @brief Take the last 2N input samples and start a stage block
+     */
+    void startStage(Stage& stage);
+    
+    /**
+     * @brief Run the units of a stage block that are due by now
+     */
+    void advanceStage(Stage& stage, bool finish);
+    
+    void runStageUnit(Stage& stage, int unit);
+    
+    /**
+     * @brief Share of the new response at an output time during a crossfade
+     */
+    float getFadeGain(std::int64_t time) const;
+    
+    int headSize = 0;
+    int maxImpulseLength = 0;
+    std::vector<float> headKernel;  // Reversed head taps, one set after the other
+    std::vector<float> headWindow;  // Contiguous input for the head dot products
+    
+    std::vector<Stage> stages;
+    
+    // Partition transforms in setImpulseResponse (a running block owns its stage buffers)
+    std::vector<Complex> scratchTime;
+    std::vector<Complex> scratchSpectrum;
+    
+    // Input and pending stage output, indexed by sampleTime & mask
+    std::vector<float> inputLeft;
+    std::vector<float> inputRight;
+    int inputMask = 0;
+    std::vector<float> outputLeft;
+    std::vector<float> outputRight;
+    int outputMask = 0;
+    
+    std::int64_t sampleTime = 0;
+    
+    // Response set in use; during a fade the other set is fading in
+    int activeSet = 0;
+    bool fading = false;
+    std::int64_t fadeStart = 0;
+    std::int64_t fadeEnd = 0;
+    int crossfadeLength = 0;
+};
+
+} // namespace SeshEQ
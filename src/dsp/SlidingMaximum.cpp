@@ -0,0 +1,34 @@
+#include "SlidingMaximum.h"
+#include <algorithm>
+
+namespace SeshEQ {
+
+void SlidingMaximum::prepare(int newMaxLength) {
+    maxLength = std::max(newMaxLength, 1);
+    
+    // Power of two for the ring index mask; the deque never holds more than maxLength
+    uint32_t capacity = 1;
+    while (capacity < static_cast<uint32_t>(maxLength)) {
+        capacity <<= 1;
+    }
+    
+    values.assign(capacity, 0.0f);
+    positions.assign(capacity, 0);
+    mask = capacity - 1;
+    
+    length = std::min(length, maxLength);
+    reset();
+}
+
+void SlidingMaximum::reset() {
+    head = 0;
+    count = 0;
+    position = 0;
+}
+
+void SlidingMaximum::setLength(int newLength) {
+    length = std::clamp(newLength, 1, std::max(maxLength, 1));
+    reset();
+}
+
+} // namespace SeshEQ
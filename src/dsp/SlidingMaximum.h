@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace SeshEQ {
+
+/**
+ * @brief Running maximum over the last N inputs in O(1) per sample
+ *
+ * A monotonic deque keeps only the inputs that can still become the
+ * maximum: each new input drops the smaller ones queued before it, and the
+ * front leaves once it is N samples old. Every input is queued and dropped
+ * at most once, so the cost per sample is constant however long the window.
+ * The deque is a ring buffer allocated in prepare().
+ */
+class SlidingMaximum {
+public:
+    SlidingMaximum() = default;
+    
+    /**
+     * @brief Allocate for windows of up to maxLength samples
+     */
+    void prepare(int maxLength);
+    
+    /**
+     * @brief Forget all inputs (the maximum restarts from the next one)
+     */
+    void reset();
+    
+    /**
+     * @brief Set the window length (clamped to 1..maxLength; resets)
+     */
+    void setLength(int newLength);
+    
+    int getLength() const { return length; }
+    
+    /**
+     * @brief Add one input and return the maximum of the last length inputs
+     */
+    float process(float input) {
+        // The front leaves once the new input pushes it out of the window
+        // (unsigned wrap keeps the age right after the counter overflows)
+        if (count > 0 && position - positions[head] >= static_cast<uint32_t>(length)) {
+            head = (head + 1) & mask;
+            --count;
+        }
+        
+        // Inputs no larger than the new one can never be the maximum again
+        while (count > 0 && values[(head + count - 1) & mask] <= input) {
+            --count;
+        }
+        
+        const uint32_t back = (head + count) & mask;
+        values[back] = input;
+        positions[back] = position;
+        ++count;
+        
+        ++position;
+        return values[head];
+    }
+
+private:
+    int length = 1;
+    int maxLength = 0;
+    
+    // Deque: count entries from head, decreasing in value, oldest first
+    std::vector<float> values;
+    std::vector<uint32_t> positions;
+    uint32_t mask = 0;
+    uint32_t head = 0;
+    uint32_t count = 0;
+    uint32_t position = 0;  // Index of the next input
+};
+
+} // namespace SeshEQ
@@ -0,0 +1,162 @@
+#include "StateVariableFilter.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+namespace SeshEQ {
+
+namespace {
+
+constexpr double pi = 3.14159265358979323846;
+
+// Per-sample step of the mix and integrator coefficients
+struct SVFRamp {
+    double g, k, m0, m1, m2;
+    double dg, dk, dm0, dm1, dm2;
+    
+    SVFRamp(const SVFCoefficients& start, const SVFCoefficients& end, int numSamples) {
+        const double inv = 1.0 / static_cast<double>(numSamples);
+        g = start.g;   dg = (end.g - start.g) * inv;
+        k = start.k;   dk = (end.k - start.k) * inv;
+        m0 = start.m0; dm0 = (end.m0 - start.m0) * inv;
+        m1 = start.m1; dm1 = (end.m1 - start.m1) * inv;
+        m2 = start.m2; dm2 = (end.m2 - start.m2) * inv;
+    }
+};
+
+template <bool Ramped>
+void runSVF(SVFRamp c, double* ic1, double* ic2, float* const* channels, int numChannels, int numSamples) {
+    double a1 = 1.0 / (1.0 + c.g * (c.g + c.k));
+    double a2 = c.g * a1;
+    double a3 = c.g * a2;
+    
+    for (int i = 0; i < numSamples; ++i) {
+        if (Ramped) {
+            c.g += c.dg; c.k += c.dk;
+            c.m0 += c.dm0; c.m1 += c.dm1; c.m2 += c.dm2;
+            
+            a1 = 1.0 / (1.0 + c.g * (c.g + c.k));
+            a2 = c.g * a1;
+            a3 = c.g * a2;
+        }
+        
+        for (int ch = 0; ch < numChannels; ++ch) {
+            const double x = static_cast<double>(channels[ch][i]);
+            
+            // Trapezoidal integration of both integrators, solved without delay
+            const double v3 = x - ic2[ch];
+            const double v1 = a1 * ic1[ch] + a2 * v3;
+            const double v2 = ic2[ch] + a2 * ic1[ch] + a3 * v3;
+            ic1[ch] = 2.0 * v1 - ic1[ch];
+            ic2[ch] = 2.0 * v2 - ic2[ch];
+            
+            channels[ch][i] = static_cast<float>(c.m0 * x + c.m1 * v1 + c.m2 * v2);
+        }
+    }
+}
+
+} // namespace
+
+SVFCoefficients StateVariableFilter::design(FilterType type, double frequency, double q, double gainDb,
+                                            double sampleRate) {
+    const double freq = std::clamp(frequency, 10.0, sampleRate * 0.499);
+    const double g = std::tan(pi * freq / sampleRate);
+    const double k = 1.0 / std::max(0.01, q);
+    
+    // A = 10^(gain/40), as in the cookbook
+    const double A = std::pow(10.0, std::clamp(gainDb, -1000.0, 1000.0) / 40.0);
+    
+    switch (type) {
+        case FilterType::LowPass:
+            return { g, k, 0.0, 0.0, 1.0 };
+        
+        case FilterType::HighPass:
+            return { g, k, 1.0, -k, -1.0 };
+        
+        case FilterType::BandPass:
+            // Constant 0 dB peak gain, like the cookbook band-pass in use
+            return { g, k, 0.0, k, 0.0 };
+        
+        case FilterType::Notch:
+            return { g, k, 1.0, -k, 0.0 };
+        
+        case FilterType::Peak: {
+            // Damping 1 / (A Q), the band-pass mix lifts the peak to A^2
+            const double kPeak = k / A;
+            return { g, kPeak, 1.0, kPeak * (A * A - 1.0), 0.0 };
+        }
+        
+        case FilterType::LowShelf:
+            // Cutoff moved by 1 / sqrt(A) so the shelf midpoint stays at the frequency
+            return { g / std::sqrt(A), k, 1.0, k * (A - 1.0), A * A - 1.0 };
+        
+        case FilterType::HighShelf:
+            return { g * std::sqrt(A), k, A * A, k * (1.0 - A) * A, 1.0 - A * A };
+        
+        case FilterType::AllPass:
+        default:
+            return { g, k, 1.0, -2.0 * k, 0.0 };
+    }
+}
+
+void StateVariableFilter::prepare(double newSampleRate) {
+    sampleRate = newSampleRate;
+    target = design(currentType, currentFreq, currentQ, currentGain, sampleRate);
+    applied = target;
+    reset();
+}
+
+void StateVariableFilter::reset() {
+    ic1.fill(0.0);
+    ic2.fill(0.0);
+}
+
+void StateVariableFilter::setParameters(FilterType type, float frequency, float q, float gainDb) {
+    currentType = type;
+    currentFreq = frequency;
+    currentQ = q;
+    currentGain = gainDb;
+    target = design(type, frequency, q, gainDb, sampleRate);
+}
+
+void StateVariableFilter::setDesignedParameters(FilterType type, float frequency, float q, float gainDb,
+                                                const SVFCoefficients& coefs) {
+    currentType = type;
+    currentFreq = frequency;
+    currentQ = q;
+    currentGain = gainDb;
+    target = coefs;
+}
+
+void StateVariableFilter::processBlock(float* leftData, float* rightData, int numSamples) {
+    if (numSamples < 1) return;
+    
+    float* channels[maxChannels] = { leftData, rightData };
+    const int numChannels = rightData != nullptr ? 2 : 1;
+    
+    applied = target;
+    runSVF<false>(SVFRamp(target, target, numSamples), ic1.data(), ic2.data(), channels, numChannels, numSamples);
+}
+
+void StateVariableFilter::processBlockRamped(float* leftData, float* rightData, int numSamples) {
+    if (numSamples < 1) return;
+    
+    float* channels[maxChannels] = { leftData, rightData };
+    const int numChannels = rightData != nullptr ? 2 : 1;
+    
+    runSVF<true>(SVFRamp(applied, target, numSamples), ic1.data(), ic2.data(), channels, numChannels, numSamples);
+    applied = target;
+}
+
+float StateVariableFilter::getMagnitudeAtFrequency(float frequency) const {
+    // Bilinear frequency warping: the digital response at f is the analog
+    // prototype at s = j tan(pi f / fs) / g
+    const double omega = std::tan(pi * std::min(static_cast<double>(frequency), sampleRate * 0.4999) / sampleRate);
+    const std::complex<double> s(0.0, omega / target.g);
+    const std::complex<double> den = s * s + target.k * s + 1.0;
+    
+    const std::complex<double> h = target.m0 + (target.m1 * s + target.m2) / den;
+    return static_cast<float>(std::abs(h));
+}
+
+} // namespace SeshEQ
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "BiquadFilter.h"
+#include <array>
+
+namespace SeshEQ {
+
+/**
+ * @brief Which filter realization a processor runs its bands on
+ */
+enum class FilterEngine {
+    Biquad = 0,     // TDF-II biquads with cookbook coefficients (default)
+    StateVariable   // Trapezoidal (TPT) state-variable filters
+};
+
+/**
+ * @brief Coefficients of a trapezoidal state-variable filter
+ *
+ * g = tan(pi * fc / fs) is the integrator gain, k = 1 / Q the damping, and
+ * the output mixes input, band-pass and low-pass states:
+ *   y = m0 * x + m1 * v1 + m2 * v2
+ * a1..a3 follow from g and k and are recomputed whenever g or k change.
+ */
+struct SVFCoefficients {
+    double g = 0.0, k = 2.0;
+    double m0 = 1.0, m1 = 0.0, m2 = 0.0;
+};
+
+/**
+ * @brief Topology-preserving state-variable filter (Simper/Zavalishin form)
+ *
+ * Realizes the same transfer functions as the cookbook biquads for every
+ * FilterType (both are bilinear transforms prewarped at the cutoff), but its
+ * states are integrator outputs instead of polynomial remainders:
+ * - Any positive g and k give a stable filter, so coefficients can be
+ *   interpolated sample by sample without redesigning (and without the
+ *   transients a TDF-II biquad shows under fast modulation)
+ * - Low cutoffs at very high sample rates keep their precision (g gets small,
+ *   where biquad coefficients crowd towards a1 = -2, a2 = 1)
+ *
+ * Processes up to two channels with shared coefficients.
+ */
+class StateVariableFilter {
+public:
+    static constexpr int maxChannels = 2;
+    
+    StateVariableFilter() = default;
+    
+    /**
+     * @brief Design coefficients for a FilterType (cookbook-equivalent)
+     */
+    static SVFCoefficients design(FilterType type, double frequency, double q, double gainDb,
+                                  double sampleRate);
+    
+    void prepare(double sampleRate);
+    
+    /**
+     * @brief Clear the filter state
+     */
+    void reset();
+    
+    /**
+     * @brief Set the target parameters
+     *
+     * processBlock jumps to them; processBlockRamped glides to them.
+     */
+    void setParameters(FilterType type, float frequency, float q, float gainDb = 0.0f);
+    
+    /**
+     * @brief Set the target parameters together with coefficients designed
+     *        elsewhere (e.g. a point along a ramp); they must match the parameters
+     */
+    void setDesignedParameters(FilterType type, float frequency, float q, float gainDb,
+                               const SVFCoefficients& coefs);
+    
+    /**
+     * @brief Filter in place with the target coefficients
+     * @param rightData May be nullptr for mono
+     */
+    void processBlock(float* leftData, float* rightData, int numSamples);
+    
+    /**
+     * @brief Filter in place, interpolating g, k and the mix from the
+     *        coefficients the previous block ended on to the target
+     *
+     * The target is reached on the last sample. Costs one division per sample
+     * on top of processBlock; the filter stays stable throughout.
+     * @param rightData May be nullptr for mono
+     */
+    void processBlockRamped(float* leftData, float* rightData, int numSamples);
+    
+    /**
+     * @brief Magnitude response of the target design
+     */
+    float getMagnitudeAtFrequency(float frequency) const;
+    
+    const SVFCoefficients& getCoefficients() const { return target; }
+    
+    FilterType getType() const { return currentType; }
+    float getFrequency() const { return currentFreq; }
+    float getQ() const { return currentQ; }
+    float getGain() const { return currentGain; }
+
+private:
+    double sampleRate = 44100.0;
+    
+    FilterType currentType = FilterType::Peak;
+    float currentFreq = 1000.0f;
+    float currentQ = 0.707f;
+    float currentGain = 0.0f;
+    
+    SVFCoefficients target;
+    
+    // Coefficients the last processed sample ran on (start of the next ramp)
+    SVFCoefficients applied;
+    
+    // Integrator states per channel
+    std::array<double, maxChannels> ic1 {};
+    std::array<double, maxChannels> ic2 {};
+};
+
+} // namespace SeshEQ
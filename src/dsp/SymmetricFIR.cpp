@@ -0,0 +1,84 @@
+#include "SymmetricFIR.h"
+#include <algorithm>
+
+namespace SeshEQ {
+
+void SymmetricFIR::prepare(int newMaxLength) {
+    maxLength = std::max(newMaxLength, 1) | 1;
+    historyLength = maxLength - 1;
+    
+    halfKernel.assign(static_cast<size_t>((maxLength + 1) / 2), 0.0f);
+    history.assign(static_cast<size_t>(maxChannels * historyLength), 0.0f);
+    window.assign(static_cast<size_t>(historyLength + chunkSize), 0.0f);
+    accumulator.assign(static_cast<size_t>(chunkSize), 0.0f);
+    
+    // Identity until a kernel is installed
+    length = 1;
+    halfKernel[0] = 1.0f;
+}
+
+void SymmetricFIR::reset() {
+    std::fill(history.begin(), history.end(), 0.0f);
+}
+
+void SymmetricFIR::setImpulseResponse(const float* impulseResponse, int newLength) {
+    if (maxLength == 0) return;
+    
+    // maxLength is odd, so rounding up to odd stays within it
+    length = std::clamp(newLength, 1, maxLength) | 1;
+    
+    const int half = (length + 1) / 2;
+    for (int m = 0; m < half; ++m) {
+        halfKernel[static_cast<size_t>(m)] = impulseResponse[m];
+    }
+}
+
+void SymmetricFIR::process(float* const* channels, int numChannels, int numSamples) {
+    if (maxLength == 0) return;
+    
+    const int middle = (length - 1) / 2;
+    const int tail = length - 1;
+    const float* h = halfKernel.data();
+    float* w = window.data();
+    float* acc = accumulator.data();
+    
+    for (int ch = 0; ch < std::min(numChannels, maxChannels); ++ch) {
+        float* data = channels[ch];
+        float* past = history.data() + static_cast<size_t>(ch * historyLength);
+        
+        for (int start = 0; start < numSamples; start += chunkSize) {
+            const int count = std::min(chunkSize, numSamples - start);
+            float* x = data + start;
+            
+            // The kernel's reach of history, then the chunk
+            std::copy(past + historyLength - tail, past + historyLength, w);
+            std::copy(x, x + count, w + tail);
+            
+            if (count >= historyLength) {
+                std::copy(x + count - historyLength, x + count, past);
+            } else {
+                std::copy(past + count, past + historyLength, past);
+                std::copy(x, x + count, past + historyLength - count);
+            }
+            
+            // Centre tap, then one multiply per mirrored pair
+            for (int i = 0; i < count; ++i) {
+                acc[i] = h[middle] * w[i + middle];
+            }
+            
+            for (int m = 0; m < middle; ++m) {
+                const float tap = h[m];
+                const float* newer = w + tail - m;
+                const float* older = w + m;
+                
+                for (int i = 0; i < count; ++i) {
+                    acc[i] += tap * (newer[i] + older[i]);
+                }
+            }
+            
+            std::copy(acc, acc + count, x);
+        }
+    }
+}
+
+} // namespace SeshEQ
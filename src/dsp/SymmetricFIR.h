@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vector>
+
+namespace SeshEQ {
+
+/**
+ * @brief Direct-form convolution with a symmetric (linear-phase) FIR
+ *
+ * For an odd length N = 2M + 1 with h[n] = h[N - 1 - n], the output is
+ *   y[n] = h[M] x[n - M] + sum_{m < M} h[m] (x[n - m] + x[n - (N - 1 - m)])
+ * so each pair of mirrored taps costs one multiply: M + 1 per sample instead
+ * of N. The inner loop runs over a chunk of outputs for each tap, so both
+ * input reads move forward and vectorize.
+ *
+ * Meant for short kernels, where a partitioned FFT convolution does not pay
+ * off. The input history always covers the longest kernel, so a new kernel
+ * (of any length) takes over seamlessly. All storage is allocated in prepare().
+ */
+class SymmetricFIR {
+public:
+    static constexpr int maxChannels = 2;
+    
+    SymmetricFIR() = default;
+    
+    /**
+     * @brief Allocate the history for kernels of up to maxLength taps (rounded up to odd)
+     */
+    void prepare(int maxLength);
+    
+    /**
+     * @brief Clear the input history
+     */
+    void reset();
+    
+    /**
+     * @brief Install a symmetric kernel (identity until the first call)
+     * @param length Odd, up to the prepared maximum; only the first half
+     *        (length + 1) / 2 taps are read
+     */
+    void setImpulseResponse(const float* impulseResponse, int length);
+    
+    int getLength() const { return length; }
+    
+    int getLatency() const { return (length - 1) / 2; }
+    
+    /**
+     * @brief Filter in place
+     */
+    void process(float* const* channels, int numChannels, int numSamples);
+
+private:
+    // Outputs computed per pass over the kernel
+    static constexpr int chunkSize = 64;
+    
+    int maxLength = 0;
+    int historyLength = 0;  // maxLength - 1
+    int length = 1;
+    
+    std::vector<float> halfKernel;  // h[0..M]
+    std::vector<float> history;     // Last historyLength inputs per channel, oldest first
+    std::vector<float> window;      // length - 1 history samples followed by one chunk
+    std::vector<float> accumulator;
+};
+
+} // namespace SeshEQ
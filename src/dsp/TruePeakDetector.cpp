@@ -0,0 +1,225 @@
+#include "TruePeakDetector.h"
+#include "utils/SIMDSupport.h"
+#include <algorithm>
+#include <cmath>
+
+namespace SeshEQ {
+
+namespace {
+
+// ITU-R BS.1770-4 Annex 2, phases 0 and 1; phases 2 and 3 are their mirror images
+constexpr float phase0[TruePeakDetector::tapsPerPhase] = {
+    0.0017089843750f, 0.0109863281250f, -0.0196533203125f, 0.0332031250000f,
+    -0.0594482421875f, 0.1373291015625f, 0.9721679687500f, -0.1022949218750f,
+    0.0476074218750f, -0.0266113281250f, 0.0148925781250f, -0.0083007812500f
+};
+
+constexpr float phase1[TruePeakDetector::tapsPerPhase] = {
+    -0.0291748046875f, 0.0292968750000f, -0.0517578125000f, 0.0891113281250f,
+    -0.1665039062500f, 0.4650878906250f, 0.7797851562500f, -0.2003173828125f,
+    0.1015625000000f, -0.0582275390625f, 0.0330810546875f, -0.0189208984375f
+};
+
+constexpr int numLanes = TruePeakDetector::maxChannels * TruePeakDetector::numPhases;
+constexpr int historyLength = TruePeakDetector::tapsPerPhase - 1;
+
+using Taps = float[TruePeakDetector::tapsPerPhase][numLanes];
+
+// Largest interpolated magnitude of every input, one input at a time (tails, builds without SIMD)
+void interpolateScalar(const Taps& coefficients, const float* left, const float* right, float* peaks, int count) {
+    for (int i = 0; i < count; ++i) {
+        float peak = 0.0f;
+        
+        for (int lane = 0; lane < numLanes; ++lane) {
+            const float* x = (lane < TruePeakDetector::numPhases ? left : right) + historyLength + i;
+            float y = 0.0f;
+            for (int t = 0; t < TruePeakDetector::tapsPerPhase; ++t) {
+                y += coefficients[t][lane] * x[-t];
+            }
+            peak = std::max(peak, std::abs(y));
+        }
+        
+        peaks[i] = peak;
+    }
+}
+
+#if SESHEQ_SIMD_X86
+// Each tap loads four consecutive inputs once and feeds all four phases of the channel
+void interpolateSSE2(const Taps& coefficients, const float* left, const float* right, float* peaks, int count) {
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    int i = 0;
+    
+    for (; i + 4 <= count; i += 4) {
+        __m128 peak = _mm_setzero_ps();
+        
+        for (int ch = 0; ch < TruePeakDetector::maxChannels; ++ch) {
+            const float* x = (ch == 0 ? left : right) + historyLength + i;
+            const int lane = ch * TruePeakDetector::numPhases;
+            __m128 y0 = _mm_setzero_ps();
+            __m128 y1 = _mm_setzero_ps();
+            __m128 y2 = _mm_setzero_ps();
+            __m128 y3 = _mm_setzero_ps();
+            
+            for (int t = 0; t < TruePeakDetector::tapsPerPhase; ++t) {
+                const __m128 xt = _mm_loadu_ps(x - t);
+                const float* h = coefficients[t] + lane;
+                y0 = _mm_add_ps(y0, _mm_mul_ps(_mm_set1_ps(h[0]), xt));
+                y1 = _mm_add_ps(y1, _mm_mul_ps(_mm_set1_ps(h[1]), xt));
+                y2 = _mm_add_ps(y2, _mm_mul_ps(_mm_set1_ps(h[2]), xt));
+                y3 = _mm_add_ps(y3, _mm_mul_ps(_mm_set1_ps(h[3]), xt));
+            }
+            
+            peak = _mm_max_ps(peak, _mm_max_ps(_mm_max_ps(_mm_andnot_ps(signMask, y0), _mm_andnot_ps(signMask, y1)),
+                                               _mm_max_ps(_mm_andnot_ps(signMask, y2), _mm_andnot_ps(signMask, y3))));
+        }
+        
+        _mm_storeu_ps(peaks + i, peak);
+    }
+    
+    interpolateScalar(coefficients, left + i, right + i, peaks + i, count - i);
+}
+
+SESHEQ_TARGET_AVX
+void interpolateAVX(const Taps& coefficients, const float* left, const float* right, float* peaks, int count) {
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    int i = 0;
+    
+    for (; i + 8 <= count; i += 8) {
+        __m256 peak = _mm256_setzero_ps();
+        
+        for (int ch = 0; ch < TruePeakDetector::maxChannels; ++ch) {
+            const float* x = (ch == 0 ? left : right) + historyLength + i;
+            const int lane = ch * TruePeakDetector::numPhases;
+            __m256 y0 = _mm256_setzero_ps();
+            __m256 y1 = _mm256_setzero_ps();
+            __m256 y2 = _mm256_setzero_ps();
+            __m256 y3 = _mm256_setzero_ps();
+            
+            for (int t = 0; t < TruePeakDetector::tapsPerPhase; ++t) {
+                const __m256 xt = _mm256_loadu_ps(x - t);
+                const float* h = coefficients[t] + lane;
+                y0 = _mm256_add_ps(y0, _mm256_mul_ps(_mm256_set1_ps(h[0]), xt));
+                y1 = _mm256_add_ps(y1, _mm256_mul_ps(_mm256_set1_ps(h[1]), xt));
+                y2 = _mm256_add_ps(y2, _mm256_mul_ps(_mm256_set1_ps(h[2]), xt));
+                y3 = _mm256_add_ps(y3, _mm256_mul_ps(_mm256_set1_ps(h[3]), xt));
+            }
+            
+            peak = _mm256_max_ps(peak, _mm256_max_ps(_mm256_max_ps(_mm256_andnot_ps(signMask, y0),
+                                                                   _mm256_andnot_ps(signMask, y1)),
+                                                     _mm256_max_ps(_mm256_andnot_ps(signMask, y2),
+                                                                   _mm256_andnot_ps(signMask, y3))));
+        }
+        
+        _mm256_storeu_ps(peaks + i, peak);
+    }
+    
+    interpolateSSE2(coefficients, left + i, right + i, peaks + i, count - i);
+}
+#endif
+
+#if SESHEQ_SIMD_NEON
+void interpolateNEON(const Taps& coefficients, const float* left, const float* right, float* peaks, int count) {
+    int i = 0;
+    
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t peak = vdupq_n_f32(0.0f);
+        
+        for (int ch = 0; ch < TruePeakDetector::maxChannels; ++ch) {
+            const float* x = (ch == 0 ? left : right) + historyLength + i;
+            const int lane = ch * TruePeakDetector::numPhases;
+            float32x4_t y0 = vdupq_n_f32(0.0f);
+            float32x4_t y1 = vdupq_n_f32(0.0f);
+            float32x4_t y2 = vdupq_n_f32(0.0f);
+            float32x4_t y3 = vdupq_n_f32(0.0f);
+            
+            for (int t = 0; t < TruePeakDetector::tapsPerPhase; ++t) {
+                const float32x4_t xt = vld1q_f32(x - t);
+                const float* h = coefficients[t] + lane;
+                y0 = vmlaq_n_f32(y0, xt, h[0]);
+                y1 = vmlaq_n_f32(y1, xt, h[1]);
+                y2 = vmlaq_n_f32(y2, xt, h[2]);
+                y3 = vmlaq_n_f32(y3, xt, h[3]);
+            }
+            
+            peak = vmaxq_f32(peak, vmaxq_f32(vmaxq_f32(vabsq_f32(y0), vabsq_f32(y1)),
+                                             vmaxq_f32(vabsq_f32(y2), vabsq_f32(y3))));
+        }
+        
+        vst1q_f32(peaks + i, peak);
+    }
+    
+    interpolateScalar(coefficients, left + i, right + i, peaks + i, count - i);
+}
+#endif
+
+using InterpolateFn = void (*)(const Taps&, const float*, const float*, float*, int);
+
+InterpolateFn selectInterpolate() {
+#if SESHEQ_SIMD_X86
+    return SIMD::getCapabilities().avx ? &interpolateAVX : &interpolateSSE2;
+#elif SESHEQ_SIMD_NEON
+    return &interpolateNEON;
+#else
+    return &interpolateScalar;
+#endif
+}
+
+} // namespace
+
+TruePeakDetector::TruePeakDetector() {
+    constexpr int last = tapsPerPhase - 1;
+    
+    for (int t = 0; t < tapsPerPhase; ++t) {
+        const float phases[numPhases] = { phase0[t], phase1[t], phase1[last - t], phase0[last - t] };
+        
+        for (int lane = 0; lane < numLanes; ++lane) {
+            coefficients[t][lane] = phases[lane % numPhases];
+        }
+    }
+}
+
+void TruePeakDetector::reset() {
+    for (auto& channel : window) {
+        std::fill(channel, channel + historyLength, 0.0f);
+    }
+}
+
+float TruePeakDetector::process(const float* const* channels, int numChannels, float* peaksOut, int numSamples) {
+    static const InterpolateFn interpolate = selectInterpolate();
+    
+    numChannels = std::min(numChannels, maxChannels);
+    float blockPeak = 0.0f;
+    
+    for (int start = 0; start < numSamples; start += chunkSize) {
+        const int count = std::min(chunkSize, numSamples - start);
+        
+        // Missing channels stay silent
+        for (int ch = 0; ch < maxChannels; ++ch) {
+            float* w = window[ch] + historyLength;
+            if (ch < numChannels) {
+                std::copy(channels[ch] + start, channels[ch] + start + count, w);
+            } else {
+                std::fill(w, w + count, 0.0f);
+            }
+        }
+        
+        alignas(32) float peaks[chunkSize];
+        interpolate(coefficients, window[0], window[1], peaks, count);
+        
+        for (int i = 0; i < count; ++i) {
+            if (peaksOut != nullptr) {
+                peaksOut[start + i] = peaks[i];
+            }
+            blockPeak = std::max(blockPeak, peaks[i]);
+        }
+        
+        // Keep the last historyLength inputs for the next chunk
+        for (auto& channel : window) {
+            std::copy(channel + count, channel + count + historyLength, channel);
+        }
+    }
+    
+    return blockPeak;
+}
+
+} // namespace SeshEQ
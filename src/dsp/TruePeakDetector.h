@@ -0,0 +1,58 @@
+#pragma once
+
+namespace SeshEQ {
+
+/**
+ * @brief True-peak detection per ITU-R BS.1770 (Annex 2)
+ *
+ * Interpolates the input 4x with the 48-tap polyphase FIR of the annex (four
+ * phases of 12 taps) and reports the largest magnitude among the
+ * interpolated samples, catching the inter-sample peaks a sample-peak meter
+ * misses. Only the detection path is interpolated: the audio itself is not
+ * touched or oversampled.
+ *
+ * Each chunk is interpolated across consecutive samples, eight to a
+ * register with AVX (picked at runtime, as in LevelDetector) and four with
+ * SSE2 or NEON: every tap loads the inputs once and multiply-adds them into
+ * the four phases of the channel, and the peaks are the maximum over the
+ * phases and channels. The interpolated signal trails the input by latency
+ * samples.
+ */
+class TruePeakDetector {
+public:
+    static constexpr int maxChannels = 2;
+    static constexpr int numPhases = 4;
+    static constexpr int tapsPerPhase = 12;
+    static constexpr int latency = tapsPerPhase / 2;
+    
+    TruePeakDetector();
+    
+    /**
+     * @brief Clear the input history
+     */
+    void reset();
+    
+    /**
+     * @brief Detect the true peak of a block
+     * @param channels Input channels (up to maxChannels are read)
+     * @param peaksOut numSamples true peaks (linear, largest across the
+     *        channels), one per input sample; may be nullptr
+     * @return Largest true peak of the block (linear)
+     */
+    float process(const float* const* channels, int numChannels, float* peaksOut, int numSamples);
+
+private:
+    static constexpr int numLanes = maxChannels * numPhases;
+    static constexpr int historyLength = tapsPerPhase - 1;
+    
+    // Samples per pass through the window
+    static constexpr int chunkSize = 64;
+    
+    // Taps, [tap][lane] (both channels share the phase coefficients)
+    alignas(32) float coefficients[tapsPerPhase][numLanes] = {};
+    
+    // Last historyLength inputs followed by the current chunk, per channel
+    float window[maxChannels][historyLength + chunkSize] = {};
+};
+
+} // namespace SeshEQ
@@ -0,0 +1,167 @@
+#include "TruePeakLimiter.h"
+#include <algorithm>
+#include <cmath>
+
+namespace SeshEQ {
+
+namespace {
+
+/**
+ * @brief Gain that brings a peak down to the ceiling, easing in from the threshold
+ */
+float computeTargetGain(float peak, float thresholdLinear, float ceilingLinear) {
+    if (peak <= thresholdLinear) return 1.0f;
+    
+    // Apply limiting above threshold
+    if (peak > ceilingLinear) {
+        return ceilingLinear / peak;
+    }
+    
+    // Soft knee region between threshold and ceiling
+    const float excess = peak - thresholdLinear;
+    const float kneeRange = ceilingLinear - thresholdLinear;
+    const float kneeFactor = std::min(excess / kneeRange, 1.0f);
+    return 1.0f - (kneeFactor * (1.0f - ceilingLinear / peak));
+}
+
+} // namespace
+
+void TruePeakLimiter::prepare(int newMaxLookaheadSamples) {
+    maxLookaheadSamples = std::max(newMaxLookaheadSamples, 0);
+    
+    // Room for the longest lookahead, so changing it never allocates
+    peakHold.prepare(maxLookaheadSamples + 2);
+    holdInputs.assign(static_cast<size_t>(maxLookaheadSamples + 2), 0.0f);
+    rampHistory.assign(static_cast<size_t>(maxLookaheadSamples + 1), 1.0f);
+    delayLineLength = maxLookaheadSamples + TruePeakDetector::latency + 1;
+    for (auto& line : delayLines) {
+        line.assign(static_cast<size_t>(delayLineLength), 0.0f);
+    }
+    
+    setLookahead(lookaheadSamples);
+    reset();
+}
+
+void TruePeakLimiter::reset() {
+    truePeak.reset();
+    peakHold.reset();
+    std::fill(holdInputs.begin(), holdInputs.end(), 0.0f);
+    holdPosition = 0;
+    releasedGain = 1.0f;
+    
+    std::fill(rampHistory.begin(), rampHistory.end(), 1.0f);
+    rampSum = rampLength;
+    rampPosition = 0;
+    
+    for (auto& line : delayLines) {
+        std::fill(line.begin(), line.end(), 0.0f);
+    }
+    writePosition = 0;
+}
+
+void TruePeakLimiter::setLookahead(int samples) {
+    const float currentGain = static_cast<float>(rampSum / rampLength);
+    lookaheadSamples = std::clamp(samples, 0, maxLookaheadSamples);
+    
+    // The detector reports the peak between input samples n - latency and
+    // n - latency + 1 at n. Holding it over lookahead + 2 detector outputs
+    // covers both of those samples for the whole lookahead + 1 samples the
+    // ramp averages over, so the ramp is down by the time they leave the delay.
+    // The hold restarts on the stored inputs of its new window.
+    const int holdLength = lookaheadSamples + 2;
+    peakHold.setLength(holdLength);
+    rampLength = lookaheadSamples + 1;
+    
+    if (holdInputs.empty()) return;  // Not prepared yet
+    
+    float peak = 0.0f;
+    for (int k = holdLength; k > 0; --k) {
+        int position = holdPosition - k;
+        if (position < 0) position += static_cast<int>(holdInputs.size());
+        peak = peakHold.process(holdInputs[static_cast<size_t>(position)]);
+    }
+    
+    // The delay keeps its audio; only the read offset moves. The samples that
+    // leave before the new ramp is refilled are all in the hold, so the ramp
+    // restarts from the current gain, lowered as far as their peaks need.
+    const float gain = std::min(currentGain, computeTargetGain(peak, thresholdLinear, ceilingLinear));
+    std::fill(rampHistory.begin(), rampHistory.begin() + rampLength, gain);
+    rampSum = static_cast<double>(gain) * rampLength;
+    rampPosition = 0;
+}
+
+void TruePeakLimiter::setLevels(float newThresholdLinear, float newCeilingLinear) {
+    thresholdLinear = newThresholdLinear;
+    ceilingLinear = newCeilingLinear;
+}
+
+float TruePeakLimiter::process(float* const* channels, int numChannels, int numSamples) {
+    numChannels = std::min(numChannels, maxChannels);
+    if (numChannels < 1 || numSamples < 1 || rampHistory.empty()) return 1.0f;
+    
+    const float inverseRampLength = 1.0f / static_cast<float>(rampLength);
+    const int delay = lookaheadSamples + TruePeakDetector::latency;
+    float minGain = 1.0f;
+    
+    for (int start = 0; start < numSamples; start += chunkSize) {
+        const int count = std::min(chunkSize, numSamples - start);
+        
+        const float* input[maxChannels] = {};
+        for (int ch = 0; ch < numChannels; ++ch) {
+            input[ch] = channels[ch] + start;
+        }
+        truePeak.process(input, numChannels, peaks, count);
+        
+        for (int i = 0; i < count; ++i) {
+            // The sample the detector output is centred on, which phase 0 of
+            // the annex filter reads 2.8% low when it stands alone
+            int centrePosition = writePosition - TruePeakDetector::latency;
+            if (centrePosition < 0) centrePosition += delayLineLength;
+            
+            float samplePeak = 0.0f;
+            for (int ch = 0; ch < numChannels; ++ch) {
+                const float centre = delayLines[static_cast<size_t>(ch)][static_cast<size_t>(centrePosition)];
+                samplePeak = std::max(samplePeak, std::abs(centre));
+            }
+            
+            // Largest peak of the lookahead window
+            const float held = std::max(peaks[i], samplePeak);
+            holdInputs[static_cast<size_t>(holdPosition)] = held;
+            if (++holdPosition == static_cast<int>(holdInputs.size())) holdPosition = 0;
+            
+            const float peak = peakHold.process(held);
+            const float targetGain = computeTargetGain(peak, thresholdLinear, ceilingLinear);
+            
+            // Held gain drops at once and releases smoothly
+            if (targetGain < releasedGain) {
+                releasedGain = targetGain;
+            } else {
+                releasedGain = releaseCoef * releasedGain + (1.0f - releaseCoef) * targetGain;
+            }
+            
+            // Moving average over the lookahead: a ramp that lands on the held gain
+            rampSum += releasedGain - rampHistory[static_cast<size_t>(rampPosition)];
+            rampHistory[static_cast<size_t>(rampPosition)] = releasedGain;
+            if (++rampPosition == rampLength) rampPosition = 0;
+            
+            const float gain = static_cast<float>(rampSum) * inverseRampLength;
+            minGain = std::min(minGain, gain);
+            
+            int readPosition = writePosition - delay;
+            if (readPosition < 0) readPosition += delayLineLength;
+            
+            for (int ch = 0; ch < numChannels; ++ch) {
+                auto& line = delayLines[static_cast<size_t>(ch)];
+                float& sample = channels[ch][start + i];
+                line[static_cast<size_t>(writePosition)] = sample;
+                sample = line[static_cast<size_t>(readPosition)] * gain;
+            }
+            
+            if (++writePosition == delayLineLength) writePosition = 0;
+        }
+    }
+    
+    return minGain;
+}
+
+} // namespace SeshEQ
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "SlidingMaximum.h"
+#include "TruePeakDetector.h"
+#include <array>
+#include <vector>
+
+namespace SeshEQ {
+
+/**
+ * @brief Lookahead true peak limiting of up to two channels (the Limiter's signal path)
+ *
+ * The sidechain holds the largest peak of the lookahead window with a
+ * SlidingMaximum, releases with a one-pole smoother and averages the result
+ * over the lookahead (a moving average, so constant time per sample). Each
+ * peak is the larger of the BS.1770 true peak and the sample itself: the
+ * annex filter reads an isolated sample up to 3% low. The average ramps the
+ * gain down over the lookahead and reaches the held gain exactly when the
+ * peak leaves the delay line, so the output stays under the ceiling without
+ * any clipping.
+ *
+ * The audio is delayed by getLatency() samples. All storage is allocated in
+ * prepare().
+ */
+class TruePeakLimiter {
+public:
+    static constexpr int maxChannels = TruePeakDetector::maxChannels;
+    
+    TruePeakLimiter() = default;
+    
+    /**
+     * @brief Allocate for lookaheads of up to maxLookaheadSamples and clear the state
+     */
+    void prepare(int maxLookaheadSamples);
+    
+    /**
+     * @brief Clear the delay and the sidechain (unity gain)
+     */
+    void reset();
+    
+    /**
+     * @brief Set the lookahead (clamped to 0..maxLookaheadSamples)
+     *
+     * Keeps the delayed audio and moves only the read offset; the hold is
+     * rebuilt from its stored inputs and the ramp restarts from the current
+     * gain, so the output neither drops out nor overshoots the ceiling.
+     */
+    void setLookahead(int samples);
+    
+    int getLookahead() const { return lookaheadSamples; }
+    
+    /**
+     * @brief Delay of the audio: lookahead plus the true peak detector's latency
+     */
+    int getLatency() const { return lookaheadSamples + TruePeakDetector::latency; }
+    
+    /**
+     * @brief Set the levels (linear): limiting eases in from threshold and holds peaks at ceiling
+     */
+    void setLevels(float thresholdLinear, float ceilingLinear);
+    
+    /**
+     * @brief Set the per-sample one-pole release coefficient (0 = instant)
+     */
+    void setReleaseCoefficient(float coefficient) { releaseCoef = coefficient; }
+    
+    /**
+     * @brief Limit in place
+     * @return Smallest gain applied in the block
+     */
+    float process(float* const* channels, int numChannels, int numSamples);
+
+private:
+    // Samples per pass of the true peak detector
+    static constexpr int chunkSize = 64;
+    
+    float thresholdLinear = 1.0f;
+    float ceilingLinear = 1.0f;
+    float releaseCoef = 0.0f;
+    
+    // Sidechain
+    TruePeakDetector truePeak;
+    SlidingMaximum peakHold;
+    float peaks[chunkSize] = {};
+    float releasedGain = 1.0f;
+    
+    // Last maxLookahead + 2 hold inputs, to rebuild the hold when the lookahead changes
+    std::vector<float> holdInputs;
+    int holdPosition = 0;
+    
+    // Attack ramp: moving average of the last rampLength released gains
+    std::vector<float> rampHistory;
+    double rampSum = 1.0;
+    int rampLength = 1;
+    int rampPosition = 0;
+    
+    // Audio delay of lookahead + TruePeakDetector::latency samples
+    std::array<std::vector<float>, maxChannels> delayLines;
+    int delayLineLength = 1;
+    int writePosition = 0;
+    
+    int maxLookaheadSamples = 0;
+    int lookaheadSamples = 0;
+};
+
+} // namespace SeshEQ
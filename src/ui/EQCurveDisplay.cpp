@@ -1,5 +1,6 @@
 #include "EQCurveDisplay.h"
 #include "LookAndFeel.h"
+#include <array>
 #include <cmath>
 
 namespace SeshEQ {
@@ -166,6 +167,7 @@ void EQCurveDisplay::drawCurve(juce::Graphics& g) {
             std::abs(currentParams.gain - lastParams.gain) > 0.3f ||
             std::abs(currentParams.q - lastParams.q) > 0.1f ||
             currentParams.type != lastParams.type ||
+            currentParams.order != lastParams.order ||
             currentParams.enabled != lastParams.enabled) {
             needsRecalc = true;
         }
@@ -330,16 +332,29 @@ juce::Path EQCurveDisplay::createResponseCurve() const {
     
     // Optimize: calculate fewer points for smoother performance
     // Use adaptive sampling - more points in critical frequency ranges
-    const int numPoints = std::min(static_cast<int>(plotBounds.getWidth()), 400);
+    const int numPoints = std::min(static_cast<int>(plotBounds.getWidth()), maxCurvePoints);
     bool started = false;
     
+    std::array<float, maxCurvePoints> xs;
+    std::array<float, maxCurvePoints> freqs;
+    std::array<float, maxCurvePoints> mags;
+    
     for (int i = 0; i < numPoints; ++i) {
         const float normalized = static_cast<float>(i) / static_cast<float>(numPoints - 1);
-        const float x = plotBounds.getX() + normalized * plotBounds.getWidth();
-        const float freq = xToFrequency(x);
+        xs[static_cast<size_t>(i)] = plotBounds.getX() + normalized * plotBounds.getWidth();
+        freqs[static_cast<size_t>(i)] = xToFrequency(xs[static_cast<size_t>(i)]);
+    }
         
-        // Get combined magnitude from EQ processor
-        const float mag = eqProcessor ? eqProcessor->getMagnitudeAtFrequency(freq) : 1.0f;
+    // Get combined magnitude from EQ processor (all points in one batch)
+    if (eqProcessor) {
+        eqProcessor->getMagnitudeResponse(freqs.data(), mags.data(), numPoints);
+    } else {
+        mags.fill(1.0f);
+    }
+    
+    for (int i = 0; i < numPoints; ++i) {
+        const float x = xs[static_cast<size_t>(i)];
+        const float mag = mags[static_cast<size_t>(i)];
         const float db = 20.0f * std::log10(std::max(mag, 0.0001f));
         const float y = dbToY(db);
         
@@ -358,15 +373,28 @@ juce::Path EQCurveDisplay::createBandCurve(int bandIndex) const {
     juce::Path path;
     
     // Optimize: calculate fewer points for smoother performance
-    const int numPoints = std::min(static_cast<int>(plotBounds.getWidth()), 400);
+    const int numPoints = std::min(static_cast<int>(plotBounds.getWidth()), maxCurvePoints);
     bool started = false;
     
+    std::array<float, maxCurvePoints> xs;
+    std::array<float, maxCurvePoints> freqs;
+    std::array<float, maxCurvePoints> mags;
+    
     for (int i = 0; i < numPoints; ++i) {
         const float normalized = static_cast<float>(i) / static_cast<float>(numPoints - 1);
-        const float x = plotBounds.getX() + normalized * plotBounds.getWidth();
-        const float freq = xToFrequency(x);
+        xs[static_cast<size_t>(i)] = plotBounds.getX() + normalized * plotBounds.getWidth();
+        freqs[static_cast<size_t>(i)] = xToFrequency(xs[static_cast<size_t>(i)]);
+    }
         
-        const float mag = eqProcessor ? eqProcessor->getBandMagnitudeAtFrequency(bandIndex, freq) : 1.0f;
+    if (eqProcessor) {
+        eqProcessor->getBandMagnitudeResponse(bandIndex, freqs.data(), mags.data(), numPoints);
+    } else {
+        mags.fill(1.0f);
+    }
+    
+    for (int i = 0; i < numPoints; ++i) {
+        const float x = xs[static_cast<size_t>(i)];
+        const float mag = mags[static_cast<size_t>(i)];
         const float db = 20.0f * std::log10(std::max(mag, 0.0001f));
         const float y = dbToY(db);
         
@@ -140,6 +140,9 @@ private:
     static constexpr float nodeRadius = 8.0f;
     static constexpr float nodeHitRadius = 12.0f;
     
+    // Maximum points evaluated per response curve
+    static constexpr int maxCurvePoints = 400;
+    
     // Cached bounds
     juce::Rectangle<float> plotBounds;
     
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+namespace SeshEQ {
+
+/**
+ * @brief Branch-free polynomial approximations of transcendental functions
+ *
+ * Written without table lookups or data-dependent branches so that loops over
+ * structure-of-arrays data vectorize. Accuracy is close to the libm versions
+ * (relative error around 1e-14 in double, a few float ulps in single
+ * precision) over the documented input ranges.
+ */
+namespace FastMath {
+    
+    constexpr double pi = 3.14159265358979323846;
+    constexpr double halfPi = pi / 2.0;
+    constexpr double ln2 = 0.69314718055994530942;
+    constexpr double log2Of10 = 3.32192809488736234787;
+    
+    /**
+     * @brief 2^x for x in [-1022, 1023]
+     *
+     * Rounds x to the nearest integer n with the 1.5 * 2^52 shifter trick, evaluates
+     * 2^(x - n) on [-0.5, 0.5] with a degree 11 Taylor polynomial of e^(f ln2) and
+     * scales by 2^n through the exponent bits. The range is not checked (a clamp
+     * here stops loops from vectorizing); callers limit their inputs.
+     */
+    inline double exp2(double x) {
+        constexpr double shifter = 6755399441055744.0;  // 1.5 * 2^52
+        const double shifted = x + shifter;
+        const double n = shifted - shifter;
+        const double f = (x - n) * ln2;
+        
+        // e^f, |f| <= 0.347
+        double p = 1.0 / 39916800.0;
+        p = p * f + 1.0 / 3628800.0;
+        p = p * f + 1.0 / 362880.0;
+        p = p * f + 1.0 / 40320.0;
+        p = p * f + 1.0 / 5040.0;
+        p = p * f + 1.0 / 720.0;
+        p = p * f + 1.0 / 120.0;
+        p = p * f + 1.0 / 24.0;
+        p = p * f + 1.0 / 6.0;
+        p = p * f + 0.5;
+        p = p * f + 1.0;
+        p = p * f + 1.0;
+        
+        // The low mantissa bits of 'shifted' hold n; move n + 1023 into the exponent field
+        std::uint64_t bits;
+        std::memcpy(&bits, &shifted, sizeof(bits));
+        const std::uint64_t scaleBits = (bits + 1023u) << 52;
+        double scale;
+        std::memcpy(&scale, &scaleBits, sizeof(scale));
+        
+        return p * scale;
+    }
+    
+    /**
+     * @brief 10^(dB / 20) via exp2, for dB in [-6000, 6000]
+     */
+    inline double dbToGain(double dB) {
+        return exp2(dB * (log2Of10 / 20.0));
+    }
+    
+    /**
+     * @brief 2^x in single precision, x clamped to [-126, 127]
+     *
+     * The double version's scheme with a 1.5 * 2^23 shifter and a degree 6
+     * Taylor polynomial; the relative error stays below 3e-7 (3e-6 dB). The
+     * clamp keeps the exponent field from wrapping, so the result saturates
+     * at 2^-126 and 2^127.
+     */
+    inline float exp2(float x) {
+        constexpr float shifter = 12582912.0f;  // 1.5 * 2^23
+        x = std::clamp(x, -126.0f, 127.0f);
+        const float shifted = x + shifter;
+        const float n = shifted - shifter;
+        const float f = (x - n) * static_cast<float>(ln2);
+        
+        // e^f, |f| <= 0.347
+        float p = 1.0f / 720.0f;
+        p = p * f + 1.0f / 120.0f;
+        p = p * f + 1.0f / 24.0f;
+        p = p * f + 1.0f / 6.0f;
+        p = p * f + 0.5f;
+        p = p * f + 1.0f;
+        p = p * f + 1.0f;
+        
+        std::uint32_t bits;
+        std::memcpy(&bits, &shifted, sizeof(bits));
+        const std::uint32_t scaleBits = (bits + 127u) << 23;
+        float scale;
+        std::memcpy(&scale, &scaleBits, sizeof(scale));
+        
+        return p * scale;
+    }
+    
+    /**
+     * @brief log2(x) in single precision, for normal x > 0
+     *
+     * Splits x = 2^e m with m in [sqrt(1/2), sqrt(2)) through the bits and
+     * evaluates ln(m) = 2 atanh(t), t = (m - 1) / (m + 1), |t| < 0.172, as an
+     * odd series up to t^9. The error stays below 1.5e-7 for |log2(x)| <= 1
+     * and 1e-7 relative beyond.
+     */
+    inline float log2(float x) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        
+        // 0x3f3504f3 = sqrt(1/2): the exponent moves up once m reaches sqrt(2)
+        const std::int32_t e = static_cast<std::int32_t>(bits - 0x3f3504f3u) >> 23;
+        const std::uint32_t mantissaBits = bits - (static_cast<std::uint32_t>(e) << 23);
+        float m;
+        std::memcpy(&m, &mantissaBits, sizeof(m));
+        
+        const float t = (m - 1.0f) / (m + 1.0f);
+        const float t2 = t * t;
+        float p = 1.0f / 9.0f;
+        p = p * t2 + 1.0f / 7.0f;
+        p = p * t2 + 1.0f / 5.0f;
+        p = p * t2 + 1.0f / 3.0f;
+        p = p * t2 + 1.0f;
+        
+        return static_cast<float>(e) + t * p * static_cast<float>(2.0 / ln2);
+    }
+    
+    /**
+     * @brief 20 log10(gain) via log2, clamped at -200 dB as dBUtils::linearToDb
+     *
+     * Within 3e-5 dB of the exact value down to -200 dB.
+     */
+    inline float gainToDb(float gain) {
+        return static_cast<float>(20.0 / log2Of10) * log2(std::max(gain, 1e-10f));
+    }
+    
+    /**
+     * @brief 10^(dB / 20) via exp2
+     *
+     * Within 1e-6 dB per dB of |dB| (2e-4 dB at -200 dB). Saturates below
+     * -758 dB and above 764 dB, with exp2.
+     */
+    inline float dbToGain(float dB) {
+        return exp2(dB * static_cast<float>(log2Of10 / 20.0));
+    }
+    
+    /**
+     * @brief sin(w) and cos(w) for w in [0, pi]
+     *
+     * Folds w onto [0, pi/2] (sin is symmetric about pi/2, cos antisymmetric) and
+     * evaluates Taylor polynomials up to degree 17/18.
+     */
+    inline void sinCos(double w, double& sinOut, double& cosOut) {
+        const double x = std::min(w, pi - w);
+        const double cosSign = w > halfPi ? -1.0 : 1.0;
+        const double x2 = x * x;
+        
+        double s = -1.0 / 355687428096000.0;          // -1/17!
+        s = s * x2 + 1.0 / 1307674368000.0;           //  1/15!
+        s = s * x2 - 1.0 / 6227020800.0;              // -1/13!
+        s = s * x2 + 1.0 / 39916800.0;                //  1/11!
+        s = s * x2 - 1.0 / 362880.0;                  // -1/9!
+        s = s * x2 + 1.0 / 5040.0;                    //  1/7!
+        s = s * x2 - 1.0 / 120.0;                     // -1/5!
+        s = s * x2 + 1.0 / 6.0;                       //  1/3!
+        sinOut = x - x * x2 * s;
+        
+        double c = 1.0 / 6402373705728000.0;          //  1/18!
+        c = c * x2 - 1.0 / 20922789888000.0;          // -1/16!
+        c = c * x2 + 1.0 / 87178291200.0;             //  1/14!
+        c = c * x2 - 1.0 / 479001600.0;               // -1/12!
+        c = c * x2 + 1.0 / 3628800.0;                 //  1/10!
+        c = c * x2 - 1.0 / 40320.0;                   // -1/8!
+        c = c * x2 + 1.0 / 720.0;                     //  1/6!
+        c = c * x2 - 1.0 / 24.0;                      // -1/4!
+        c = c * x2 + 0.5;                             //  1/2!
+        cosOut = cosSign * (1.0 - x2 * c);
+    }
+    
+    /**
+     * @brief Bit-for-bit equality, for "has this parameter changed" checks
+     *
+     * Any change counts, so no tolerance applies; comparing the bits keeps float ==
+     * (and -Wfloat-equal) for comparisons that are meant to be approximate.
+     */
+    inline bool bitsEqual(float a, float b) {
+        return std::memcmp(&a, &b, sizeof(float)) == 0;
+    }
+    
+    /**
+     * @brief Smallest power of two >= n (1 for n <= 1)
+     */
+    inline int nextPowerOfTwo(int n) {
+        int power = 1;
+        while (power < n) power *= 2;
+        return power;
+    }
+
+} // namespace FastMath
+
+} // namespace SeshEQ
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+namespace SeshEQ {
+
+/**
+ * @brief Lock-free single-producer/single-consumer handoff of the latest value
+ *
+ * A triple buffer: the producer fills its private slot and publishes it, the
+ * consumer picks up the most recently published slot. Neither side ever waits
+ * or allocates, so it is safe to use on the audio thread. Values published
+ * while the consumer is not looking are overwritten by newer ones.
+ *
+ * Usage:
+ *   producer: fill getWriteBuffer(), then publish()
+ *   consumer: if (update()) read getReadBuffer()
+ */
+template <typename T>
+class LockFreeExchange {
+public:
+    LockFreeExchange() = default;
+    
+    /**
+     * @brief Slot owned by the producer until the next publish()
+     */
+    T& getWriteBuffer() { return buffers[static_cast<size_t>(writeIndex)]; }
+    
+    /**
+     * @brief Hand the write slot to the consumer and take a free one
+     */
+    void publish() {
+        writeIndex = middle.exchange(writeIndex | newDataFlag, std::memory_order_acq_rel) & indexMask;
+    }
+    
+    /**
+     * @brief Pick up the latest published value
+     * @return true if a new value was published since the last call
+     */
+    bool update() {
+        if ((middle.load(std::memory_order_relaxed) & newDataFlag) == 0) return false;
+        
+        readIndex = middle.exchange(readIndex, std::memory_order_acq_rel) & indexMask;
+        return true;
+    }
+    
+    /**
+     * @brief Slot owned by the consumer until the next successful update()
+     */
+    const T& getReadBuffer() const { return buffers[static_cast<size_t>(readIndex)]; }
+
+private:
+    static constexpr int indexMask = 3;
+    static constexpr int newDataFlag = 4;
+    
+    std::array<T, 3> buffers {};
+    
+    // Slot in transit between the two sides, plus the new-data flag
+    std::atomic<int> middle { 1 };
+    int writeIndex = 0;
+    int readIndex = 2;
+};
+
+} // namespace SeshEQ
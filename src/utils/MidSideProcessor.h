@@ -49,8 +49,35 @@ public:
         }
     }
     
+    /**
+     * @brief Convert a stereo pair to Mid/Side in place (left becomes Mid, right Side)
+     */
+    static void encodeInPlace(float* left, float* right, int numSamples) {
+        for (int i = 0; i < numSamples; ++i) {
+            const float l = left[i];
+            const float r = right[i];
+            left[i] = (l + r) * 0.5f;
+            right[i] = (l - r) * 0.5f;
+        }
+    }
+    
+    /**
+     * @brief Convert Mid/Side back to a stereo pair in place (see encodeInPlace)
+     */
+    static void decodeInPlace(float* mid, float* side, int numSamples) {
+        for (int i = 0; i < numSamples; ++i) {
+            const float m = mid[i];
+            const float s = side[i];
+            mid[i] = m + s;
+            side[i] = m - s;
+        }
+    }
+    
     /**
      * @brief Process stereo buffer in-place with Mid/Side encoding/decoding
+     * 
+     * Mid and Side are formed in the left and right channels themselves, so
+     * nothing is allocated.
      * @param buffer Stereo audio buffer
      * @param processMid Function to process mid channel: void(float* mid, int numSamples)
      * @param processSide Function to process side channel: void(float* side, int numSamples)
@@ -67,22 +94,15 @@ public:
         float* left = buffer.getWritePointer(0);
         float* right = buffer.getWritePointer(1);
         
-        // Allocate temporary buffers
-        juce::AudioBuffer<float> midBuffer(1, numSamples);
-        juce::AudioBuffer<float> sideBuffer(1, numSamples);
-        
-        float* mid = midBuffer.getWritePointer(0);
-        float* side = sideBuffer.getWritePointer(0);
-        
         // Encode to M/S
-        encode(left, right, numSamples, mid, side);
+        encodeInPlace(left, right, numSamples);
         
         // Process Mid and Side separately
-        processMid(mid, numSamples);
-        processSide(side, numSamples);
+        processMid(left, numSamples);
+        processSide(right, numSamples);
         
         // Decode back to L/R
-        decode(mid, side, numSamples, left, right);
+        decodeInPlace(left, right, numSamples);
     }
 };
 
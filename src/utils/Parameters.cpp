@@ -73,6 +73,54 @@ void ParameterLayout::addGlobalParameters(juce::AudioProcessorValueTreeState::Pa
         false
     ));
 
+    // IIR Filter Structure (serial cascade or parallel sections)
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID(filterStructure, 1),
+        "Filter Structure",
+        getFilterStructureNames(),
+        0  // Default to Serial
+    ));
+    
+    // IIR Filter Engine (TDF-II biquads or TPT state-variable filters)
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID(filterEngine, 1),
+        "Filter Engine",
+        getFilterEngineNames(),
+        0  // Default to Biquad
+    ));
+    
+    // Crossover of the band dynamics (LR4 IIR or linear-phase FIR)
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID(crossoverPhase, 1),
+        "Dynamics Crossover",
+        getCrossoverPhaseNames(),
+        0  // Default to Minimum Phase
+    ));
+    
+    // Linear phase FIR length: resolution against latency and CPU
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID(linearPhaseLength, 1),
+        "Linear Phase Length",
+        getLinearPhaseLengthNames(),
+        1  // Default to Medium
+    ));
+    
+    // Phase of the FIR mode: latency from none (Minimum) to half the FIR (Linear)
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID(firPhase, 1),
+        "FIR Phase",
+        getFirPhaseNames(),
+        0  // Default to Linear
+    ));
+    
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID(firPhaseMix, 1),
+        "FIR Phase Mix",
+        juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f),
+        50.0f,
+        juce::AudioParameterFloatAttributes().withLabel("%")
+    ));
+    
     // Global Oversampling Factor (1x, 2x, 4x, 8x)
     layout.add(std::make_unique<juce::AudioParameterChoice>(
         juce::ParameterID(oversamplingFactor, 1),
@@ -132,6 +180,14 @@ void ParameterLayout::addEQParameters(juce::AudioProcessorValueTreeState::Parame
             static_cast<int>(defaultBandTypes[static_cast<size_t>(i)])
         ));
         
+        // Slope (High Pass / Low Pass only)
+        layout.add(std::make_unique<juce::AudioParameterChoice>(
+            juce::ParameterID(getBandParamID(i, bandSlope), 1),
+            "Band " + bandStr + " Slope",
+            getSlopeNames(),
+            defaultSlope
+        ));
+        
         // Enable
         layout.add(std::make_unique<juce::AudioParameterBool>(
             juce::ParameterID(getBandParamID(i, bandEnable), 1),
@@ -387,6 +443,15 @@ void ParameterLayout::addLimiterParameters(juce::AudioProcessorValueTreeState::P
         juce::AudioParameterFloatAttributes().withLabel("ms")
     ));
     
+    // Lookahead: 0 to 10 ms (adds latency while the limiter is on)
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID(limiterLookahead, 1),
+        "Limiter Lookahead",
+        juce::NormalisableRange<float>(0.0f, 10.0f, 0.1f),
+        defaultLimiterLookahead,
+        juce::AudioParameterFloatAttributes().withLabel("ms")
+    ));
+    
     // Enable
     layout.add(std::make_unique<juce::AudioParameterBool>(
         juce::ParameterID(limiterEnable, 1),
@@ -2,6 +2,7 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include "dsp/BiquadFilter.h"  // For FilterType
+#include <algorithm>
 #include <array>
 #include <string>
 
@@ -21,6 +22,12 @@ namespace ParamIDs {
     inline const juce::String midSideMode = "midSideMode";
     inline const juce::String linearPhaseMode = "linearPhaseMode";
     inline const juce::String dynamicEQMode = "dynamicEQMode";
+    inline const juce::String filterStructure = "filterStructure";
+    inline const juce::String filterEngine = "filterEngine";
+    inline const juce::String crossoverPhase = "crossoverPhase";
+    inline const juce::String linearPhaseLength = "linearPhaseLength";
+    inline const juce::String firPhase = "firPhase";
+    inline const juce::String firPhaseMix = "firPhaseMix";
 
     // EQ Band parameters (use getBandParamID to get full ID)
     inline const juce::String bandFreq   = "freq";
@@ -28,6 +35,7 @@ namespace ParamIDs {
     inline const juce::String bandQ      = "q";
     inline const juce::String bandType   = "type";
     inline const juce::String bandEnable = "enable";
+    inline const juce::String bandSlope  = "slope";
     
     // Per-band Multiband Dynamics parameters (Compressor/Expander)
     inline const juce::String bandDynThreshold = "dynThreshold";
@@ -61,6 +69,7 @@ namespace ParamIDs {
     inline const juce::String limiterCeiling = "limiterCeiling";
     inline const juce::String limiterRelease = "limiterRelease";
     inline const juce::String limiterEnable  = "limiterEnable";
+    inline const juce::String limiterLookahead = "limiterLookahead";
 
     // Global Oversampling
     inline const juce::String oversamplingFactor = "oversamplingFactor";
@@ -76,10 +85,40 @@ inline juce::StringArray getFilterTypeNames() {
              "Peak", "Low Shelf", "High Shelf", "All Pass" };
 }
 
+// High/low-pass slopes; getSlopeOrder maps a choice index to the filter order
+inline juce::StringArray getSlopeNames() {
+    return { "6 dB/oct", "12 dB/oct", "18 dB/oct", "24 dB/oct", "48 dB/oct" };
+}
+
+inline int getSlopeOrder(int slopeIndex) {
+    constexpr std::array<int, 5> orders = { 1, 2, 3, 4, 8 };
+    return orders[static_cast<size_t>(std::clamp(slopeIndex, 0, 4))];
+}
+
 inline juce::StringArray getOversamplingNames() {
     return { "1x (Off)", "2x", "4x", "8x" };
 }
 
+inline juce::StringArray getFilterStructureNames() {
+    return { "Serial", "Parallel" };
+}
+
+inline juce::StringArray getFilterEngineNames() {
+    return { "Biquad", "SVF" };
+}
+
+inline juce::StringArray getCrossoverPhaseNames() {
+    return { "Minimum Phase", "Linear Phase" };
+}
+
+inline juce::StringArray getLinearPhaseLengthNames() {
+    return { "Low", "Medium", "High", "Max" };
+}
+
+inline juce::StringArray getFirPhaseNames() {
+    return { "Linear", "Minimum", "Mixed" };
+}
+
 //==============================================================================
 // Constants
 //==============================================================================
@@ -98,6 +137,7 @@ namespace Constants {
     constexpr float minQ = 0.1f;
     constexpr float maxQ = 18.0f;
     constexpr float defaultQ = 0.707f; // Butterworth
+    constexpr int defaultSlope = 1;    // 12 dB/oct (one biquad)
     
     // Default filter types for each band
     constexpr std::array<FilterType, numEQBands> defaultBandTypes = {
@@ -141,6 +181,7 @@ namespace Constants {
     // Limiter defaults
     constexpr float defaultLimiterCeiling = -0.3f;
     constexpr float defaultLimiterRelease = 100.0f;
+    constexpr float defaultLimiterLookahead = 1.5f;
 }
 
 //==============================================================================
@@ -287,6 +287,9 @@ void PresetManager::initializeDefaultPreset() {
         if (auto* param = valueTreeState.getParameter(ParamIDs::getBandParamID(band, ParamIDs::bandType))) {
             param->setValueNotifyingHost(param->convertTo0to1(4.0f)); // Peak filter
         }
+        if (auto* param = valueTreeState.getParameter(ParamIDs::getBandParamID(band, ParamIDs::bandSlope))) {
+            param->setValueNotifyingHost(param->convertTo0to1(static_cast<float>(Constants::defaultSlope))); // 12 dB/oct
+        }
         if (auto* param = valueTreeState.getParameter(ParamIDs::getBandParamID(band, ParamIDs::bandEnable))) {
             param->setValueNotifyingHost(1.0f); // Enabled
         }
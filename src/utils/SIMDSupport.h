@@ -0,0 +1,101 @@
+#pragma once
+
+//==============================================================================
+// Instruction set detection (standalone, no JUCE dependency)
+//==============================================================================
+#if defined(__x86_64__) || defined(_M_X64)
+    #define SESHEQ_SIMD_X86 1
+    #include <immintrin.h>
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+    #endif
+#else
+    #define SESHEQ_SIMD_X86 0
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+    #define SESHEQ_SIMD_NEON 1
+    #include <arm_neon.h>
+#else
+    #define SESHEQ_SIMD_NEON 0
+#endif
+
+// Kernels that use AVX are compiled per function so the rest of the plugin keeps
+// the baseline instruction set; they are only called after a runtime check.
+#if SESHEQ_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+    #define SESHEQ_TARGET_AVX __attribute__((target("avx")))
+    #define SESHEQ_TARGET_AVX2_FMA __attribute__((target("avx2,fma")))
+#else
+    #define SESHEQ_TARGET_AVX
+    #define SESHEQ_TARGET_AVX2_FMA
+#endif
+
+// Kernel bodies shared by several instruction set wrappers must be inlined into
+// each wrapper to be compiled for its target
+#if defined(_MSC_VER) && !defined(__clang__)
+    #define SESHEQ_FORCE_INLINE __forceinline
+#else
+    #define SESHEQ_FORCE_INLINE inline __attribute__((always_inline))
+#endif
+
+namespace SeshEQ {
+namespace SIMD {
+
+/**
+ * @brief Instruction sets available on the running CPU
+ *
+ * SSE2 is part of the x86-64 baseline and NEON of AArch64, so only the AVX
+ * family needs a runtime check.
+ */
+struct Capabilities {
+    bool sse2 = false;
+    bool avx = false;
+    bool avx2 = false;
+    bool fma = false;
+    bool neon = false;
+};
+
+namespace detail {
+    inline Capabilities detectCapabilities() {
+        Capabilities caps;
+
+#if SESHEQ_SIMD_X86
+        caps.sse2 = true;
+   #if defined(_MSC_VER) && !defined(__clang__)
+        int info[4] = {};
+        __cpuid(info, 1);
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool cpuAvx = (info[2] & (1 << 28)) != 0;
+        const bool cpuFma = (info[2] & (1 << 12)) != 0;
+        // The OS must save the upper YMM halves on context switch
+        const bool osAvx = osxsave && ((_xgetbv(0) & 0x6) == 0x6);
+        caps.avx = cpuAvx && osAvx;
+        caps.fma = caps.avx && cpuFma;
+        __cpuidex(info, 7, 0);
+        caps.avx2 = caps.avx && (info[1] & (1 << 5)) != 0;
+   #else
+        __builtin_cpu_init();
+        caps.avx = __builtin_cpu_supports("avx") != 0;
+        caps.avx2 = __builtin_cpu_supports("avx2") != 0;
+        caps.fma = __builtin_cpu_supports("fma") != 0;
+   #endif
+#endif
+
+#if SESHEQ_SIMD_NEON
+        caps.neon = true;
+#endif
+
+        return caps;
+    }
+}
+
+/**
+ * @brief Get the detected instruction sets (detected once, then cached)
+ */
+inline const Capabilities& getCapabilities() {
+    static const Capabilities caps = detail::detectCapabilities();
+    return caps;
+}
+
+} // namespace SIMD
+} // namespace SeshEQ
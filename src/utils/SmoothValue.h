@@ -50,6 +50,16 @@ public:
         return currentValue;
     }
     
+    /**
+     * @brief Advance by several samples at once and return the value reached
+     */
+    FloatType skip(int numSamples) {
+        for (int i = 0; i < numSamples; ++i) {
+            currentValue += coefficient * (targetValue - currentValue);
+        }
+        return currentValue;
+    }
+    
     /**
      * @brief Get current value without advancing
      */
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+// Direct include without JUCE dependencies for testing
+#include "dsp/BandFilter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace SeshEQ;
+
+class BandFilterTest : public ::testing::Test {
+protected:
+    static float toDb(float magnitude) {
+        return 20.0f * std::log10(magnitude);
+    }
+    
+    static constexpr double sampleRate = 48000.0;
+};
+
+//==============================================================================
+// Response tests
+//==============================================================================
+
+TEST_F(BandFilterTest, DefaultSlopeMatchesSingleBiquad) {
+    BandFilter band;
+    StereoBiquadFilter biquad;
+    band.prepare(sampleRate);
+    biquad.prepare(sampleRate);
+    band.setParameters(FilterType::HighPass, 120.0f, 1.2f);
+    biquad.setParameters(FilterType::HighPass, 120.0f, 1.2f);
+    
+    ASSERT_EQ(band.getNumStages(), 1);
+    
+    std::vector<float> left(512), right(512);
+    for (size_t i = 0; i < left.size(); ++i) {
+        left[i] = std::sin(0.05f * static_cast<float>(i));
+        right[i] = (i % 37 == 0) ? 1.0f : 0.0f;
+    }
+    auto expectedLeft = left;
+    auto expectedRight = right;
+    
+    band.processBlock(left.data(), right.data(), 512);
+    biquad.processBlock(expectedLeft.data(), expectedRight.data(), 512);
+    
+    EXPECT_EQ(left, expectedLeft);
+    EXPECT_EQ(right, expectedRight);
+}
+
+TEST_F(BandFilterTest, SlopesAreButterworth) {
+    for (const auto type : { FilterType::HighPass, FilterType::LowPass }) {
+        // Cutoffs chosen so the stopband octave sits where frequency warping is negligible
+        const bool highPass = type == FilterType::HighPass;
+        const float cutoff = highPass ? 1000.0f : 50.0f;
+        const float passband = highPass ? cutoff * 8.0f : cutoff / 8.0f;
+        const float stop = highPass ? cutoff / 16.0f : cutoff * 16.0f;
+        const float nextOctave = highPass ? stop / 2.0f : stop * 2.0f;
+        
+        for (const int order : { 1, 2, 3, 4, 8 }) {
+            BandFilter band;
+            band.prepare(sampleRate);
+            band.setOrder(order);
+            band.setParameters(type, cutoff, 0.7071f);
+            
+            EXPECT_EQ(band.getNumStages(), (order + 1) / 2);
+            
+            // -3 dB at the cutoff, flat in the passband
+            EXPECT_NEAR(toDb(band.getMagnitudeAtFrequency(cutoff)), -3.01f, 0.05f) << "order " << order;
+            EXPECT_NEAR(toDb(band.getMagnitudeAtFrequency(passband)), 0.0f, 0.1f) << "order " << order;
+            
+            // 6 dB per octave and order in the stopband
+            const float slope = toDb(band.getMagnitudeAtFrequency(stop))
+                              - toDb(band.getMagnitudeAtFrequency(nextOctave));
+            EXPECT_NEAR(slope, 6.02f * static_cast<float>(order), 0.05f * static_cast<float>(order))
+                << "order " << order;
+        }
+    }
+}
+
+TEST_F(BandFilterTest, ProcessingFollowsTheDesignedResponse) {
+    BandFilter band;
+    band.prepare(sampleRate);
+    band.setOrder(8);
+    band.setParameters(FilterType::HighPass, 400.0f, 0.7071f);
+    
+    // Steady-state sine amplitude one octave below the cutoff
+    const float freq = 200.0f;
+    std::vector<float> data(48000);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = std::sin(2.0f * 3.14159265f * freq * static_cast<float>(i) / static_cast<float>(sampleRate));
+    }
+    band.processMono(data.data(), static_cast<int>(data.size()));
+    
+    float peak = 0.0f;
+    for (size_t i = data.size() / 2; i < data.size(); ++i) {
+        peak = std::max(peak, std::abs(data[i]));
+    }
+    
+    EXPECT_NEAR(toDb(peak), toDb(band.getMagnitudeAtFrequency(freq)), 0.1f);
+}
+
+TEST_F(BandFilterTest, OrderOnlyAppliesToPassFilters) {
+    BandFilter band;
+    band.prepare(sampleRate);
+    band.setOrder(8);
+    band.setParameters(FilterType::Peak, 1000.0f, 1.0f, 6.0f);
+    
+    EXPECT_EQ(band.getNumStages(), 1);
+    EXPECT_NEAR(toDb(band.getMagnitudeAtFrequency(1000.0f)), 6.0f, 0.01f);
+    
+    // The order is kept for when the type changes back
+    band.setType(FilterType::LowPass);
+    EXPECT_EQ(band.getNumStages(), 4);
+}
@@ -3,8 +3,12 @@
 
 // Direct include without JUCE dependencies for testing
 #include "dsp/BiquadFilter.h"
+#include "dsp/BiquadKernels.h"
+#include "dsp/CoefficientDesigner.h"
+#include "utils/FastMath.h"
 
 #include <cmath>
+#include <complex>
 #include <vector>
 
 using namespace SeshEQ;
@@ -237,6 +241,49 @@ TEST_F(BiquadFilterTest, BlockProcessingMatchesSampleBySample) {
     }
 }
 
+TEST_F(BiquadFilterTest, BlockStateSpaceMatchesProcessSample) {
+    const FilterType types[] = { FilterType::LowPass, FilterType::HighPass, FilterType::BandPass,
+                                 FilterType::Notch, FilterType::Peak, FilterType::LowShelf,
+                                 FilterType::HighShelf, FilterType::AllPass };
+    
+    std::vector<float> input(1000);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = 0.6f * std::sin(0.02f * static_cast<float>(i)) + ((i % 97 == 0) ? 0.4f : -0.05f);
+    }
+    
+    for (const auto type : types) {
+        // Low-frequency, high-Q designs have the slowest-decaying state
+        for (const float freq : { 25.0f, 1000.0f, 15000.0f }) {
+            BiquadFilter reference, block;
+            StereoBiquadFilter mono;
+            reference.prepare(sampleRate);
+            block.prepare(sampleRate);
+            mono.prepare(sampleRate);
+            reference.setParameters(type, freq, 8.0f, 9.0f);
+            block.setParameters(type, freq, 8.0f, 9.0f);
+            mono.setParameters(type, freq, 8.0f, 9.0f);
+            
+            // Chunks that are not multiples of the block size exercise the scalar tail
+            std::vector<float> blockOut = input, monoOut = input;
+            size_t start = 0;
+            for (const int length : { 1, 7, 64, 3, 13, 400, 512 }) {
+                const int count = std::min(length, static_cast<int>(input.size() - start));
+                block.processBlock(blockOut.data() + start, count);
+                mono.processMono(monoOut.data() + start, count);
+                start += static_cast<size_t>(count);
+            }
+            
+            for (size_t i = 0; i < input.size(); ++i) {
+                const float expected = reference.processSample(input[i]);
+                ASSERT_NEAR(blockOut[i], expected, 1e-5f) << "type " << static_cast<int>(type)
+                                                          << ", " << freq << " Hz, sample " << i;
+                ASSERT_NEAR(monoOut[i], expected, 1e-5f) << "type " << static_cast<int>(type)
+                                                         << ", " << freq << " Hz, sample " << i;
+            }
+        }
+    }
+}
+
 //==============================================================================
 // Stereo filter tests
 //==============================================================================
@@ -257,6 +304,286 @@ TEST_F(BiquadFilterTest, StereoFilterProcessesBothChannels) {
     EXPECT_FALSE(std::isinf(right));
 }
 
+TEST_F(BiquadFilterTest, StereoBlockMatchesIndependentFilters) {
+    StereoBiquadFilter stereoFilter;
+    stereoFilter.prepare(sampleRate);
+    stereoFilter.setParameters(FilterType::Peak, 2500.0f, 2.0f, 9.0f);
+    
+    BiquadFilter leftRef, rightRef;
+    leftRef.prepare(sampleRate);
+    rightRef.prepare(sampleRate);
+    leftRef.setParameters(FilterType::Peak, 2500.0f, 2.0f, 9.0f);
+    rightRef.setParameters(FilterType::Peak, 2500.0f, 2.0f, 9.0f);
+    
+    std::vector<float> left(512), right(512);
+    for (size_t i = 0; i < left.size(); ++i) {
+        left[i] = std::sin(0.05f * static_cast<float>(i));
+        right[i] = (i % 7 == 0) ? 1.0f : -0.25f;
+    }
+    
+    // Two blocks, so state carried between calls is checked too
+    std::vector<float> leftOut = left, rightOut = right;
+    stereoFilter.processBlock(leftOut.data(), rightOut.data(), 200);
+    stereoFilter.processBlock(leftOut.data() + 200, rightOut.data() + 200, 312);
+    
+    for (size_t i = 0; i < left.size(); ++i) {
+        EXPECT_NEAR(leftOut[i], leftRef.processSample(left[i]), 1e-6f);
+        EXPECT_NEAR(rightOut[i], rightRef.processSample(right[i]), 1e-6f);
+    }
+}
+
+TEST_F(BiquadFilterTest, StereoPerSampleMatchesBlock) {
+    StereoBiquadFilter blockFilter, sampleFilter;
+    blockFilter.prepare(sampleRate);
+    sampleFilter.prepare(sampleRate);
+    blockFilter.setParameters(FilterType::HighShelf, 4000.0f, 0.707f, -6.0f);
+    sampleFilter.setParameters(FilterType::HighShelf, 4000.0f, 0.707f, -6.0f);
+    
+    std::vector<float> left(64, 0.0f), right(64, 0.0f);
+    left[0] = 1.0f;
+    right[3] = -1.0f;
+    std::vector<float> leftBlock = left, rightBlock = right;
+    
+    blockFilter.processBlock(leftBlock.data(), rightBlock.data(), 64);
+    for (size_t i = 0; i < left.size(); ++i) {
+        sampleFilter.processStereo(left[i], right[i]);
+        EXPECT_NEAR(left[i], leftBlock[i], 1e-6f);
+        EXPECT_NEAR(right[i], rightBlock[i], 1e-6f);
+    }
+}
+
+TEST_F(BiquadFilterTest, MultiChannelKernelsMatchScalar) {
+    filter.setParameters(FilterType::LowShelf, 150.0f, 0.9f, 4.5f);
+    const auto coefs = filter.getCoefficients();
+    
+    for (int numChannels = 1; numChannels <= BiquadLaneState::maxChannels; ++numChannels) {
+        std::vector<std::vector<float>> reference(static_cast<size_t>(numChannels), std::vector<float>(256));
+        for (int ch = 0; ch < numChannels; ++ch) {
+            for (size_t i = 0; i < 256; ++i) {
+                reference[static_cast<size_t>(ch)][i] = std::cos(0.01f * static_cast<float>((ch + 1) * i));
+            }
+        }
+        auto simd = reference;
+        
+        std::vector<float*> refPtrs, simdPtrs;
+        for (int ch = 0; ch < numChannels; ++ch) {
+            refPtrs.push_back(reference[static_cast<size_t>(ch)].data());
+            simdPtrs.push_back(simd[static_cast<size_t>(ch)].data());
+        }
+        
+        BiquadLaneState refState, simdState;
+        BiquadKernels::processScalar(coefs, refState, refPtrs.data(), numChannels, 256);
+        BiquadKernels::process(coefs, simdState, simdPtrs.data(), numChannels, 256);
+        
+        for (int ch = 0; ch < numChannels; ++ch) {
+            for (size_t i = 0; i < 256; ++i) {
+                EXPECT_NEAR(simd[static_cast<size_t>(ch)][i], reference[static_cast<size_t>(ch)][i], 1e-6f);
+            }
+            EXPECT_NEAR(simdState.z1[ch], refState.z1[ch], 1e-9);
+            EXPECT_NEAR(simdState.z2[ch], refState.z2[ch], 1e-9);
+        }
+    }
+}
+
+//==============================================================================
+// Coefficient ramp tests
+//==============================================================================
+
+TEST_F(BiquadFilterTest, RampWithEqualEndsMatchesPlainProcessing) {
+    filter.setParameters(FilterType::Peak, 800.0f, 1.5f, -4.0f);
+    const auto coefs = filter.getCoefficients();
+    
+    std::vector<float> plain(128), ramped(128);
+    for (size_t i = 0; i < plain.size(); ++i) {
+        plain[i] = ramped[i] = std::sin(0.2f * static_cast<float>(i));
+    }
+    
+    float* plainPtr = plain.data();
+    float* rampedPtr = ramped.data();
+    BiquadLaneState plainState, rampedState;
+    BiquadKernels::process(coefs, plainState, &plainPtr, 1, 128);
+    BiquadKernels::processRamped(coefs, coefs, rampedState, &rampedPtr, 1, 128);
+    
+    for (size_t i = 0; i < plain.size(); ++i) {
+        EXPECT_NEAR(plain[i], ramped[i], 1e-6f);
+    }
+}
+
+TEST_F(BiquadFilterTest, RampedBlockEndsOnTargetCoefficients) {
+    StereoBiquadFilter rampedFilter, targetFilter;
+    rampedFilter.prepare(sampleRate);
+    targetFilter.prepare(sampleRate);
+    rampedFilter.setParameters(FilterType::Peak, 500.0f, 1.0f, 0.0f);
+    
+    std::vector<float> left(32, 0.0f), right(32, 0.0f);
+    rampedFilter.processBlock(left.data(), right.data(), 32);
+    
+    // Ramp to the new setting over one control block, then both filters must agree
+    rampedFilter.setParameters(FilterType::Peak, 2000.0f, 3.0f, 12.0f);
+    targetFilter.setParameters(FilterType::Peak, 2000.0f, 3.0f, 12.0f);
+    rampedFilter.processBlockRamped(left.data(), right.data(), 32);
+    
+    std::vector<float> l1(64, 0.0f), r1(64, 0.0f), l2(64, 0.0f), r2(64, 0.0f);
+    l1[0] = l2[0] = 1.0f;
+    r1[5] = r2[5] = 1.0f;
+    rampedFilter.processBlock(l1.data(), r1.data(), 64);
+    targetFilter.processBlock(l2.data(), r2.data(), 64);
+    
+    for (size_t i = 0; i < l1.size(); ++i) {
+        EXPECT_NEAR(l1[i], l2[i], 1e-6f);
+        EXPECT_NEAR(r1[i], r2[i], 1e-6f);
+    }
+}
+
+TEST_F(BiquadFilterTest, StabilityCheckRejectsPolesOutsideUnitCircle) {
+    filter.setParameters(FilterType::LowPass, 1000.0f, 0.707f, 0.0f);
+    EXPECT_TRUE(BiquadKernels::isStable(filter.getCoefficients()));
+    
+    EXPECT_FALSE(BiquadKernels::isStable({ 1.0, 0.0, 0.0, 0.0, 1.01 }));
+    EXPECT_FALSE(BiquadKernels::isStable({ 1.0, 0.0, 0.0, -2.1, 0.9 }));
+}
+
+//==============================================================================
+// Coefficient designer tests
+//==============================================================================
+
+namespace {
+    // RBJ cookbook design with libm functions, as reference for the fast designer
+    BiquadFilter::Coefficients referenceDesign(FilterType type, double freq, double q,
+                                               double gainDb, double fs) {
+        const double w0 = 2.0 * FastMath::pi * freq / fs;
+        const double c = std::cos(w0);
+        const double alpha = std::sin(w0) / (2.0 * q);
+        const double A = std::pow(10.0, gainDb / 40.0);
+        const double sa = 2.0 * std::sqrt(A) * alpha;
+        
+        double b[3] = { 1.0, -2.0 * c, 1.0 };
+        double a[3] = { 1.0 + alpha, -2.0 * c, 1.0 - alpha };
+        
+        switch (type) {
+            case FilterType::LowPass:
+                b[0] = b[2] = (1.0 - c) / 2.0; b[1] = 1.0 - c;
+                break;
+            case FilterType::HighPass:
+                b[0] = b[2] = (1.0 + c) / 2.0; b[1] = -(1.0 + c);
+                break;
+            case FilterType::BandPass:
+                b[0] = alpha; b[1] = 0.0; b[2] = -alpha;
+                break;
+            case FilterType::Notch:
+                break;
+            case FilterType::Peak:
+                b[0] = 1.0 + alpha * A; b[2] = 1.0 - alpha * A;
+                a[0] = 1.0 + alpha / A; a[2] = 1.0 - alpha / A;
+                break;
+            case FilterType::LowShelf:
+                b[0] = A * ((A + 1.0) - (A - 1.0) * c + sa);
+                b[1] = 2.0 * A * ((A - 1.0) - (A + 1.0) * c);
+                b[2] = A * ((A + 1.0) - (A - 1.0) * c - sa);
+                a[0] = (A + 1.0) + (A - 1.0) * c + sa;
+                a[1] = -2.0 * ((A - 1.0) + (A + 1.0) * c);
+                a[2] = (A + 1.0) + (A - 1.0) * c - sa;
+                break;
+            case FilterType::HighShelf:
+                b[0] = A * ((A + 1.0) + (A - 1.0) * c + sa);
+                b[1] = -2.0 * A * ((A - 1.0) + (A + 1.0) * c);
+                b[2] = A * ((A + 1.0) + (A - 1.0) * c - sa);
+                a[0] = (A + 1.0) - (A - 1.0) * c + sa;
+                a[1] = 2.0 * ((A - 1.0) - (A + 1.0) * c);
+                a[2] = (A + 1.0) - (A - 1.0) * c - sa;
+                break;
+            case FilterType::AllPass:
+                b[0] = 1.0 - alpha; b[2] = 1.0 + alpha;
+                break;
+        }
+        
+        return { b[0] / a[0], b[1] / a[0], b[2] / a[0], a[1] / a[0], a[2] / a[0] };
+    }
+}
+
+TEST_F(BiquadFilterTest, FastMathMatchesLibm) {
+    for (double x = -60.0; x <= 60.0; x += 0.37) {
+        EXPECT_NEAR(FastMath::exp2(x) / std::exp2(x), 1.0, 1e-13);
+    }
+    
+    for (double w = 0.0; w <= FastMath::pi; w += 0.001) {
+        double s, c;
+        FastMath::sinCos(w, s, c);
+        EXPECT_NEAR(s, std::sin(w), 1e-13);
+        EXPECT_NEAR(c, std::cos(w), 1e-13);
+    }
+}
+
+TEST_F(BiquadFilterTest, BatchDesignMatchesReference) {
+    const FilterType types[] = { FilterType::LowPass, FilterType::HighPass, FilterType::BandPass,
+                                 FilterType::Notch, FilterType::Peak, FilterType::LowShelf,
+                                 FilterType::HighShelf, FilterType::AllPass };
+    
+    // 11 bands: one full pass of 8 lanes plus a partial one
+    std::vector<BandDesign> bands;
+    for (int i = 0; i < 11; ++i) {
+        bands.push_back({ types[i % 8], 20.0f * std::pow(1.9f, static_cast<float>(i)),
+                          0.3f + 0.7f * static_cast<float>(i), -24.0f + 4.5f * static_cast<float>(i) });
+    }
+    
+    std::vector<BiquadFilter::Coefficients> coefs(bands.size());
+    CoefficientDesigner::design(bands.data(), coefs.data(), static_cast<int>(bands.size()), sampleRate);
+    
+    for (size_t i = 0; i < bands.size(); ++i) {
+        const auto ref = referenceDesign(bands[i].type, bands[i].frequency, bands[i].q,
+                                         bands[i].gainDb, sampleRate);
+        EXPECT_NEAR(coefs[i].b0, ref.b0, 1e-9) << "band " << i;
+        EXPECT_NEAR(coefs[i].b1, ref.b1, 1e-9) << "band " << i;
+        EXPECT_NEAR(coefs[i].b2, ref.b2, 1e-9) << "band " << i;
+        EXPECT_NEAR(coefs[i].a1, ref.a1, 1e-9) << "band " << i;
+        EXPECT_NEAR(coefs[i].a2, ref.a2, 1e-9) << "band " << i;
+    }
+}
+
+TEST_F(BiquadFilterTest, GainOnlyUpdateMatchesFullDesign) {
+    const FilterType types[] = { FilterType::Peak, FilterType::LowShelf, FilterType::HighShelf };
+    BiquadFilter reference;
+    reference.prepare(sampleRate);
+    
+    for (const FilterType type : types) {
+        filter.setParameters(type, 1500.0f, 1.3f, 0.0f);
+        
+        // Sweep the gain through setGain only (cached frequency/Q terms)
+        for (float gainDb = -30.0f; gainDb <= 30.0f; gainDb += 7.5f) {
+            filter.setGain(gainDb);
+            reference.setParameters(type, 1500.0f, 1.3f, gainDb);
+            
+            const auto fast = filter.getCoefficients();
+            const auto full = reference.getCoefficients();
+            EXPECT_NEAR(fast.b0, full.b0, 1e-12) << "gain " << gainDb;
+            EXPECT_NEAR(fast.b1, full.b1, 1e-12) << "gain " << gainDb;
+            EXPECT_NEAR(fast.b2, full.b2, 1e-12) << "gain " << gainDb;
+            EXPECT_NEAR(fast.a1, full.a1, 1e-12) << "gain " << gainDb;
+            EXPECT_NEAR(fast.a2, full.a2, 1e-12) << "gain " << gainDb;
+        }
+    }
+    
+    // A frequency change must not leave stale terms behind
+    filter.setFrequency(400.0f);
+    filter.setGain(6.0f);
+    reference.setParameters(FilterType::HighShelf, 400.0f, 1.3f, 6.0f);
+    EXPECT_NEAR(filter.getCoefficients().b0, reference.getCoefficients().b0, 1e-12);
+    EXPECT_NEAR(filter.getCoefficients().a1, reference.getCoefficients().a1, 1e-12);
+}
+
+TEST_F(BiquadFilterTest, SquaredMagnitudeMatchesComplexEvaluation) {
+    const auto c = referenceDesign(FilterType::LowShelf, 300.0, 0.9, 7.5, sampleRate);
+    
+    for (double f = 20.0; f < 20000.0; f *= 1.3) {
+        const double w = 2.0 * FastMath::pi * f / sampleRate;
+        const std::complex<double> z1 = std::polar(1.0, -w);
+        const std::complex<double> z2 = std::polar(1.0, -2.0 * w);
+        const double expected = std::abs((c.b0 + c.b1 * z1 + c.b2 * z2) / (1.0 + c.a1 * z1 + c.a2 * z2));
+        
+        EXPECT_NEAR(CoefficientDesigner::getMagnitude(c, CoefficientDesigner::getPhi(w)), expected, 1e-12);
+    }
+}
+
 //==============================================================================
 // Edge case tests
 //==============================================================================
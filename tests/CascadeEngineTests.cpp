@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+// Direct include without JUCE dependencies for testing
+#include "dsp/CascadeEngine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace SeshEQ;
+
+class CascadeEngineTest : public ::testing::Test {
+protected:
+    // Section designs spread over all filter types
+    std::vector<BiquadFilter::Coefficients> makeSections(int count, float gainOffset = 0.0f) {
+        const FilterType types[] = { FilterType::Peak, FilterType::LowShelf, FilterType::HighShelf,
+                                     FilterType::LowPass, FilterType::HighPass, FilterType::Notch,
+                                     FilterType::BandPass, FilterType::AllPass };
+        std::vector<BiquadFilter::Coefficients> coefs;
+        
+        for (int i = 0; i < count; ++i) {
+            BiquadFilter filter;
+            filter.prepare(sampleRate);
+            filter.setParameters(types[i % 8], 60.0f * std::pow(1.7f, static_cast<float>(i)),
+                                 0.5f + 0.3f * static_cast<float>(i % 5),
+                                 6.0f - 2.5f * static_cast<float>(i % 6) + gainOffset);
+            coefs.push_back(filter.getCoefficients());
+        }
+        
+        return coefs;
+    }
+    
+    static std::vector<float> makeSignal(int length, int seed) {
+        std::vector<float> signal(static_cast<size_t>(length));
+        for (int i = 0; i < length; ++i) {
+            signal[static_cast<size_t>(i)] = 0.5f * std::sin(0.037f * static_cast<float>(i * seed))
+                                           + 0.3f * std::sin(0.71f * static_cast<float>(i) + static_cast<float>(seed));
+        }
+        return signal;
+    }
+    
+    // Serial double-precision reference: section by section over the whole block
+    struct Reference {
+        std::vector<double> z1, z2;
+        
+        explicit Reference(int numSections) : z1(static_cast<size_t>(numSections)), z2(static_cast<size_t>(numSections)) {}
+        
+        void process(const std::vector<BiquadFilter::Coefficients>& start,
+                     const std::vector<BiquadFilter::Coefficients>& end, std::vector<float>& data) {
+            const double n = static_cast<double>(data.size());
+            std::vector<double> x(data.begin(), data.end());
+            
+            for (size_t k = 0; k < start.size(); ++k) {
+                for (size_t i = 0; i < x.size(); ++i) {
+                    const double r = static_cast<double>(i + 1) / n;
+                    const double b0 = start[k].b0 + (end[k].b0 - start[k].b0) * r;
+                    const double b1 = start[k].b1 + (end[k].b1 - start[k].b1) * r;
+                    const double b2 = start[k].b2 + (end[k].b2 - start[k].b2) * r;
+                    const double a1 = start[k].a1 + (end[k].a1 - start[k].a1) * r;
+                    const double a2 = start[k].a2 + (end[k].a2 - start[k].a2) * r;
+                    
+                    const double y = b0 * x[i] + z1[k];
+                    z1[k] = b1 * x[i] - a1 * y + z2[k];
+                    z2[k] = b2 * x[i] - a2 * y;
+                    x[i] = y;
+                }
+            }
+            
+            for (size_t i = 0; i < x.size(); ++i) {
+                data[i] = static_cast<float>(x[i]);
+            }
+        }
+    };
+    
+    static constexpr double sampleRate = 48000.0;
+    static constexpr float tolerance = 1e-5f;
+};
+
+//==============================================================================
+// Cascade tests
+//==============================================================================
+
+TEST_F(CascadeEngineTest, MatchesSerialSectionsForAllWidths) {
+    // 3 -> 4 lanes, 8 -> 8, 11 -> 12, 25 -> 28
+    for (int numSections : { 3, 8, 11, 25 }) {
+        const auto coefs = makeSections(numSections);
+        std::vector<int> ids;
+        for (int i = 0; i < numSections; ++i) ids.push_back(numSections - 1 - i);
+        
+        CascadeEngine engine;
+        engine.setSections(ids.data(), coefs.data(), numSections);
+        Reference refL(numSections), refR(numSections);
+        
+        // Blocks shorter and longer than the pipeline depth; state carries across calls
+        int seed = 1;
+        for (int length : { 64, 1, 7, 300, 2, 31 }) {
+            auto left = makeSignal(length, seed++);
+            auto right = makeSignal(length, seed++);
+            auto expectedL = left;
+            auto expectedR = right;
+            
+            float* channels[2] = { left.data(), right.data() };
+            engine.process(channels, 2, length);
+            refL.process(coefs, coefs, expectedL);
+            refR.process(coefs, coefs, expectedR);
+            
+            for (int i = 0; i < length; ++i) {
+                ASSERT_NEAR(left[static_cast<size_t>(i)], expectedL[static_cast<size_t>(i)], tolerance)
+                    << numSections << " sections, sample " << i;
+                ASSERT_NEAR(right[static_cast<size_t>(i)], expectedR[static_cast<size_t>(i)], tolerance)
+                    << numSections << " sections, sample " << i;
+            }
+        }
+    }
+}
+
+TEST_F(CascadeEngineTest, RampsEachSectionFromPreviousCoefficients) {
+    const int numSections = 6;
+    const auto before = makeSections(numSections);
+    const auto after = makeSections(numSections, 4.0f);
+    const int ids[numSections] = { 0, 1, 2, 3, 4, 5 };
+    
+    CascadeEngine engine;
+    Reference ref(numSections);
+    
+    engine.setSections(ids, before.data(), numSections);
+    auto warmup = makeSignal(100, 3);
+    auto expected = warmup;
+    float* channels[1] = { warmup.data() };
+    engine.process(channels, 1, 100);
+    ref.process(before, before, expected);
+    
+    engine.setSections(ids, after.data(), numSections);
+    auto data = makeSignal(32, 5);
+    expected = data;
+    channels[0] = data.data();
+    engine.processRamped(channels, 1, 32);
+    ref.process(before, after, expected);
+    
+    for (size_t i = 0; i < data.size(); ++i) {
+        EXPECT_NEAR(data[i], expected[i], tolerance) << "sample " << i;
+    }
+}
+
+TEST_F(CascadeEngineTest, SegmentedRampMatchesOneRampPerSegment) {
+    // 11 sections (12 lanes, 3 of them padding), three segments with the last one short
+    const int numSections = 11;
+    const int segmentLength = 32;
+    const int numSamples = 80;
+    std::vector<int> ids;
+    for (int i = 0; i < numSections; ++i) ids.push_back(i);
+    
+    const auto start = makeSections(numSections);
+    std::vector<std::vector<BiquadFilter::Coefficients>> rows;
+    for (int segment = 0; segment < 3; ++segment) {
+        rows.push_back(makeSections(numSections, 2.0f * static_cast<float>(segment + 1)));
+    }
+    
+    CascadeEngine segmented, perSegment;
+    for (auto* engine : { &segmented, &perSegment }) {
+        engine->setSections(ids.data(), start.data(), numSections);
+        auto warmup = makeSignal(50, 4);
+        float* channels[1] = { warmup.data() };
+        engine->process(channels, 1, 50);
+    }
+    
+    auto data = makeSignal(numSamples, 6);
+    auto expected = data;
+    
+    std::vector<BiquadFilter::Coefficients> table;
+    for (const auto& row : rows) table.insert(table.end(), row.begin(), row.end());
+    float* channels[1] = { data.data() };
+    segmented.processRampedSegments(channels, 1, numSamples, table.data(), segmentLength);
+    
+    for (int segment = 0; segment < 3; ++segment) {
+        const int offset = segment * segmentLength;
+        float* segmentChannels[1] = { expected.data() + offset };
+        perSegment.setSections(ids.data(), rows[static_cast<size_t>(segment)].data(), numSections);
+        perSegment.processRamped(segmentChannels, 1, std::min(segmentLength, numSamples - offset));
+    }
+    
+    for (size_t i = 0; i < data.size(); ++i) {
+        ASSERT_NEAR(data[i], expected[i], tolerance) << "sample " << i;
+    }
+    
+    // Both end on the last row, with the same state
+    for (int i = 0; i < numSections; ++i) {
+        EXPECT_NEAR(segmented.getSectionState(i).z1[0], perSegment.getSectionState(i).z1[0], 1e-9);
+    }
+}
+
+TEST_F(CascadeEngineTest, StateFollowsSectionIds) {
+    const auto coefs = makeSections(3);
+    
+    // Run sections 0, 1, 2, then drop section 1
+    CascadeEngine engine;
+    const int all[3] = { 0, 1, 2 };
+    engine.setSections(all, coefs.data(), 3);
+    auto first = makeSignal(50, 7);
+    float* channels[1] = { first.data() };
+    engine.process(channels, 1, 50);
+    
+    const int outer[2] = { 0, 2 };
+    const BiquadFilter::Coefficients outerCoefs[2] = { coefs[0], coefs[2] };
+    engine.setSections(outer, outerCoefs, 2);
+    
+    // Section 2 must continue with its own state, not with section 1's
+    const auto state2 = engine.getSectionState(2);
+    CascadeEngine fresh;
+    fresh.setSections(outer, outerCoefs, 2);
+    fresh.setSectionState(0, engine.getSectionState(0), coefs[0]);
+    fresh.setSectionState(2, state2, coefs[2]);
+    
+    auto a = makeSignal(40, 9);
+    auto b = a;
+    channels[0] = a.data();
+    engine.process(channels, 1, 40);
+    channels[0] = b.data();
+    fresh.process(channels, 1, 40);
+    
+    for (size_t i = 0; i < a.size(); ++i) {
+        EXPECT_FLOAT_EQ(a[i], b[i]);
+    }
+}
+
+TEST_F(CascadeEngineTest, NoSectionsPassesThrough) {
+    CascadeEngine engine;
+    engine.setSections(nullptr, nullptr, 0);
+    
+    auto data = makeSignal(20, 2);
+    const auto original = data;
+    float* channels[1] = { data.data() };
+    engine.process(channels, 1, 20);
+    
+    EXPECT_EQ(data, original);
+}
@@ -0,0 +1,247 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+// Direct include without JUCE dependencies for testing
+#include "dsp/CrossoverFilterbank.h"
+#include "dsp/BiquadFilter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace SeshEQ;
+
+class CrossoverFilterbankTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        left.resize(length);
+        right.resize(length);
+        for (int i = 0; i < length; ++i) {
+            // Deterministic broadband input
+            const auto n = static_cast<unsigned>(i);
+            left[static_cast<size_t>(i)] = static_cast<float>((n * 1103515245u + 12345u) % 2001u) / 1000.0f - 1.0f;
+            right[static_cast<size_t>(i)] = std::sin(0.07f * static_cast<float>(i));
+        }
+    }
+    
+    /**
+     * @brief Split and sum the whole input in blocks
+     * @param band If >= 0, write only this band instead of the sum
+     */
+    void run(CrossoverFilterbank& bank, std::vector<float>& outLeft, std::vector<float>& outRight,
+             int band = -1) {
+        outLeft.resize(length);
+        outRight.resize(length);
+        
+        for (int start = 0; start < length; start += blockSize) {
+            const int count = std::min(blockSize, length - start);
+            const float* input[2] = { left.data() + start, right.data() + start };
+            float* output[2] = { outLeft.data() + start, outRight.data() + start };
+            
+            bank.split(input, 2, count);
+            
+            if (band < 0) {
+                bank.sum(output, 2, count);
+            } else {
+                std::copy(bank.getBand(band, 0), bank.getBand(band, 0) + count, output[0]);
+                std::copy(bank.getBand(band, 1), bank.getBand(band, 1) + count, output[1]);
+            }
+        }
+    }
+    
+    static float rms(const std::vector<float>& data, size_t from) {
+        double sum = 0.0;
+        for (size_t i = from; i < data.size(); ++i) {
+            sum += static_cast<double>(data[i]) * data[i];
+        }
+        return static_cast<float>(std::sqrt(sum / static_cast<double>(data.size() - from)));
+    }
+    
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 256;
+    static constexpr int length = 8192;
+    
+    std::vector<float> left;
+    std::vector<float> right;
+};
+
+//==============================================================================
+// Reconstruction tests
+//==============================================================================
+
+TEST_F(CrossoverFilterbankTest, MinimumPhaseSumIsTheAllpassChain) {
+    const float frequencies[3] = { 200.0f, 1500.0f, 6000.0f };
+    
+    CrossoverFilterbank bank;
+    bank.prepare(sampleRate, blockSize);
+    bank.setCrossovers(frequencies, 3);
+    ASSERT_EQ(bank.getNumBands(), 4);
+    EXPECT_EQ(bank.getLatency(), 0);
+    
+    std::vector<float> outLeft, outRight;
+    run(bank, outLeft, outRight);
+    
+    // Each LR4 pair sums to a second-order allpass at its crossover
+    std::vector<float> expectedLeft = left;
+    std::vector<float> expectedRight = right;
+    for (const float frequency : frequencies) {
+        StereoBiquadFilter allPass;
+        allPass.prepare(sampleRate);
+        allPass.setParameters(FilterType::AllPass, frequency, 0.70710678f);
+        allPass.processBlock(expectedLeft.data(), expectedRight.data(), length);
+    }
+    
+    for (size_t i = 0; i < outLeft.size(); ++i) {
+        ASSERT_NEAR(outLeft[i], expectedLeft[i], 1e-4f) << "sample " << i;
+        ASSERT_NEAR(outRight[i], expectedRight[i], 1e-4f) << "sample " << i;
+    }
+}
+
+TEST_F(CrossoverFilterbankTest, LinearPhaseSumIsTheDelayedInput) {
+    const float frequencies[2] = { 500.0f, 4000.0f };
+    
+    CrossoverFilterbank bank;
+    bank.prepare(sampleRate, blockSize);
+    bank.setPhase(CrossoverFilterbank::Phase::LinearPhase);
+    bank.setCrossovers(frequencies, 2);
+    
+    const int latency = bank.getLatency();
+    ASSERT_EQ(latency, CrossoverFilterbank::getLinearPhaseLatency(sampleRate));
+    
+    std::vector<float> outLeft, outRight;
+    run(bank, outLeft, outRight);
+    
+    for (size_t i = static_cast<size_t>(latency); i < outLeft.size(); ++i) {
+        ASSERT_NEAR(outLeft[i], left[i - static_cast<size_t>(latency)], 1e-5f) << "sample " << i;
+        ASSERT_NEAR(outRight[i], right[i - static_cast<size_t>(latency)], 1e-5f) << "sample " << i;
+    }
+}
+
+TEST_F(CrossoverFilterbankTest, LinearPhaseImpulseResponseIsSymmetric) {
+    const float frequency = 1000.0f;
+    
+    CrossoverFilterbank bank;
+    bank.prepare(sampleRate, blockSize);
+    bank.setPhase(CrossoverFilterbank::Phase::LinearPhase);
+    bank.setCrossovers(&frequency, 1);
+    const int latency = bank.getLatency();
+    
+    std::fill(left.begin(), left.end(), 0.0f);
+    std::fill(right.begin(), right.end(), 0.0f);
+    left[0] = 1.0f;
+    
+    std::vector<float> outLeft, outRight;
+    run(bank, outLeft, outRight, 0);
+    
+    // The low band's taps through both the direct and the FFT partitions
+    double sum = 0.0;
+    for (int i = 0; i <= 2 * latency; ++i) {
+        ASSERT_NEAR(outLeft[static_cast<size_t>(i)], outLeft[static_cast<size_t>(2 * latency - i)], 1e-6f)
+            << "tap " << i;
+        sum += outLeft[static_cast<size_t>(i)];
+    }
+    EXPECT_NEAR(sum, 1.0, 1e-4);
+    
+    for (size_t i = 0; i < outLeft.size(); ++i) {
+        if (i > static_cast<size_t>(2 * latency)) {
+            ASSERT_NEAR(outLeft[i], 0.0f, 1e-6f) << "sample " << i;
+        }
+        ASSERT_NEAR(outRight[i], 0.0f, 1e-6f) << "sample " << i;
+    }
+}
+
+TEST_F(CrossoverFilterbankTest, LinearPhaseLatencyScalesWithSampleRate) {
+    const int base = CrossoverFilterbank::getLinearPhaseLatency(sampleRate);
+    EXPECT_EQ(base, CrossoverFilterbank::referenceLatency);
+    EXPECT_EQ(CrossoverFilterbank::getLinearPhaseLatency(2.0 * sampleRate), 2 * base);
+    EXPECT_EQ(CrossoverFilterbank::getLinearPhaseLatency(8.0 * sampleRate), 8 * base);
+    
+    // Whole at the base rate for every oversampling factor
+    for (const double rate : { 44100.0, 88200.0, 176400.0, 352800.0 }) {
+        EXPECT_EQ(CrossoverFilterbank::getLinearPhaseLatency(rate) % 8, 0) << rate;
+    }
+}
+
+//==============================================================================
+// Band isolation
+//==============================================================================
+
+TEST_F(CrossoverFilterbankTest, BandsIsolateTheirRange) {
+    const float frequencies[2] = { 300.0f, 3000.0f };
+    
+    for (const auto phase : { CrossoverFilterbank::Phase::MinimumPhase,
+                              CrossoverFilterbank::Phase::LinearPhase }) {
+        // A 1 kHz tone lives in the middle band
+        const float tone = 1000.0f;
+        for (int i = 0; i < length; ++i) {
+            const float t = static_cast<float>(i) / static_cast<float>(sampleRate);
+            left[static_cast<size_t>(i)] = std::sin(2.0f * 3.14159265f * tone * t);
+            right[static_cast<size_t>(i)] = left[static_cast<size_t>(i)];
+        }
+        const float inputLevel = rms(left, 0);
+        
+        std::vector<float> levels;
+        for (int band = 0; band < 3; ++band) {
+            CrossoverFilterbank bank;
+            bank.prepare(sampleRate, blockSize);
+            bank.setPhase(phase);
+            bank.setCrossovers(frequencies, 2);
+            
+            std::vector<float> outLeft, outRight;
+            run(bank, outLeft, outRight, band);
+            levels.push_back(rms(outLeft, static_cast<size_t>(length / 2)) / inputLevel);
+        }
+        
+        // Within a fraction of a dB in its band, at least 20 dB down in the others
+        EXPECT_NEAR(levels[1], 1.0f, 0.05f);
+        EXPECT_LT(levels[0], 0.1f);
+        EXPECT_LT(levels[2], 0.1f);
+    }
+}
+
+TEST_F(CrossoverFilterbankTest, LinearPhaseIsolatesAtOversampledRates) {
+    // The kernels grow with the rate, so 8x oversampling keeps the low crossovers
+    const double oversampledRate = 8.0 * sampleRate;
+    const float frequencies[2] = { 300.0f, 3000.0f };
+    const size_t numSamples = 65536;
+    
+    std::vector<float> tone(numSamples);
+    for (size_t i = 0; i < numSamples; ++i) {
+        tone[i] = std::sin(2.0f * 3.14159265f * 1000.0f * static_cast<float>(i / oversampledRate));
+    }
+    const float inputLevel = rms(tone, 0);
+    
+    CrossoverFilterbank bank;
+    bank.prepare(oversampledRate, blockSize);
+    bank.setPhase(CrossoverFilterbank::Phase::LinearPhase);
+    bank.setCrossovers(frequencies, 2);
+    EXPECT_EQ(bank.getLatency(), 8 * CrossoverFilterbank::getLinearPhaseLatency(sampleRate));
+    
+    std::vector<std::vector<float>> bands(3, std::vector<float>(numSamples));
+    for (size_t start = 0; start < numSamples; start += blockSize) {
+        const float* input[1] = { tone.data() + start };
+        bank.split(input, 1, blockSize);
+        
+        for (size_t band = 0; band < 3; ++band) {
+            const float* data = bank.getBand(static_cast<int>(band), 0);
+            std::copy(data, data + blockSize, bands[band].begin() + static_cast<std::ptrdiff_t>(start));
+        }
+    }
+    
+    EXPECT_NEAR(rms(bands[1], numSamples / 2) / inputLevel, 1.0f, 0.05f);
+    EXPECT_LT(rms(bands[0], numSamples / 2) / inputLevel, 0.1f);
+    EXPECT_LT(rms(bands[2], numSamples / 2) / inputLevel, 0.1f);
+}
+
+TEST_F(CrossoverFilterbankTest, NoCrossoversPassThrough) {
+    CrossoverFilterbank bank;
+    bank.prepare(sampleRate, blockSize);
+    bank.setCrossovers(nullptr, 0);
+    ASSERT_EQ(bank.getNumBands(), 1);
+    
+    std::vector<float> outLeft, outRight;
+    run(bank, outLeft, outRight);
+    
+    EXPECT_EQ(outLeft, left);
+    EXPECT_EQ(outRight, right);
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+// Direct include without JUCE dependencies for testing
+#include "dsp/DynamicEQ.h"
+#include "utils/FastMath.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace SeshEQ;
+
+class DynamicEQTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        sidechain.prepare(sampleRate);
+        sidechain.setBand(0, FilterType::Peak, 1000.0f, 1.0f);
+        sidechain.setDynamics(0, -30.0f, 4.0f, 0.0f, 1.0f, 50.0f);
+    }
+    
+    // Run a stereo sine through the sidechain
+    void feedSine(float frequency, float amplitude, int numSamples) {
+        std::vector<float> left(static_cast<size_t>(numSamples));
+        for (int i = 0; i < numSamples; ++i) {
+            left[static_cast<size_t>(i)] = amplitude * static_cast<float>(
+                std::sin(2.0 * FastMath::pi * frequency * i / sampleRate));
+        }
+        std::vector<float> right = left;
+        sidechain.process(left.data(), right.data(), numSamples);
+    }
+    
+    SidechainFilterbank sidechain;
+    static constexpr double sampleRate = 48000.0;
+};
+
+TEST_F(DynamicEQTest, CutsWhenTheBandIsLoud) {
+    // -6 dB peak at the band frequency: 24 dB over the threshold, 18 dB cut at 4:1
+    feedSine(1000.0f, 0.5f, 9600);
+    EXPECT_NEAR(sidechain.getGainChange(0), -18.0f, 1.0f);
+}
+
+TEST_F(DynamicEQTest, IgnoresLevelOutsideTheBand) {
+    // As loud, but four octaves away from the band
+    feedSine(62.5f, 0.5f, 9600);
+    EXPECT_GT(sidechain.getGainChange(0), -1.0f);
+}
+
+TEST_F(DynamicEQTest, StaysStaticBelowThreshold) {
+    feedSine(1000.0f, 0.01f, 9600);
+    EXPECT_FLOAT_EQ(sidechain.getGainChange(0), 0.0f);
+}
+
+TEST_F(DynamicEQTest, BandsListenIndependently) {
+    // Band 1 sits where band 0 does not listen, with the same curve
+    sidechain.setBand(1, FilterType::Peak, 62.5f, 1.0f);
+    sidechain.setDynamics(1, -30.0f, 4.0f, 0.0f, 1.0f, 50.0f);
+    
+    feedSine(1000.0f, 0.5f, 9600);
+    EXPECT_NEAR(sidechain.getGainChange(0), -18.0f, 1.0f);
+    EXPECT_GT(sidechain.getGainChange(1), -1.0f);
+    
+    // Clearing one band leaves the other
+    const float otherLevel = sidechain.getLevel(1);
+    sidechain.resetBand(0);
+    EXPECT_FLOAT_EQ(sidechain.getGainChange(0), 0.0f);
+    EXPECT_FLOAT_EQ(sidechain.getLevel(1), otherLevel);
+}
+
+TEST_F(DynamicEQTest, CurveCompressesAboveAndExpandsBelowThreshold) {
+    EXPECT_FLOAT_EQ(DynamicsCurve::computeGain(-10.0f, -20.0f, 2.0f, 0.0f), -5.0f);
+    EXPECT_FLOAT_EQ(DynamicsCurve::computeGain(-30.0f, -20.0f, 2.0f, 0.0f), 0.0f);
+    
+    // Ratio 0.5 is 2:1 downward expansion
+    EXPECT_FLOAT_EQ(DynamicsCurve::computeGain(-30.0f, -20.0f, 0.5f, 0.0f), -10.0f);
+    EXPECT_FLOAT_EQ(DynamicsCurve::computeGain(-10.0f, -20.0f, 0.5f, 0.0f), 0.0f);
+}
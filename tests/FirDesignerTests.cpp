@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+// Direct include without JUCE dependencies for testing
+#include "dsp/FirDesigner.h"
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+using namespace SeshEQ;
+
+class FirDesignerTest : public ::testing::Test {
+protected:
+    static BandDesign makeBand(float frequency) {
+        return { FilterType::Peak, frequency, 1.0f, 6.0f };
+    }
+    
+    static int lengthFor(FirDesigner::LengthTier tier, double sampleRate, const std::vector<BandDesign>& bands) {
+        return FirDesigner::getImpulseLength(tier, sampleRate, bands.data(), static_cast<int>(bands.size()));
+    }
+    
+    /**
+     * @brief Shelves, a cut and a steep high-pass, 4095 taps at 48 kHz
+     */
+    static FirDesigner::DesignRequest makeRequest(float linearShare) {
+        FirDesigner::DesignRequest request;
+        request.sampleRate = 48000.0;
+        request.length = 4095;
+        request.delay = FirDesigner::getDelay(request.length, linearShare);
+        request.bands[0] = { FilterType::LowShelf, 120.0f, 0.707f, 4.0f, 2, true };
+        request.bands[1] = { FilterType::Peak, 1000.0f, 1.5f, -6.0f, 2, true };
+        request.bands[2] = { FilterType::HighShelf, 8000.0f, 0.707f, 3.0f, 2, true };
+        request.bands[3] = { FilterType::HighPass, 30.0f, 0.707f, 0.0f, 4, true };
+        return request;
+    }
+    
+    /**
+     * @brief |H(f)| of the taps, summed directly
+     */
+    static double getTapsMagnitude(const std::vector<float>& taps, double frequency, double sampleRate) {
+        std::complex<double> response;
+        for (size_t n = 0; n < taps.size(); ++n) {
+            response += static_cast<double>(taps[n])
+                        * std::polar(1.0, -2.0 * FastMath::pi * frequency * static_cast<double>(n) / sampleRate);
+        }
+        return std::abs(response);
+    }
+    
+    /**
+     * @brief Design the request and check its magnitude and main lobe
+     */
+    static void expectDesignMatchesTarget(float linearShare) {
+        const auto request = makeRequest(linearShare);
+        std::vector<float> taps(static_cast<size_t>(request.length));
+        FirDesigner::Workspace workspace;
+        workspace.design(request, taps.data());
+        
+        // Largest tap at the stated delay
+        size_t peak = 0;
+        for (size_t n = 1; n < taps.size(); ++n) {
+            if (std::abs(taps[n]) > std::abs(taps[peak])) peak = n;
+        }
+        EXPECT_EQ(static_cast<int>(peak), request.delay) << "linear share " << linearShare;
+        
+        // Target magnitude from 100 Hz up (4095 taps do not resolve the 30 Hz slope below)
+        for (int i = 0; i < 64; ++i) {
+            float frequency = 100.0f * std::pow(200.0f, static_cast<float>(i) / 63.0f);
+            float target = 0.0f;
+            FirDesigner::getMagnitudes(request, &frequency, &target, 1);
+            
+            const double magnitude = getTapsMagnitude(taps, frequency, request.sampleRate);
+            EXPECT_NEAR(20.0 * std::log10(magnitude / target), 0.0, 0.1)
+                << frequency << " Hz, linear share " << linearShare;
+        }
+    }
+};
+
+//==============================================================================
+// Impulse length tests
+//==============================================================================
+
+TEST_F(FirDesignerTest, LengthFollowsLowestBand) {
+    using Tier = FirDesigner::LengthTier;
+    std::vector<BandDesign> bands = { makeBand(1000.0f), makeBand(8000.0f) };
+    
+    // Six cycles of the lowest band, rounded up to a power of two minus one
+    EXPECT_EQ(lengthFor(Tier::Medium, 48000.0, bands), 511);
+    
+    bands.push_back(makeBand(100.0f));
+    EXPECT_EQ(lengthFor(Tier::Medium, 48000.0, bands), 4095);
+    
+    // Moving the lowest band back up shortens the FIR again
+    bands.back().frequency = 400.0f;
+    EXPECT_EQ(lengthFor(Tier::Medium, 48000.0, bands), 1023);
+    
+    // Order does not matter, only the lowest band
+    bands.insert(bands.begin(), makeBand(60.0f));
+    EXPECT_EQ(lengthFor(Tier::Medium, 48000.0, bands), 8191);
+}
+
+TEST_F(FirDesignerTest, LengthIsCappedPerTierAndScalesWithRate) {
+    using Tier = FirDesigner::LengthTier;
+    const std::vector<BandDesign> bands = { makeBand(20.0f) };
+    
+    EXPECT_EQ(lengthFor(Tier::Low, 48000.0, bands), 2047);
+    EXPECT_EQ(lengthFor(Tier::Medium, 48000.0, bands), 8191);
+    EXPECT_EQ(lengthFor(Tier::High, 48000.0, bands), 16383);
+    EXPECT_EQ(lengthFor(Tier::Max, 48000.0, bands), 32767);
+    
+    // The same resolution in Hz at twice the rate takes twice the taps
+    EXPECT_EQ(lengthFor(Tier::Medium, 96000.0, bands), 16383);
+    EXPECT_EQ(lengthFor(Tier::Max, 192000.0, bands), FirDesigner::maxImpulseLength);
+}
+
+TEST_F(FirDesignerTest, NoEnabledBandsGiveShortestLength) {
+    const std::vector<BandDesign> bands;
+    
+    EXPECT_EQ(lengthFor(FirDesigner::LengthTier::Max, 48000.0, bands), FirDesigner::minImpulseLength);
+    EXPECT_EQ(FirDesigner::getImpulseLength(FirDesigner::LengthTier::Max, 48000.0, 24000.0f),
+              FirDesigner::minImpulseLength);
+}
+
+//==============================================================================
+// Design tests
+//==============================================================================
+
+TEST_F(FirDesignerTest, LinearPhaseKeepsTargetMagnitude) {
+    expectDesignMatchesTarget(1.0f);
+}
+
+TEST_F(FirDesignerTest, MinimumPhaseKeepsTargetMagnitude) {
+    expectDesignMatchesTarget(0.0f);
+}
+
+TEST_F(FirDesignerTest, MixedPhaseKeepsTargetMagnitude) {
+    expectDesignMatchesTarget(0.5f);
+    expectDesignMatchesTarget(0.2f);
+}
+
+TEST_F(FirDesignerTest, DelayFollowsLinearShare) {
+    EXPECT_EQ(FirDesigner::getDelay(4095, 1.0f), 2047);
+    EXPECT_EQ(FirDesigner::getDelay(4095, 0.5f), 1024);
+    EXPECT_EQ(FirDesigner::getDelay(4095, 0.0f), 0);
+}
@@ -3,6 +3,7 @@
 
 // Direct include without JUCE dependencies for testing
 #include "dsp/LevelDetector.h"
+#include "utils/FastMath.h"
 
 #include <cmath>
 #include <vector>
@@ -198,6 +199,51 @@ TEST_F(LevelDetectorTest, StereoProcessingTakesMaximum) {
     EXPECT_NEAR(level2, 0.9f, tolerance);
 }
 
+//==============================================================================
+// Block processing tests
+//==============================================================================
+
+TEST_F(LevelDetectorTest, BlockMatchesPerSampleProcessing) {
+    // 103 samples: vector widths plus a scalar tail
+    constexpr int numSamples = 103;
+    std::vector<float> left(numSamples), right(numSamples);
+    for (int i = 0; i < numSamples; ++i) {
+        left[static_cast<size_t>(i)] = std::sin(0.3f * static_cast<float>(i));
+        right[static_cast<size_t>(i)] = -0.7f * std::cos(0.11f * static_cast<float>(i));
+    }
+    const float* stereo[] = { left.data(), right.data() };
+    
+    for (auto mode : { DetectionMode::Peak, DetectionMode::RMS }) {
+        LevelDetector reference;
+        reference.prepare(sampleRate);
+        reference.setMode(mode);
+        reference.setAttackTime(0.5f);
+        reference.setReleaseTime(5.0f);
+        
+        detector.setMode(mode);
+        detector.setAttackTime(0.5f);
+        detector.setReleaseTime(5.0f);
+        
+        std::vector<float> envelope(numSamples);
+        detector.processBlock(stereo, 2, envelope.data(), numSamples);
+        
+        for (int i = 0; i < numSamples; ++i) {
+            const float expected = reference.processStereo(left[static_cast<size_t>(i)], right[static_cast<size_t>(i)]);
+            ASSERT_FLOAT_EQ(envelope[static_cast<size_t>(i)], expected) << "sample " << i;
+        }
+        
+        // Mono follows processSample
+        reference.reset();
+        detector.reset();
+        detector.processBlock(stereo, 1, envelope.data(), numSamples);
+        
+        for (int i = 0; i < numSamples; ++i) {
+            ASSERT_FLOAT_EQ(envelope[static_cast<size_t>(i)], reference.processSample(left[static_cast<size_t>(i)]))
+                << "sample " << i;
+        }
+    }
+}
+
 //==============================================================================
 // dB conversion tests
 //==============================================================================
@@ -237,6 +283,28 @@ TEST_F(LevelDetectorTest, DbConversionRoundTrip) {
     EXPECT_NEAR(back, original, 0.001f);
 }
 
+TEST_F(LevelDetectorTest, FastDbConversionsStayWithinAHundredthOfADb) {
+    // Every level from -200 dB (the clamp) to +40 dB, a little over 0.01 dB apart
+    for (float gain = 1.0e-10f; gain < 100.0f; gain *= 1.0012f) {
+        ASSERT_NEAR(FastMath::gainToDb(gain), dBUtils::linearToDb(static_cast<double>(gain)), 0.001)
+            << "gain " << gain;
+    }
+    
+    for (float dB = -200.0f; dB <= 40.0f; dB += 0.013f) {
+        ASSERT_NEAR(dBUtils::linearToDb(static_cast<double>(FastMath::dbToGain(dB))), dB, 0.001)
+            << "dB " << dB;
+    }
+    
+    EXPECT_FLOAT_EQ(FastMath::gainToDb(0.0f), dBUtils::linearToDb(0.0f));
+    EXPECT_FLOAT_EQ(FastMath::dbToGain(0.0f), 1.0f);
+    
+    // Far past the exponent range: saturates instead of wrapping
+    EXPECT_FLOAT_EQ(FastMath::exp2(-200.0f), FastMath::exp2(-126.0f));
+    EXPECT_GT(FastMath::dbToGain(-2000.0f), 0.0f);
+    EXPECT_LT(FastMath::dbToGain(-2000.0f), 1.0e-37f);
+    EXPECT_TRUE(std::isfinite(FastMath::dbToGain(2000.0f)));
+}
+
 //==============================================================================
 // Edge case tests
 //==============================================================================
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+// Direct include without JUCE dependencies for testing
+#include "dsp/MultibandDynamics.h"
+#include "utils/FastMath.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace SeshEQ;
+
+class MultibandDynamicsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dynamics.prepare(sampleRate);
+    }
+    
+    // Decaying stereo sine: passes through the knee and both sides of the threshold
+    static std::vector<float> makeSignal(float frequency, float phase) {
+        std::vector<float> signal(static_cast<size_t>(numSamples));
+        for (int i = 0; i < numSamples; ++i) {
+            const double envelope = std::exp(-4.0 * i / numSamples);
+            signal[static_cast<size_t>(i)] = static_cast<float>(
+                envelope * std::sin(2.0 * FastMath::pi * frequency * i / sampleRate + phase));
+        }
+        return signal;
+    }
+    
+    MultibandDynamics dynamics;
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int numSamples = 4800;
+};
+
+TEST_F(MultibandDynamicsTest, MatchesScalarCompressorPerBand) {
+    struct Settings { float threshold, ratio, knee, attack, release; };
+    const Settings settings[] = {
+        { -20.0f, 4.0f, 6.0f, 5.0f, 50.0f },
+        { -10.0f, 20.0f, 0.0f, 1.0f, 100.0f },
+        { -30.0f, 0.5f, 6.0f, 10.0f, 30.0f },   // Expansion
+        { -15.0f, 1.5f, 12.0f, 0.0f, 10.0f }    // Instant attack
+    };
+    constexpr int numUsed = 4;
+    
+    std::vector<std::vector<float>> left, right;
+    float* leftPointers[MultibandDynamics::maxBands] = {};
+    float* rightPointers[MultibandDynamics::maxBands] = {};
+    
+    for (int band = 0; band < numUsed; ++band) {
+        const auto& s = settings[band];
+        dynamics.setBand(band, s.threshold, s.ratio, s.knee, s.attack, s.release);
+        left.push_back(makeSignal(200.0f * (band + 1), 0.0f));
+        right.push_back(makeSignal(200.0f * (band + 1), 1.0f));
+    }
+    
+    std::vector<std::vector<float>> expectedLeft = left, expectedRight = right;
+    
+    for (int band = 0; band < numUsed; ++band) {
+        const auto& s = settings[band];
+        LevelDetector detector;
+        detector.prepare(sampleRate);
+        detector.setAttackTime(s.attack);
+        detector.setReleaseTime(s.release);
+        
+        auto& l = expectedLeft[static_cast<size_t>(band)];
+        auto& r = expectedRight[static_cast<size_t>(band)];
+        for (size_t i = 0; i < l.size(); ++i) {
+            const float level = detector.processStereo(l[i], r[i]);
+            const float gain = dBUtils::dbToLinear(
+                DynamicsCurve::computeGain(dBUtils::linearToDb(level), s.threshold, s.ratio, s.knee));
+            l[i] *= gain;
+            r[i] *= gain;
+        }
+        
+        leftPointers[band] = left[static_cast<size_t>(band)].data();
+        rightPointers[band] = right[static_cast<size_t>(band)].data();
+    }
+    
+    // Uneven calls cross the internal chunks at different places
+    for (int start = 0; start < numSamples; start += 100) {
+        float* l[MultibandDynamics::maxBands] = {};
+        float* r[MultibandDynamics::maxBands] = {};
+        for (int band = 0; band < numUsed; ++band) {
+            l[band] = leftPointers[band] + start;
+            r[band] = rightPointers[band] + start;
+        }
+        dynamics.process(l, r, std::min(100, numSamples - start));
+    }
+    
+    for (int band = 0; band < numUsed; ++band) {
+        for (size_t i = 0; i < left[0].size(); ++i) {
+            ASSERT_NEAR(left[static_cast<size_t>(band)][i], expectedLeft[static_cast<size_t>(band)][i], 1.0e-4f)
+                << "band " << band << " sample " << i;
+            ASSERT_NEAR(right[static_cast<size_t>(band)][i], expectedRight[static_cast<size_t>(band)][i], 1.0e-4f)
+                << "band " << band << " sample " << i;
+        }
+    }
+}
+
+TEST_F(MultibandDynamicsTest, MetersStrongestReductionOfEachBand) {
+    dynamics.setBand(0, -20.0f, 4.0f, 0.0f, 0.0f, 100.0f);
+    dynamics.setBand(1, -20.0f, 4.0f, 0.0f, 0.0f, 100.0f);
+    
+    // Band 0 at 0 dBFS: 20 dB over, 15 dB of reduction; band 1 below the threshold
+    std::vector<float> loud(256, 1.0f);
+    std::vector<float> quiet(256, 0.01f);
+    float* left[MultibandDynamics::maxBands] = { loud.data(), quiet.data() };
+    
+    dynamics.process(left, nullptr, 256);
+    
+    EXPECT_NEAR(dynamics.getGainReduction(0), -15.0f, 1.0e-3f);
+    EXPECT_NEAR(loud.back(), dBUtils::dbToLinear(-15.0f), 1.0e-4f);
+    EXPECT_FLOAT_EQ(dynamics.getGainReduction(1), 0.0f);
+    EXPECT_FLOAT_EQ(quiet.back(), 0.01f);
+}
+
+TEST_F(MultibandDynamicsTest, DeepExpansionStaysFinite) {
+    // -120 dB at ratio 0.1 asks for -900 dB of gain, past the float exponent range
+    dynamics.setBand(0, -20.0f, 0.1f, 0.0f, 0.0f, 100.0f);
+    
+    const float input = dBUtils::dbToLinear(-120.0f);
+    std::vector<float> signal(256, input);
+    float* left[MultibandDynamics::maxBands] = { signal.data() };
+    
+    dynamics.process(left, nullptr, 256);
+    
+    for (const float sample : signal) {
+        ASSERT_TRUE(std::isfinite(sample));
+        ASSERT_GE(sample, 0.0f);
+        ASSERT_LE(sample, input * 1.0e-30f);
+    }
+    EXPECT_TRUE(std::isfinite(dynamics.getGainReduction(0)));
+    EXPECT_LT(dynamics.getGainReduction(0), -700.0f);
+}
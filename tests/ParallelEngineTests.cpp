@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+// Direct include without JUCE dependencies for testing
+#include "dsp/ParallelEngine.h"
+#include "utils/LockFreeExchange.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace SeshEQ;
+
+class ParallelEngineTest : public ::testing::Test {
+protected:
+    static BiquadFilter::Coefficients makeSection(FilterType type, float freq, float q, float gainDb) {
+        BiquadFilter filter;
+        filter.prepare(sampleRate);
+        filter.setParameters(type, freq, q, gainDb);
+        return filter.getCoefficients();
+    }
+    
+    // Typical 8-band EQ curve
+    static std::vector<BiquadFilter::Coefficients> makeEQ() {
+        return {
+            makeSection(FilterType::HighPass, 30.0f, 0.707f, 0.0f),
+            makeSection(FilterType::LowShelf, 100.0f, 0.707f, 3.0f),
+            makeSection(FilterType::Peak, 250.0f, 1.2f, -4.0f),
+            makeSection(FilterType::Peak, 800.0f, 2.0f, 2.5f),
+            makeSection(FilterType::Peak, 2500.0f, 0.8f, -1.5f),
+            makeSection(FilterType::Peak, 5000.0f, 4.0f, 5.0f),
+            makeSection(FilterType::HighShelf, 9000.0f, 0.707f, -3.0f),
+            makeSection(FilterType::LowPass, 18000.0f, 0.707f, 0.0f)
+        };
+    }
+    
+    static std::vector<float> makeSignal(int length) {
+        std::vector<float> signal(static_cast<size_t>(length));
+        for (int i = 0; i < length; ++i) {
+            signal[static_cast<size_t>(i)] = 0.5f * std::sin(0.013f * static_cast<float>(i))
+                                           + 0.3f * std::sin(0.71f * static_cast<float>(i));
+        }
+        signal[0] += 1.0f;
+        return signal;
+    }
+    
+    static std::vector<int> makeIds(int count) {
+        std::vector<int> ids;
+        for (int i = 0; i < count; ++i) ids.push_back(i);
+        return ids;
+    }
+    
+    static constexpr double sampleRate = 48000.0;
+    static constexpr float tolerance = 1e-5f;
+    
+    // Coefficient revisions of the source sections
+    const std::array<uint32_t, ParallelDesign::maxSections> revisions {};
+};
+
+//==============================================================================
+// Designer tests
+//==============================================================================
+
+TEST_F(ParallelEngineTest, MatchesCascadeOutput) {
+    const auto coefs = makeEQ();
+    const auto ids = makeIds(static_cast<int>(coefs.size()));
+    
+    ParallelDesign design;
+    ASSERT_TRUE(ParallelDesigner::design(ids.data(), revisions.data(), coefs.data(),
+                                         static_cast<int>(coefs.size()), design));
+    
+    CascadeEngine cascade;
+    cascade.setSections(ids.data(), coefs.data(), static_cast<int>(coefs.size()));
+    ParallelEngine parallel;
+    parallel.setDesign(design);
+    
+    // Impulse plus tones, split over several calls
+    auto expected = makeSignal(2000);
+    auto actual = expected;
+    for (int start = 0; start < 2000; start += 500) {
+        float* a[1] = { expected.data() + start };
+        float* b[1] = { actual.data() + start };
+        cascade.process(a, 1, 500);
+        parallel.process(b, 1, 500);
+    }
+    
+    for (size_t i = 0; i < actual.size(); ++i) {
+        ASSERT_NEAR(actual[i], expected[i], tolerance) << "sample " << i;
+    }
+}
+
+TEST_F(ParallelEngineTest, DropsFlatSections) {
+    const std::vector<BiquadFilter::Coefficients> coefs = {
+        makeSection(FilterType::Peak, 1000.0f, 1.0f, 0.0f),
+        makeSection(FilterType::Peak, 3000.0f, 1.0f, 6.0f),
+        makeSection(FilterType::LowShelf, 200.0f, 0.707f, 0.0f)
+    };
+    const auto ids = makeIds(3);
+    
+    ParallelDesign design;
+    ASSERT_TRUE(ParallelDesigner::design(ids.data(), revisions.data(), coefs.data(), 3, design));
+    EXPECT_EQ(design.numSections, 1);
+}
+
+TEST_F(ParallelEngineTest, RejectsCoincidentPoles) {
+    // Two identical sections have double poles, which have no simple residues
+    const auto section = makeSection(FilterType::Peak, 1000.0f, 1.0f, 6.0f);
+    const std::vector<BiquadFilter::Coefficients> coefs = { section, section };
+    const auto ids = makeIds(2);
+    
+    ParallelDesign design;
+    EXPECT_FALSE(ParallelDesigner::design(ids.data(), revisions.data(), coefs.data(), 2, design));
+    EXPECT_FALSE(design.valid);
+}
+
+TEST_F(ParallelEngineTest, MatchesOnlyItsSource) {
+    auto coefs = makeEQ();
+    const auto ids = makeIds(static_cast<int>(coefs.size()));
+    const int count = static_cast<int>(coefs.size());
+    
+    ParallelDesign design;
+    ParallelDesigner::design(ids.data(), revisions.data(), coefs.data(), count, design);
+    EXPECT_TRUE(design.matches(ids.data(), revisions.data(), count));
+    EXPECT_FALSE(design.matches(ids.data(), revisions.data(), count - 1));
+    
+    auto redesigned = revisions;
+    ++redesigned[3];
+    EXPECT_FALSE(design.matches(ids.data(), redesigned.data(), count));
+}
+
+TEST_F(ParallelEngineTest, ExchangeDeliversLatestValue) {
+    LockFreeExchange<int> exchange;
+    EXPECT_FALSE(exchange.update());
+    
+    exchange.getWriteBuffer() = 1;
+    exchange.publish();
+    exchange.getWriteBuffer() = 2;
+    exchange.publish();
+    
+    ASSERT_TRUE(exchange.update());
+    EXPECT_EQ(exchange.getReadBuffer(), 2);
+    EXPECT_FALSE(exchange.update());
+    EXPECT_EQ(exchange.getReadBuffer(), 2);
+}
@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+// Direct include without JUCE dependencies for testing
+#include "dsp/PartitionedConvolver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace SeshEQ;
+
+class PartitionedConvolverTest : public ::testing::Test {
+protected:
+    /**
+     * @brief Decaying noise of unit energy, so the output stays around full scale
+     */
+    static std::vector<float> makeImpulseResponse(int length, unsigned seed) {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<double> noise(-1.0, 1.0);
+        std::vector<double> taps(static_cast<size_t>(length));
+        double energy = 0.0;
+        
+        for (int n = 0; n < length; ++n) {
+            const double tap = noise(random) * std::exp(-3.0 * n / length);
+            taps[static_cast<size_t>(n)] = tap;
+            energy += tap * tap;
+        }
+        
+        std::vector<float> impulseResponse(static_cast<size_t>(length));
+        for (int n = 0; n < length; ++n) {
+            impulseResponse[static_cast<size_t>(n)] = static_cast<float>(taps[static_cast<size_t>(n)] / std::sqrt(energy));
+        }
+        return impulseResponse;
+    }
+    
+    static std::vector<float> makeNoise(int length, unsigned seed) {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+        std::vector<float> signal(static_cast<size_t>(length));
+        for (auto& x : signal) x = noise(random);
+        return signal;
+    }
+    
+    /**
+     * @brief Reference output in double precision
+     */
+    static std::vector<double> convolve(const std::vector<float>& impulseResponse, const std::vector<float>& input) {
+        std::vector<double> output(input.size(), 0.0);
+        for (size_t n = 0; n < input.size(); ++n) {
+            double sum = 0.0;
+            const size_t taps = std::min(impulseResponse.size(), n + 1);
+            for (size_t j = 0; j < taps; ++j) {
+                sum += static_cast<double>(impulseResponse[j]) * input[n - j];
+            }
+            output[n] = sum;
+        }
+        return output;
+    }
+    
+    /**
+     * @brief Run a stereo pair through the convolver in random host block sizes
+     */
+    static void processInBlocks(PartitionedConvolver& convolver, std::vector<float>& left,
+                                std::vector<float>* right, unsigned seed) {
+        std::mt19937 random(seed);
+        std::uniform_int_distribution<int> blockSizes(1, 1024);
+        const auto length = static_cast<int>(left.size());
+        
+        for (int start = 0; start < length;) {
+            const int count = std::min(blockSizes(random), length - start);
+            convolver.process(left.data() + start, right ? right->data() + start : nullptr, count);
+            start += count;
+        }
+    }
+    
+    static double maxError(const std::vector<float>& output, const std::vector<double>& expected) {
+        double error = 0.0;
+        for (size_t n = 0; n < output.size(); ++n) {
+            error = std::max(error, std::abs(output[n] - expected[n]));
+        }
+        return error;
+    }
+    
+    PartitionedConvolver convolver;
+    static constexpr int headSize = 64;
+    static constexpr int maxTaps = 20000;
+    static constexpr double tolerance = 3.0e-5;
+};
+
+//==============================================================================
+// Convolution tests
+//==============================================================================
+
+TEST_F(PartitionedConvolverTest, MatchesDirectConvolutionAtHeadAndStageBoundaries) {
+    convolver.prepare(headSize, maxTaps);
+    
+    // Stage k covers taps [2N, 4N) with N = headSize * 2^k; the last stage starts at 8192
+    for (int taps : { 1, 63, 64, 65, 255, 256, 257, 511, 512, 1023, 1024, 4096, 8191, 8192, 8193 }) {
+        const auto impulseResponse = makeImpulseResponse(taps, static_cast<unsigned>(taps));
+        convolver.setImpulseResponse(impulseResponse.data(), taps);
+        convolver.reset();
+        
+        auto left = makeNoise(2 * taps + 4096, 1);
+        auto right = makeNoise(2 * taps + 4096, 2);
+        const auto expectedLeft = convolve(impulseResponse, left);
+        const auto expectedRight = convolve(impulseResponse, right);
+        processInBlocks(convolver, left, &right, static_cast<unsigned>(taps) + 3);
+        
+        EXPECT_LE(maxError(left, expectedLeft), tolerance) << taps << " taps";
+        EXPECT_LE(maxError(right, expectedRight), tolerance) << taps << " taps";
+    }
+}
+
+TEST_F(PartitionedConvolverTest, MatchesDirectConvolutionOfLongestResponse) {
+    convolver.prepare(headSize, maxTaps);
+    
+    const auto impulseResponse = makeImpulseResponse(maxTaps, 4);
+    convolver.setImpulseResponse(impulseResponse.data(), maxTaps);
+    convolver.reset();
+    
+    auto left = makeNoise(maxTaps + 12000, 5);
+    auto right = makeNoise(maxTaps + 12000, 6);
+    const auto expectedLeft = convolve(impulseResponse, left);
+    const auto expectedRight = convolve(impulseResponse, right);
+    processInBlocks(convolver, left, &right, 7);
+    
+    EXPECT_LE(maxError(left, expectedLeft), tolerance);
+    EXPECT_LE(maxError(right, expectedRight), tolerance);
+}
+
+TEST_F(PartitionedConvolverTest, MonoMatchesDirectConvolution) {
+    convolver.prepare(headSize, maxTaps);
+    
+    const auto impulseResponse = makeImpulseResponse(5000, 8);
+    convolver.setImpulseResponse(impulseResponse.data(), 5000);
+    convolver.reset();
+    
+    auto signal = makeNoise(12000, 9);
+    const auto expected = convolve(impulseResponse, signal);
+    processInBlocks(convolver, signal, nullptr, 10);
+    
+    EXPECT_LE(maxError(signal, expected), tolerance);
+}
+
+//==============================================================================
+// Crossfade tests
+//==============================================================================
+
+TEST_F(PartitionedConvolverTest, CrossfadeStaysBetweenResponsesAndEndsOnNewOne) {
+    // Same length (the linear-phase EQ's case), and stages that start or stop being used
+    for (const auto& lengths : { std::pair<int, int> { 3000, 3000 }, { 500, 9000 }, { 9000, 500 } }) {
+        const int oldTaps = lengths.first;
+        const int newTaps = lengths.second;
+        convolver.prepare(headSize, maxTaps);
+        
+        const auto oldResponse = makeImpulseResponse(oldTaps, 15);
+        const auto newResponse = makeImpulseResponse(newTaps, 16);
+        convolver.setImpulseResponse(oldResponse.data(), oldTaps);
+        convolver.reset();
+        
+        constexpr int switchTime = 10007;
+        auto left = makeNoise(switchTime + 30000, 17);
+        auto right = makeNoise(switchTime + 30000, 18);
+        const auto oldLeft = convolve(oldResponse, left);
+        const auto oldRight = convolve(oldResponse, right);
+        const auto newLeft = convolve(newResponse, left);
+        const auto newRight = convolve(newResponse, right);
+        
+        // Swap mid-block, then note the first block end after the fade
+        std::mt19937 random(19);
+        std::uniform_int_distribution<int> blockSizes(1, 1024);
+        const auto length = static_cast<int>(left.size());
+        int fadeDone = -1;
+        
+        for (int start = 0; start < length;) {
+            int count = std::min(blockSizes(random), length - start);
+            if (start < switchTime) {
+                count = std::min(count, switchTime - start);
+            }
+            convolver.process(left.data() + start, right.data() + start, count);
+            start += count;
+            
+            if (start == switchTime) {
+                convolver.setImpulseResponse(newResponse.data(), newTaps, true);
+                EXPECT_TRUE(convolver.isCrossfading());
+            } else if (start > switchTime && fadeDone < 0 && !convolver.isCrossfading()) {
+                fadeDone = start;
+            }
+        }
+        ASSERT_GT(fadeDone, switchTime) << oldTaps << " to " << newTaps << " taps";
+        
+        int blended = 0;
+        for (int n = 0; n < length; ++n) {
+            const auto i = static_cast<size_t>(n);
+            for (const auto* channel : { &left, &right }) {
+                const float output = (*channel)[i];
+                const double before = channel == &left ? oldLeft[i] : oldRight[i];
+                const double after = channel == &left ? newLeft[i] : newRight[i];
+                
+                if (n < switchTime) {
+                    ASSERT_NEAR(output, before, tolerance) << "sample " << n;
+                } else if (n >= fadeDone) {
+                    ASSERT_NEAR(output, after, tolerance) << "sample " << n;
+                } else {
+                    // A linear blend of the two outputs
+                    ASSERT_GE(output, std::min(before, after) - tolerance) << "sample " << n;
+                    ASSERT_LE(output, std::max(before, after) + tolerance) << "sample " << n;
+                    if (std::abs(output - before) > 1.0e-3 && std::abs(output - after) > 1.0e-3) {
+                        ++blended;
+                    }
+                }
+            }
+        }
+        
+        // A gradual fade, not a switch
+        EXPECT_GT(blended, convolver.getCrossfadeLength() / 2) << oldTaps << " to " << newTaps << " taps";
+    }
+}
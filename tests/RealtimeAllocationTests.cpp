@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+// Direct include without JUCE dependencies for testing
+#include "dsp/BandFilter.h"
+#include "dsp/CascadeEngine.h"
+#include "dsp/CoefficientDesigner.h"
+#include "dsp/CrossoverFilterbank.h"
+#include "dsp/ParallelEngine.h"
+#include "dsp/StateVariableFilter.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+//==============================================================================
+// Global allocation counter (replaces operator new for this test binary)
+//==============================================================================
+
+namespace {
+
+std::atomic<bool> countAllocations { false };
+std::atomic<int> allocationCount { 0 };
+
+void* allocate(std::size_t size) {
+    if (countAllocations.load()) {
+        allocationCount.fetch_add(1);
+    }
+    
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+    if (countAllocations.load()) {
+        allocationCount.fetch_add(1);
+    }
+    
+    const auto align = static_cast<std::size_t>(alignment);
+    const std::size_t rounded = (std::max<std::size_t>(size, 1) + align - 1) / align * align;
+    if (void* p = std::aligned_alloc(align, rounded)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+/**
+ * @brief Counts heap allocations on any thread while in scope
+ */
+class AllocationGuard {
+public:
+    AllocationGuard() {
+        allocationCount.store(0);
+        countAllocations.store(true);
+    }
+    
+    ~AllocationGuard() {
+        countAllocations.store(false);
+    }
+    
+    int getCount() const { return allocationCount.load(); }
+};
+
+} // namespace
+
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+using namespace SeshEQ;
+
+class RealtimeAllocationTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        left.resize(blockSize);
+        right.resize(blockSize);
+        for (int i = 0; i < blockSize; ++i) {
+            left[static_cast<size_t>(i)] = std::sin(0.03f * static_cast<float>(i));
+            right[static_cast<size_t>(i)] = std::cos(0.02f * static_cast<float>(i));
+        }
+    }
+    
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 512;
+    
+    std::vector<float> left;
+    std::vector<float> right;
+};
+
+//==============================================================================
+// The realtime building blocks of EQProcessor::process must not allocate
+//==============================================================================
+
+TEST_F(RealtimeAllocationTest, GuardCountsAllocations) {
+    AllocationGuard guard;
+    auto* probe = new std::vector<float>(16);
+    const int count = guard.getCount();
+    delete probe;
+    
+    EXPECT_GE(count, 2);
+}
+
+TEST_F(RealtimeAllocationTest, BandProcessingDoesNotAllocate) {
+    std::vector<BandFilter> bands(8);
+    std::vector<StateVariableFilter> svfs(8);
+    for (int b = 0; b < 8; ++b) {
+        bands[static_cast<size_t>(b)].prepare(sampleRate);
+        svfs[static_cast<size_t>(b)].prepare(sampleRate);
+    }
+    
+    AllocationGuard guard;
+    
+    for (int b = 0; b < 8; ++b) {
+        auto& band = bands[static_cast<size_t>(b)];
+        auto& svf = svfs[static_cast<size_t>(b)];
+        const float freq = 100.0f * static_cast<float>(b + 1);
+        
+        // Parameter and slope changes as they arrive from the host
+        band.setOrder(b + 1);
+        band.setParameters(b % 2 == 0 ? FilterType::HighPass : FilterType::Peak, freq, 0.9f, 3.0f);
+        svf.setParameters(FilterType::Peak, freq, 0.9f, 3.0f);
+        
+        band.processBlock(left.data(), right.data(), blockSize);
+        band.processBlockRamped(left.data(), right.data(), blockSize);
+        band.processMono(left.data(), blockSize);
+        svf.processBlockRamped(left.data(), right.data(), blockSize);
+    }
+    
+    EXPECT_EQ(guard.getCount(), 0);
+}
+
+TEST_F(RealtimeAllocationTest, CascadeAndParallelDoNotAllocate) {
+    CascadeEngine cascade;
+    ParallelEngine parallel;
+    
+    const BandDesign designs[2] = { { FilterType::HighPass, 60.0f, 0.707f, 0.0f },
+                                    { FilterType::Peak, 2500.0f, 1.4f, -4.0f } };
+    const int orders[2] = { 4, 2 };
+    std::array<BiquadFilter::Coefficients, 2 * CoefficientDesigner::maxStages> coefs {};
+    
+    const int ids[3] = { 0, 1, 4 };
+    const uint32_t revisions[3] = {};
+    BiquadFilter::Coefficients sections[3];
+    
+    ParallelDesign design;
+    
+    float* channels[2] = { left.data(), right.data() };
+    
+    AllocationGuard guard;
+    
+    // Control-rate design, as in the EQ's smoothing segments
+    CoefficientDesigner::designStages(designs, orders, coefs.data(), 2, sampleRate);
+    sections[0] = coefs[0];
+    sections[1] = coefs[1];
+    sections[2] = coefs[static_cast<size_t>(CoefficientDesigner::maxStages)];
+    
+    cascade.setSections(ids, sections, 3);
+    cascade.process(channels, 2, blockSize);
+    cascade.processRamped(channels, 2, blockSize);
+    
+    ParallelDesigner::design(ids, revisions, sections, 3, design);
+    parallel.setDesign(design);
+    parallel.process(channels, 2, blockSize);
+    
+    EXPECT_EQ(guard.getCount(), 0);
+    EXPECT_TRUE(design.valid);
+}
+
+TEST_F(RealtimeAllocationTest, CrossoverDoesNotAllocate) {
+    CrossoverFilterbank crossover;
+    crossover.prepare(sampleRate, blockSize);
+    
+    const float frequencies[4] = { 120.0f, 400.0f, 2000.0f, 7000.0f };
+    float* channels[2] = { left.data(), right.data() };
+    
+    AllocationGuard guard;
+    
+    for (const auto phase : { CrossoverFilterbank::Phase::MinimumPhase,
+                              CrossoverFilterbank::Phase::LinearPhase }) {
+        // Phase and crossover changes as they arrive with the band parameters
+        crossover.setPhase(phase);
+        crossover.setCrossovers(frequencies, 4);
+        crossover.split(channels, 2, blockSize);
+        crossover.sum(channels, 2, blockSize);
+    }
+    
+    EXPECT_EQ(guard.getCount(), 0);
+}
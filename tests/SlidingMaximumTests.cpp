@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+// Direct include without JUCE dependencies for testing
+#include "dsp/SlidingMaximum.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace SeshEQ;
+
+class SlidingMaximumTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        input.resize(numSamples);
+        for (size_t i = 0; i < numSamples; ++i) {
+            // Deterministic noise with runs of rising and falling values
+            const auto n = static_cast<unsigned>(i);
+            input[i] = static_cast<float>((n * 1103515245u + 12345u) % 1000u) / 1000.0f;
+        }
+    }
+    
+    static float bruteForceMaximum(const std::vector<float>& values, size_t index, int length) {
+        const size_t first = index + 1 >= static_cast<size_t>(length) ? index + 1 - static_cast<size_t>(length) : 0;
+        return *std::max_element(values.begin() + static_cast<std::ptrdiff_t>(first),
+                                 values.begin() + static_cast<std::ptrdiff_t>(index) + 1);
+    }
+    
+    SlidingMaximum maximum;
+    std::vector<float> input;
+    static constexpr size_t numSamples = 2000;
+};
+
+TEST_F(SlidingMaximumTest, MatchesBruteForceForAnyLength) {
+    maximum.prepare(100);
+    
+    for (int length : { 1, 2, 3, 16, 37, 100 }) {
+        maximum.setLength(length);
+        for (size_t i = 0; i < numSamples; ++i) {
+            ASSERT_FLOAT_EQ(maximum.process(input[i]), bruteForceMaximum(input, i, length))
+                << "length " << length << " sample " << i;
+        }
+    }
+}
+
+TEST_F(SlidingMaximumTest, HoldsPeakForExactlyTheWindow) {
+    maximum.prepare(8);
+    maximum.setLength(5);
+    
+    EXPECT_FLOAT_EQ(maximum.process(1.0f), 1.0f);
+    for (int i = 1; i < 5; ++i) {
+        EXPECT_FLOAT_EQ(maximum.process(0.0f), 1.0f) << "sample " << i;
+    }
+    EXPECT_FLOAT_EQ(maximum.process(0.0f), 0.0f);
+}
+
+TEST_F(SlidingMaximumTest, LengthIsClampedToPreparedMaximum) {
+    maximum.prepare(10);
+    maximum.setLength(50);
+    EXPECT_EQ(maximum.getLength(), 10);
+    
+    maximum.setLength(0);
+    EXPECT_EQ(maximum.getLength(), 1);
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+// Direct include without JUCE dependencies for testing
+#include "dsp/StateVariableFilter.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace SeshEQ;
+
+class StateVariableFilterTest : public ::testing::Test {
+protected:
+    static std::vector<float> makeSignal(int length) {
+        std::vector<float> signal(static_cast<size_t>(length));
+        for (int i = 0; i < length; ++i) {
+            signal[static_cast<size_t>(i)] = 0.5f * std::sin(0.031f * static_cast<float>(i))
+                                           + ((i % 53 == 0) ? 0.5f : -0.02f);
+        }
+        return signal;
+    }
+    
+    static constexpr double sampleRate = 48000.0;
+};
+
+//==============================================================================
+// Response tests
+//==============================================================================
+
+TEST_F(StateVariableFilterTest, MatchesCookbookBiquadForAllTypes) {
+    const FilterType types[] = { FilterType::LowPass, FilterType::HighPass, FilterType::BandPass,
+                                 FilterType::Notch, FilterType::Peak, FilterType::LowShelf,
+                                 FilterType::HighShelf, FilterType::AllPass };
+    const auto input = makeSignal(2000);
+    
+    for (const auto type : types) {
+        for (const float freq : { 40.0f, 1000.0f, 12000.0f }) {
+            StateVariableFilter svf;
+            BiquadFilter biquad;
+            svf.prepare(sampleRate);
+            biquad.prepare(sampleRate);
+            svf.setParameters(type, freq, 1.5f, -7.0f);
+            biquad.setParameters(type, freq, 1.5f, -7.0f);
+            
+            auto output = input;
+            svf.processBlock(output.data(), nullptr, 2000);
+            
+            for (size_t i = 0; i < input.size(); ++i) {
+                ASSERT_NEAR(output[i], biquad.processSample(input[i]), 1e-5f)
+                    << "type " << static_cast<int>(type) << ", " << freq << " Hz, sample " << i;
+            }
+            
+            EXPECT_NEAR(svf.getMagnitudeAtFrequency(freq * 1.3f), biquad.getMagnitudeAtFrequency(freq * 1.3f), 1e-5f);
+        }
+    }
+}
+
+TEST_F(StateVariableFilterTest, StereoChannelsAreIndependent) {
+    StateVariableFilter stereo, mono;
+    stereo.prepare(sampleRate);
+    mono.prepare(sampleRate);
+    stereo.setParameters(FilterType::Peak, 3000.0f, 2.0f, 6.0f);
+    mono.setParameters(FilterType::Peak, 3000.0f, 2.0f, 6.0f);
+    
+    auto left = makeSignal(300);
+    std::vector<float> right(300, 0.0f);
+    auto expected = left;
+    
+    stereo.processBlock(left.data(), right.data(), 300);
+    mono.processBlock(expected.data(), nullptr, 300);
+    
+    EXPECT_EQ(left, expected);
+    for (const float sample : right) {
+        EXPECT_EQ(sample, 0.0f);
+    }
+}
+
+TEST_F(StateVariableFilterTest, RampWithEqualEndsMatchesPlainProcessing) {
+    StateVariableFilter ramped, plain;
+    ramped.prepare(sampleRate);
+    plain.prepare(sampleRate);
+    ramped.setParameters(FilterType::LowShelf, 200.0f, 0.707f, 5.0f);
+    plain.setParameters(FilterType::LowShelf, 200.0f, 0.707f, 5.0f);
+    
+    // First block ramps from the prepare() design, second has equal ends
+    auto a = makeSignal(128);
+    auto b = a;
+    ramped.processBlockRamped(a.data(), nullptr, 64);
+    plain.processBlockRamped(b.data(), nullptr, 64);
+    ramped.processBlockRamped(a.data() + 64, nullptr, 64);
+    plain.processBlock(b.data() + 64, nullptr, 64);
+    
+    for (size_t i = 64; i < a.size(); ++i) {
+        EXPECT_NEAR(a[i], b[i], 1e-6f);
+    }
+}
+
+//==============================================================================
+// Robustness tests
+//==============================================================================
+
+TEST_F(StateVariableFilterTest, StaysAccurateAtOversampledRates) {
+    // 192 kHz with 8x oversampling
+    const double highRate = 1536000.0;
+    
+    StateVariableFilter shelf, highPass;
+    shelf.prepare(highRate);
+    highPass.prepare(highRate);
+    shelf.setParameters(FilterType::LowShelf, 30.0f, 0.707f, 6.0f);
+    highPass.setParameters(FilterType::HighPass, 20.0f, 0.707f, 0.0f);
+    
+    // Settle on DC: the shelf must reach its full gain, the high-pass must block it
+    std::vector<float> dcShelf(400000, 1.0f), dcHighPass(400000, 1.0f);
+    shelf.processBlock(dcShelf.data(), nullptr, 400000);
+    highPass.processBlock(dcHighPass.data(), nullptr, 400000);
+    
+    EXPECT_NEAR(dcShelf.back(), std::pow(10.0f, 6.0f / 20.0f), 1e-4f);
+    EXPECT_NEAR(dcHighPass.back(), 0.0f, 1e-4f);
+}
+
+TEST_F(StateVariableFilterTest, FastModulationStaysBounded) {
+    StateVariableFilter filter;
+    filter.prepare(sampleRate);
+    
+    auto data = makeSignal(48000);
+    
+    // Sweep a high-Q boost between 30 Hz and 18 kHz every 32 samples
+    for (int start = 0; start < 48000; start += 32) {
+        const bool up = (start / 32) % 2 == 0;
+        filter.setParameters(FilterType::Peak, up ? 18000.0f : 30.0f, 8.0f, up ? 18.0f : -18.0f);
+        filter.processBlockRamped(data.data() + start, nullptr, 32);
+    }
+    
+    for (const float sample : data) {
+        ASSERT_TRUE(std::isfinite(sample));
+        ASSERT_LT(std::abs(sample), 100.0f);
+    }
+}
@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+// Direct include without JUCE dependencies for testing
+#include "dsp/TruePeakLimiter.h"
+#include "dsp/LevelDetector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace SeshEQ;
+
+class TruePeakLimiterTest : public ::testing::Test {
+protected:
+    /**
+     * @brief Noise bursts well over full scale with isolated impulses between them
+     *
+     * An impulse is the case the BS.1770 filter reads lowest (phase 0 peaks at 0.972).
+     */
+    static std::vector<float> makeProgram(unsigned seed) {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<float> noise(-3.0f, 3.0f);
+        std::vector<float> signal(static_cast<size_t>(numSamples), 0.0f);
+        
+        for (int i = 0; i < numSamples; ++i) {
+            if ((i / 700) % 2 == 0) {
+                signal[static_cast<size_t>(i)] = noise(random);
+            } else if (i % 97 == 0) {
+                signal[static_cast<size_t>(i)] = i % 2 == 0 ? 4.0f : -4.0f;
+            }
+        }
+        return signal;
+    }
+    
+    /**
+     * @brief Run both channels through the limiter in random block sizes
+     */
+    static void processInBlocks(TruePeakLimiter& limiter, std::vector<float>& left, std::vector<float>& right,
+                                unsigned seed) {
+        std::mt19937 random(seed);
+        std::uniform_int_distribution<int> blockSizes(1, 700);
+        
+        for (int start = 0; start < numSamples;) {
+            const int count = std::min(blockSizes(random), numSamples - start);
+            float* channels[2] = { left.data() + start, right.data() + start };
+            limiter.process(channels, 2, count);
+            start += count;
+        }
+    }
+    
+    static float peakOf(const std::vector<float>& signal) {
+        float peak = 0.0f;
+        for (float x : signal) peak = std::max(peak, std::abs(x));
+        return peak;
+    }
+    
+    TruePeakLimiter limiter;
+    static constexpr int numSamples = 20000;
+    static constexpr int maxLookahead = 480;
+};
+
+TEST_F(TruePeakLimiterTest, OutputStaysUnderCeilingWithoutClipping) {
+    limiter.prepare(maxLookahead);
+    
+    for (int lookahead : { 0, 1, 48, 96, maxLookahead }) {
+        for (float ceilingDb : { 0.0f, -1.0f }) {
+            const float ceiling = dBUtils::dbToLinear(ceilingDb);
+            limiter.setLookahead(lookahead);
+            limiter.setLevels(dBUtils::dbToLinear(ceilingDb - 3.0f), ceiling);
+            limiter.setReleaseCoefficient(0.999f);
+            
+            auto left = makeProgram(1);
+            auto right = makeProgram(2);
+            processInBlocks(limiter, left, right, 3);
+            
+            // Within float rounding of the ramp average
+            const float peak = std::max(peakOf(left), peakOf(right));
+            EXPECT_LE(peak, ceiling * (1.0f + 1.0e-6f)) << "lookahead " << lookahead << " ceiling " << ceilingDb;
+            EXPECT_GT(peak, 0.9f * ceiling) << "lookahead " << lookahead << " ceiling " << ceilingDb;
+        }
+    }
+}
+
+TEST_F(TruePeakLimiterTest, IsolatedImpulseLandsOnCeiling) {
+    limiter.prepare(maxLookahead);
+    limiter.setLookahead(96);
+    limiter.setLevels(0.5f, 1.0f);
+    
+    std::vector<float> left(static_cast<size_t>(numSamples), 0.0f);
+    std::vector<float> right(static_cast<size_t>(numSamples), 0.0f);
+    left[1000] = 4.0f;
+    processInBlocks(limiter, left, right, 4);
+    
+    EXPECT_NEAR(peakOf(left), 1.0f, 1.0e-6f);
+    EXPECT_NEAR(left[static_cast<size_t>(1000 + limiter.getLatency())], 1.0f, 1.0e-6f);
+}
+
+TEST_F(TruePeakLimiterTest, PassesQuietSignalDelayedByLatency) {
+    limiter.prepare(maxLookahead);
+    limiter.setLookahead(48);
+    limiter.setLevels(dBUtils::dbToLinear(-3.0f), dBUtils::dbToLinear(-1.0f));
+    
+    std::vector<float> left(static_cast<size_t>(numSamples));
+    for (int i = 0; i < numSamples; ++i) {
+        left[static_cast<size_t>(i)] = 0.5f * static_cast<float>(std::sin(0.01 * i));
+    }
+    const auto input = left;
+    auto right = left;
+    processInBlocks(limiter, left, right, 5);
+    
+    const int latency = limiter.getLatency();
+    EXPECT_EQ(latency, 48 + TruePeakDetector::latency);
+    for (int i = 0; i < numSamples; ++i) {
+        const float expected = i >= latency ? input[static_cast<size_t>(i - latency)] : 0.0f;
+        ASSERT_FLOAT_EQ(left[static_cast<size_t>(i)], expected) << "sample " << i;
+    }
+}
+
+TEST_F(TruePeakLimiterTest, ChangingLookaheadKeepsTheAudio) {
+    limiter.prepare(maxLookahead);
+    limiter.setLookahead(96);
+    limiter.setLevels(dBUtils::dbToLinear(-3.0f), dBUtils::dbToLinear(-1.0f));
+    
+    // Below the threshold: once the delay is full, every output sample is the input
+    std::vector<float> left(static_cast<size_t>(numSamples), 0.5f);
+    std::vector<float> right = left;
+    
+    for (int start = 0, block = 0; start < numSamples; start += 256, ++block) {
+        const int count = std::min(256, numSamples - start);
+        if (block > 0) {
+            limiter.setLookahead(block % 2 == 0 ? 96 : 120);
+        }
+        
+        float* channels[2] = { left.data() + start, right.data() + start };
+        limiter.process(channels, 2, count);
+    }
+    
+    for (int i = 96 + TruePeakDetector::latency; i < numSamples; ++i) {
+        ASSERT_FLOAT_EQ(left[static_cast<size_t>(i)], 0.5f) << "sample " << i;
+    }
+}
+
+TEST_F(TruePeakLimiterTest, StaysUnderCeilingWhileLookaheadChanges) {
+    limiter.prepare(maxLookahead);
+    limiter.setLevels(dBUtils::dbToLinear(-4.0f), dBUtils::dbToLinear(-1.0f));
+    limiter.setReleaseCoefficient(0.99f);
+    
+    auto left = makeProgram(6);
+    auto right = makeProgram(7);
+    
+    std::mt19937 random(8);
+    std::uniform_int_distribution<int> blockSizes(1, 300);
+    std::uniform_int_distribution<int> lookaheads(0, maxLookahead);
+    
+    for (int start = 0; start < numSamples;) {
+        const int count = std::min(blockSizes(random), numSamples - start);
+        limiter.setLookahead(lookaheads(random));
+        
+        float* channels[2] = { left.data() + start, right.data() + start };
+        limiter.process(channels, 2, count);
+        start += count;
+    }
+    
+    const float ceiling = dBUtils::dbToLinear(-1.0f);
+    EXPECT_LE(std::max(peakOf(left), peakOf(right)), ceiling * (1.0f + 1.0e-6f));
+}